@@ -0,0 +1,200 @@
+// 对冲请求：三个 epoll 副本跑同一个 Echo 服务，每次调用以 stall_pct% 的概率停顿 stall_ms 毫秒（模拟 GC、缺页、邻居抢 CPU 这类偶发慢请求）；
+// 同一组副本上依次测试 不对冲 / p95 对冲 / p99 对冲，每种保持 concurrency 个在途调用（闭环），
+// 对比延迟分布和对冲带来的额外请求比例（服务端收到的请求数 / 完成的调用数 - 1，受 RpcClient 的对冲预算限制）
+// 用法：./hedge_bench [在途调用数] [每种配置测试秒数] [停顿概率 %] [停顿 ms]
+#include "rpc/rpc_server_factory.h"
+#include "rpc/rpc_client.h"
+#include "rpc/rpc_controller.h"
+#include "echo.pb.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kReplicas = 3;
+constexpr int kBasePort = 18830;
+constexpr int kWorkerThreads = 8;        // 停顿用 sleep 模拟，不占 IO 线程
+constexpr double kWarmupSeconds = 1.0;   // 前 1 秒不计入：延迟分布还没有足够样本，不会对冲
+
+using Clock = std::chrono::steady_clock;
+
+class StallingEcho : public demo::EchoService {
+public:
+    StallingEcho(double stall_pct, int stall_ms) : stall_pct_(stall_pct), stall_ms_(stall_ms) {}
+
+    void Echo(google::protobuf::RpcController*, const demo::EchoRequest* request,
+              demo::EchoResponse* response, google::protobuf::Closure* done) override {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        thread_local std::mt19937 rng(std::random_device{}());
+        if (std::uniform_real_distribution<double>(0, 100)(rng) < stall_pct_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(stall_ms_));
+        }
+        response->set_message(request->message());
+        done->Run();
+    }
+
+    std::atomic<long> calls{0};
+
+private:
+    double stall_pct_;
+    int stall_ms_;
+};
+
+// 闭环压测：每个槽位同一时刻有一个在途调用，完成后在 done 里（客户端 IO 线程）立即发出下一个
+class Driver {
+public:
+    Driver(RpcClient* client, Clock::time_point measure_start, Clock::time_point deadline)
+        : stub_(client), measure_start_(measure_start), deadline_(deadline) {}
+
+    void Run(int concurrency) {
+        active_ = concurrency;
+        for (int i = 0; i < concurrency; ++i) {
+            slots_.push_back(std::make_unique<Slot>());
+        }
+        for (auto& slot : slots_) {
+            slot->request.set_message("ping");
+            Issue(slot.get());
+        }
+        while (active_.load() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<double>* samples() { return &samples_; }
+    long failed() const { return failed_; }
+    long completed() const { return completed_.load(); }
+
+private:
+    struct Slot {
+        SimpleRpcController controller;
+        demo::EchoRequest request;
+        demo::EchoResponse response;
+        Clock::time_point start;
+    };
+
+    void Issue(Slot* slot) {
+        slot->controller.Reset();
+        slot->response.Clear();
+        slot->start = Clock::now();
+        stub_.Echo(&slot->controller, &slot->request, &slot->response,
+                   google::protobuf::NewCallback(this, &Driver::OnDone, slot));
+    }
+
+    void OnDone(Slot* slot) {
+        auto now = Clock::now();
+        completed_.fetch_add(1, std::memory_order_relaxed);
+        if (slot->start >= measure_start_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (slot->controller.Failed()) {
+                ++failed_;
+            } else {
+                samples_.push_back(std::chrono::duration<double, std::micro>(now - slot->start).count());
+            }
+        }
+        if (now < deadline_) {
+            Issue(slot);
+        } else {
+            active_.fetch_sub(1);
+        }
+    }
+
+    demo::EchoService_Stub stub_;
+    Clock::time_point measure_start_;
+    Clock::time_point deadline_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::atomic<int> active_{0};
+    std::atomic<long> completed_{0};
+    std::mutex mutex_;
+    std::vector<double> samples_;
+    long failed_ = 0;
+};
+
+// quantile <= 0 表示不对冲
+void RunConfig(const char* name, double quantile, int concurrency, int seconds,
+               std::vector<std::unique_ptr<StallingEcho>>& services) {
+    RpcClient client(2);
+    for (int i = 0; i < kReplicas; ++i) {
+        client.AddEndpoint("127.0.0.1:" + std::to_string(kBasePort + i));
+    }
+    if (quantile > 0) {
+        RpcClient::HedgePolicy policy;
+        policy.quantile = quantile;
+        client.SetHedgePolicy(demo::EchoService::descriptor()->FindMethodByName("Echo")->full_name(), policy);
+    }
+    client.Start();
+    if (client.WaitForConnections(kReplicas * RpcClient::kDefaultConnectionsPerEndpoint, 3000) == 0) {
+        std::printf("%12s  skipped: connect failed\n", name);
+        return;
+    }
+
+    long calls_before = 0;
+    for (auto& s : services) calls_before += s->calls.load();
+
+    auto start = Clock::now();
+    auto measure_start = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(kWarmupSeconds));
+    Driver driver(&client, measure_start, start + std::chrono::seconds(seconds));
+    driver.Run(concurrency);
+    double elapsed = std::chrono::duration<double>(Clock::now() - measure_start).count();
+    client.Stop();
+
+    long server_calls = -calls_before;
+    for (auto& s : services) server_calls += s->calls.load();
+
+    std::vector<double>* samples = driver.samples();
+    if (samples->empty()) {
+        std::printf("%12s  no samples\n", name);
+        return;
+    }
+    std::sort(samples->begin(), samples->end());
+    auto pct = [samples](double p) { return (*samples)[static_cast<size_t>(p * (samples->size() - 1))]; };
+    std::printf("%12s %10.0f %10.0f %10.0f %10.0f %10.0f %9.1f%% %8ld\n", name, samples->size() / elapsed,
+                pct(0.50), pct(0.99), pct(0.999), samples->back(),
+                driver.completed() > 0 ? 100.0 * server_calls / driver.completed() - 100 : 0.0, driver.failed());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int concurrency = argc > 1 ? std::atoi(argv[1]) : 8;
+    int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    double stall_pct = argc > 3 ? std::atof(argv[3]) : 1.0;
+    int stall_ms = argc > 4 ? std::atoi(argv[4]) : 20;
+
+    std::vector<std::unique_ptr<StallingEcho>> services;
+    std::vector<std::unique_ptr<RpcServer>> servers;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kReplicas; ++i) {
+        services.push_back(std::make_unique<StallingEcho>(stall_pct, stall_ms));
+        servers.push_back(RpcServerFactory()
+            .WithPort(kBasePort + i)
+            .WithNetwork(NetworkType::Epoll)
+            .WithIOThreads(1)
+            .WithWorkerThreads(kWorkerThreads)
+            .Build());
+        servers.back()->RegisterService(services.back().get());
+    }
+    for (auto& server : servers) {
+        RpcServer* raw = server.get();
+        threads.emplace_back([raw] { raw->Run(); });
+    }
+
+    std::printf("replicas=%d stall=%.1f%% x %dms concurrency=%d seconds=%d (latency in us)\n",
+                kReplicas, stall_pct, stall_ms, concurrency, seconds);
+    std::printf("%12s %10s %10s %10s %10s %10s %10s %8s\n", "hedging", "qps", "p50", "p99", "p99.9", "max", "extra", "failed");
+    RunConfig("off", 0, concurrency, seconds, services);
+    RunConfig("p95", 0.95, concurrency, seconds, services);
+    RunConfig("p99", 0.99, concurrency, seconds, services);
+
+    for (auto& server : servers) server->Stop();
+    for (auto& t : threads) t.join();
+    return 0;
+}
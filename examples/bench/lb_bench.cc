@@ -0,0 +1,221 @@
+// 客户端负载均衡：三个 epoll 副本跑同一个 Echo 服务，其中一个每次调用额外睡 slow_ms 毫秒（模拟 GC 停顿、邻居争抢 CPU 的慢副本）；
+// 同一个 RpcClient 依次用 RoundRobin / LeastOutstanding / PowerOfTwoChoices 保持 concurrency 个在途调用
+// （闭环：每个调用在 done 里立即发出下一个），对比延迟分布和落到慢副本的调用比例。
+// 另有一个后台客户端只连慢副本、保持 background 个在途调用（别的调用方压上去的负载，被测客户端的本地统计看不到）；
+// 最后一行连的是开启了负载报告（WithLoadReports）的另一组副本，P2C 同时参考响应里捎带的排队数 / 在途数 / CPU
+// 用法：./lb_bench [在途调用数] [每个策略测试秒数] [慢副本额外延迟 ms] [后台在途调用数]
+#include "rpc/rpc_server_factory.h"
+#include "rpc/rpc_client.h"
+#include "rpc/rpc_controller.h"
+#include "echo.pb.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kReplicas = 3;
+constexpr int kBasePort = 18800;
+constexpr int kReportingBasePort = 18810;   // 开启负载报告的那组副本
+constexpr uint32_t kLoadReportEvery = 4;
+constexpr int kWorkerThreads = 8;        // 慢副本的睡眠不占 IO 线程
+constexpr double kWarmupSeconds = 0.5;   // 前 0.5 秒不计入：EWMA 还没有样本
+
+using Clock = std::chrono::steady_clock;
+
+class DelayedEcho : public demo::EchoService {
+public:
+    explicit DelayedEcho(int delay_ms) : delay_ms_(delay_ms) {}
+
+    void Echo(google::protobuf::RpcController*, const demo::EchoRequest* request,
+              demo::EchoResponse* response, google::protobuf::Closure* done) override {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        if (delay_ms_ > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+        response->set_message(request->message());
+        done->Run();
+    }
+
+    std::atomic<long> calls{0};
+
+private:
+    int delay_ms_;
+};
+
+// 闭环压测：每个槽位同一时刻有一个在途调用，完成后在 done 里（客户端 IO 线程）立即发出下一个
+class Driver {
+public:
+    Driver(RpcClient* client, Clock::time_point measure_start, Clock::time_point deadline)
+        : stub_(client), measure_start_(measure_start), deadline_(deadline) {}
+
+    void Run(int concurrency) {
+        active_ = concurrency;
+        for (int i = 0; i < concurrency; ++i) {
+            slots_.push_back(std::make_unique<Slot>());
+        }
+        for (auto& slot : slots_) {
+            slot->request.set_message("ping");
+            Issue(slot.get());
+        }
+        while (active_.load() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<double>* samples() { return &samples_; }
+    long failed() const { return failed_; }
+    long completed() const { return completed_.load(); }
+
+private:
+    struct Slot {
+        SimpleRpcController controller;
+        demo::EchoRequest request;
+        demo::EchoResponse response;
+        Clock::time_point start;
+    };
+
+    void Issue(Slot* slot) {
+        slot->controller.Reset();
+        slot->response.Clear();
+        slot->start = Clock::now();
+        stub_.Echo(&slot->controller, &slot->request, &slot->response,
+                   google::protobuf::NewCallback(this, &Driver::OnDone, slot));
+    }
+
+    void OnDone(Slot* slot) {
+        auto now = Clock::now();
+        completed_.fetch_add(1, std::memory_order_relaxed);
+        if (slot->start >= measure_start_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (slot->controller.Failed()) {
+                ++failed_;
+            } else {
+                samples_.push_back(std::chrono::duration<double, std::micro>(now - slot->start).count());
+            }
+        }
+        if (now < deadline_) {
+            Issue(slot);
+        } else {
+            active_.fetch_sub(1);
+        }
+    }
+
+    demo::EchoService_Stub stub_;
+    Clock::time_point measure_start_;
+    Clock::time_point deadline_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::atomic<int> active_{0};
+    std::atomic<long> completed_{0};
+    std::mutex mutex_;
+    std::vector<double> samples_;
+    long failed_ = 0;
+};
+
+// 一组副本：services[0] 是慢副本
+struct ReplicaSet {
+    int base_port;
+    std::vector<std::unique_ptr<DelayedEcho>> services;
+    std::vector<std::unique_ptr<RpcServer>> servers;
+    std::vector<std::thread> threads;
+
+    ReplicaSet(int port, int slow_ms, uint32_t load_report_every) : base_port(port) {
+        for (int i = 0; i < kReplicas; ++i) {
+            services.push_back(std::make_unique<DelayedEcho>(i == 0 ? slow_ms : 0));
+            servers.push_back(RpcServerFactory()
+                .WithPort(base_port + i)
+                .WithNetwork(NetworkType::Epoll)
+                .WithIOThreads(1)
+                .WithWorkerThreads(kWorkerThreads)
+                .WithLoadReports(load_report_every)
+                .Build());
+            servers.back()->RegisterService(services.back().get());
+        }
+        for (auto& server : servers) {
+            RpcServer* raw = server.get();
+            threads.emplace_back([raw] { raw->Run(); });
+        }
+    }
+
+    ~ReplicaSet() {
+        for (auto& server : servers) server->Stop();
+        for (auto& t : threads) t.join();
+    }
+};
+
+void RunPolicy(const char* name, LoadBalancePolicy policy, int concurrency, int seconds, int background,
+               ReplicaSet& replicas) {
+    auto& services = replicas.services;
+    RpcClient client(2);
+    for (int i = 0; i < kReplicas; ++i) {
+        client.AddEndpoint("127.0.0.1:" + std::to_string(replicas.base_port + i));
+    }
+    client.SetLoadBalancePolicy(policy);
+    client.Start();
+    RpcClient noisy(1);
+    noisy.AddEndpoint("127.0.0.1:" + std::to_string(replicas.base_port));
+    noisy.Start();
+    if (client.WaitForConnections(kReplicas * RpcClient::kDefaultConnectionsPerEndpoint, 3000) == 0 ||
+        noisy.WaitForConnections(RpcClient::kDefaultConnectionsPerEndpoint, 3000) == 0) {
+        std::printf("%18s  skipped: connect failed\n", name);
+        return;
+    }
+
+    long slow_before = services[0]->calls.load();
+    long total_before = 0;
+    for (auto& s : services) total_before += s->calls.load();
+
+    auto start = Clock::now();
+    auto measure_start = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(kWarmupSeconds));
+    auto deadline = start + std::chrono::seconds(seconds);
+    Driver noisy_driver(&noisy, measure_start, deadline);
+    std::thread noisy_thread([&] { if (background > 0) noisy_driver.Run(background); });
+    Driver driver(&client, measure_start, deadline);
+    driver.Run(concurrency);
+    double elapsed = std::chrono::duration<double>(Clock::now() - measure_start).count();
+    noisy_thread.join();
+    client.Stop();
+    noisy.Stop();
+
+    // 后台客户端的调用全落在慢副本上，不计入比例
+    long slow_calls = services[0]->calls.load() - slow_before - noisy_driver.completed();
+    long total_calls = -total_before - noisy_driver.completed();
+    for (auto& s : services) total_calls += s->calls.load();
+
+    std::vector<double>* samples = driver.samples();
+    if (samples->empty()) {
+        std::printf("%18s  no samples\n", name);
+        return;
+    }
+    std::sort(samples->begin(), samples->end());
+    auto pct = [samples](double p) { return (*samples)[static_cast<size_t>(p * (samples->size() - 1))]; };
+    std::printf("%18s %10.0f %10.0f %10.0f %10.0f %10.1f%% %8ld\n", name, samples->size() / elapsed,
+                pct(0.50), pct(0.99), pct(0.999),
+                total_calls > 0 ? 100.0 * slow_calls / total_calls : 0.0, driver.failed());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int concurrency = argc > 1 ? std::atoi(argv[1]) : 32;
+    int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+    int slow_ms = argc > 3 ? std::atoi(argv[3]) : 5;
+    int background = argc > 4 ? std::atoi(argv[4]) : 16;
+
+    ReplicaSet plain(kBasePort, slow_ms, 0);
+    ReplicaSet reporting(kReportingBasePort, slow_ms, kLoadReportEvery);
+
+    std::printf("replicas=%d (1 slow, +%dms) concurrency=%d background=%d seconds=%d (latency in us)\n",
+                kReplicas, slow_ms, concurrency, background, seconds);
+    std::printf("%18s %10s %10s %10s %10s %11s %8s\n", "policy", "qps", "p50", "p99", "p99.9", "to slow", "failed");
+    RunPolicy("round-robin", LoadBalancePolicy::RoundRobin, concurrency, seconds, background, plain);
+    RunPolicy("least-outstanding", LoadBalancePolicy::LeastOutstanding, concurrency, seconds, background, plain);
+    RunPolicy("p2c-ewma", LoadBalancePolicy::PowerOfTwoChoices, concurrency, seconds, background, plain);
+    RunPolicy("p2c+load-report", LoadBalancePolicy::PowerOfTwoChoices, concurrency, seconds, background, reporting);
+    return 0;
+}
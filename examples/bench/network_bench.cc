@@ -0,0 +1,270 @@
+// 网络后端对比：muduo / epoll / io_uring 上跑同一个 Echo 服务，测 pipeline 压力下的 QPS；
+// 每个后端分别经 TCP 回环和 Unix 域 socket（WithUnixSocket）各测一轮
+// 每个客户端连接一个收包线程，保持 depth 个未完成调用：每收到一个响应立即发出下一个请求
+// 用法：./network_bench [连接数] [每连接 pipeline 深度] [每个后端测试秒数] [消息字节数]
+#include "rpc/rpc_server_factory.h"
+#include "rpc/rpc_channel.h"
+#include "rpc/rpc_controller.h"
+#include "net/frame_codec.h"
+#include "net/socket_util.h"
+#include "echo_server_impl.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kIoThreads = 2;
+constexpr int kBasePort = 18600;
+constexpr const char* kUnixPath = "/tmp/tiny_rpc_network_bench.sock";
+
+// 等服务端开始监听：连接被拒绝时重试一会儿
+int ConnectUnix(const char* path) {
+    for (int i = 0; i < 200; ++i) {
+        int fd = sockets::ConnectUnix(path);
+        if (fd >= 0) {
+            // 客户端用阻塞读写
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            return fd;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+int ConnectTcp(int port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // 服务端在另一个线程里启动，监听之前连接会被拒绝，重试一会儿
+    for (int i = 0; i < 200; ++i) {
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+// 一个客户端连接：阻塞 socket + 收包线程，done 回调在收包线程里发出下一个调用
+class BenchClient {
+public:
+    BenchClient(int fd, int depth, const std::string& payload, const std::atomic<bool>* running)
+        : fd_(fd),
+          running_(running),
+          channel_([this](const std::string& data) { Write(data); }),
+          stub_(&channel_),
+          slots_(depth)
+    {
+        channel_.SetDefaultTimeout(0);
+        for (auto& slot : slots_) {
+            slot.request.set_message(payload);
+            slot.done.reset(google::protobuf::NewPermanentCallback(this, &BenchClient::OnDone, &slot));
+        }
+    }
+
+    ~BenchClient() {
+        if (reader_.joinable()) reader_.join();
+        ::close(fd_);
+    }
+
+    void Start() {
+        reader_ = std::thread([this] { ReadLoop(); });
+        // 先握手（方法编号），再灌满 pipeline
+        channel_.StartHandshake();
+        for (auto& slot : slots_) Issue(&slot);
+    }
+
+    // 停止发新请求，等在途的调用都回来后关闭写端，收包线程读到 EOF 退出
+    void Finish() {
+        while (channel_.PendingCount() > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ::shutdown(fd_, SHUT_WR);
+        if (reader_.joinable()) reader_.join();
+    }
+
+    long completed() const { return completed_.load(std::memory_order_relaxed); }
+    long failed() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        SimpleRpcController controller;
+        demo::EchoRequest request;
+        demo::EchoResponse response;
+        std::unique_ptr<google::protobuf::Closure> done;
+    };
+
+    void Issue(Slot* slot) {
+        slot->controller.Reset();
+        slot->response.Clear();
+        stub_.Echo(&slot->controller, &slot->request, &slot->response, slot->done.get());
+    }
+
+    void OnDone(Slot* slot) {
+        if (slot->controller.Failed()) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            completed_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (running_->load(std::memory_order_relaxed)) Issue(slot);
+    }
+
+    void Write(const std::string& data) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        size_t off = 0;
+        while (off < data.size()) {
+            ssize_t n = ::send(fd_, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            off += static_cast<size_t>(n);
+        }
+    }
+
+    void ReadLoop() {
+        std::string buffer;
+        char chunk[64 * 1024];
+        while (true) {
+            ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            buffer.append(chunk, static_cast<size_t>(n));
+            size_t consumed = FrameCodec::OnData(buffer.data(), buffer.size(), nullptr,
+                [this](const std::shared_ptr<RpcConnection>&, std::string_view frame) {
+                    channel_.OnMessage(frame);
+                });
+            buffer.erase(0, consumed);
+        }
+    }
+
+    int fd_;
+    const std::atomic<bool>* running_;
+    std::mutex write_mutex_;
+    SimpleRpcChannel channel_;
+    demo::EchoService_Stub stub_;
+    std::vector<Slot> slots_;
+    std::thread reader_;
+    std::atomic<long> completed_{0};
+    std::atomic<long> failed_{0};
+};
+
+double CpuSeconds() {
+    rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+void RunBackend(const std::string& name, NetworkType type, int port, bool use_unix,
+                int conns, int depth, int seconds, const std::string& payload) {
+    std::unique_ptr<RpcServer> server;
+    try {
+        RpcServerFactory factory;
+        factory.WithPort(port)
+               .WithNetwork(type)
+               .WithIOThreads(kIoThreads)
+               .WithWriteCoalescing(64 * 1024);
+        if (use_unix) factory.WithUnixSocket(kUnixPath);
+        server = factory.Build();
+    } catch (const std::exception& e) {
+        std::printf("%14s  skipped: %s\n", name.c_str(), e.what());
+        return;
+    }
+    EchoServiceImpl service;
+    server->RegisterService(&service);
+
+    std::string run_error;
+    std::thread server_thread([&] {
+        try {
+            server->Run();
+        } catch (const std::exception& e) {
+            run_error = e.what();
+        }
+    });
+
+    std::atomic<bool> running{true};
+    std::vector<std::unique_ptr<BenchClient>> clients;
+    for (int i = 0; i < conns; ++i) {
+        int fd = use_unix ? ConnectUnix(kUnixPath) : ConnectTcp(port);
+        if (fd < 0) break;
+        clients.push_back(std::make_unique<BenchClient>(fd, depth, payload, &running));
+    }
+    if (static_cast<int>(clients.size()) < conns) {
+        running = false;
+        clients.clear();
+        server->Stop();
+        server_thread.join();
+        std::printf("%14s  skipped: %s\n", name.c_str(), run_error.empty() ? "connect failed" : run_error.c_str());
+        return;
+    }
+
+    double cpu_start = CpuSeconds();
+    auto start = std::chrono::steady_clock::now();
+    for (auto& c : clients) c->Start();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running = false;
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double cpu = CpuSeconds() - cpu_start;
+
+    long completed = 0, failed = 0;
+    for (auto& c : clients) {
+        c->Finish();
+        completed += c->completed();
+        failed += c->failed();
+    }
+    clients.clear();
+    server->Stop();
+    server_thread.join();
+
+    // cpu us/req 包含客户端线程，三个后端的客户端完全相同，差值来自服务端
+    std::printf("%14s %14.0f %14.2f %10ld\n", name.c_str(), completed / sec,
+                completed > 0 ? cpu * 1e6 / completed : 0.0, failed);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int conns = argc > 1 ? std::atoi(argv[1]) : 16;
+    int depth = argc > 2 ? std::atoi(argv[2]) : 32;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 5;
+    size_t size = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64;
+    std::string payload(size, 'x');
+
+    std::printf("conns=%d depth=%d seconds=%d payload=%zu io_threads=%d\n",
+                conns, depth, seconds, size, kIoThreads);
+    std::printf("%14s %14s %14s %10s\n", "backend", "qps", "cpu us/req", "failed");
+    const struct {
+        const char* name;
+        NetworkType type;
+    } backends[] = {
+        {"muduo", NetworkType::Muduo},
+        {"epoll", NetworkType::Epoll},
+        {"io_uring", NetworkType::IoUring},
+    };
+    int port = kBasePort;
+    for (const auto& b : backends) {
+        for (bool use_unix : {false, true}) {
+            std::string name = std::string(b.name) + (use_unix ? "/unix" : "/tcp");
+            RunBackend(name, b.type, port++, use_unix, conns, depth, seconds, payload);
+        }
+    }
+    return 0;
+}
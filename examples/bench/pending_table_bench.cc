@@ -0,0 +1,84 @@
+// PendingCallTable 与旧实现（mutex + unordered_map）的多线程扩展性对比
+// 每个线程模拟一个调用方：保持 kWindow 个未完成调用（pipeline），不断登记新调用、取走最早的调用
+// 用法：./pending_table_bench [每线程操作数]
+#include "rpc/pending_call_table.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int kWindow = 16;
+
+// 旧实现：一把 mutex + 每次调用一个 map 节点
+class MutexMapTable {
+public:
+    bool Insert(const PendingCall& call, uint64_t* request_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *request_id = next_id_++;
+        calls_[*request_id] = call;
+        return true;
+    }
+
+    bool Take(uint64_t request_id, PendingCall* call) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(request_id);
+        if (it == calls_.end()) return false;
+        *call = it->second;
+        calls_.erase(it);
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    uint64_t next_id_ = 1;
+    std::unordered_map<uint64_t, PendingCall> calls_;
+};
+
+template <typename Table>
+double Run(Table& table, int threads, long ops_per_thread) {
+    auto worker = [&table, ops_per_thread]() {
+        uint64_t window[kWindow];
+        PendingCall call;
+        for (int i = 0; i < kWindow; ++i) {
+            table.Insert(call, &window[i]);
+        }
+        for (long i = 0; i < ops_per_thread; ++i) {
+            uint64_t& slot = window[i % kWindow];
+            if (!table.Take(slot, &call)) std::abort();
+            if (!table.Insert(call, &slot)) std::abort();
+        }
+        for (int i = 0; i < kWindow; ++i) {
+            table.Take(window[i], &call);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return static_cast<double>(threads) * ops_per_thread / sec;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long ops = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    std::printf("%8s %18s %18s %8s\n", "threads", "mutex+map ops/s", "lock-free ops/s", "speedup");
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        MutexMapTable baseline;
+        PendingCallTable table(PendingCallTable::kDefaultCapacity);
+        double a = Run(baseline, threads, ops);
+        double b = Run(table, threads, ops);
+        std::printf("%8d %18.0f %18.0f %7.2fx\n", threads, a, b, b / a);
+    }
+    return 0;
+}
@@ -0,0 +1,262 @@
+// 同机传输延迟：同一个 Echo 服务分别经共享内存环、Unix 域 socket、TCP 回环做串行 ping-pong，
+// 一次只有一个在途调用，测单次往返延迟的分布（不是吞吐）；进程内 LocalRpcChannel 的三种模式作为框架开销的对照组
+// socket 客户端在调用线程里阻塞 recv 收响应；共享内存客户端由 ShmRpcChannel 的收包线程收，调用线程自旋（yield）等 done
+// 共享内存的优势依赖忙轮询，需要空闲的 CPU 核：单核机器上默认关闭忙轮询，每次往返都要经 eventfd 唤醒
+// 用法：./shm_latency_bench [调用次数] [消息字节数]
+#include "rpc/rpc_server_factory.h"
+#include "rpc/rpc_channel.h"
+#include "rpc/rpc_controller.h"
+#include "net/frame_codec.h"
+#include "net/socket_util.h"
+#include "net_shm/shm_rpc_channel.h"
+#include "rpc/local_rpc_channel.h"
+#include "echo_server_impl.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kWarmupCalls = 2000;
+constexpr int kTcpPort = 18700;
+constexpr const char* kUnixPath = "/tmp/tiny_rpc_latency_bench.sock";
+constexpr const char* kShmPath = "/tmp/tiny_rpc_latency_bench_shm.sock";
+
+using Clock = std::chrono::steady_clock;
+
+int ConnectBlocking(bool use_unix) {
+    for (int i = 0; i < 200; ++i) {
+        int fd = -1;
+        if (use_unix) {
+            fd = sockets::ConnectUnix(kUnixPath);
+            if (fd >= 0) ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        } else {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(kTcpPort));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+                int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            } else if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        if (fd >= 0) return fd;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+// 串行调用 calls 次，每次调用的耗时（纳秒）追加到 samples；call 发起一次调用并在返回前等到 done
+template <typename CallFn>
+void Measure(int calls, CallFn&& call, std::vector<double>* samples) {
+    for (int i = 0; i < kWarmupCalls; ++i) call();
+    samples->reserve(calls);
+    for (int i = 0; i < calls; ++i) {
+        auto start = Clock::now();
+        call();
+        samples->push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+}
+
+void Report(const char* name, std::vector<double>* samples, long failed) {
+    if (samples->empty()) {
+        std::printf("%14s  no samples\n", name);
+        return;
+    }
+    std::sort(samples->begin(), samples->end());
+    double sum = 0;
+    for (double s : *samples) sum += s;
+    auto pct = [samples](double p) { return (*samples)[static_cast<size_t>(p * (samples->size() - 1))] / 1000.0; };
+    std::printf("%14s %10.2f %10.2f %10.2f %10.2f %8ld\n", name, sum / samples->size() / 1000.0,
+                pct(0.50), pct(0.99), pct(0.999), failed);
+}
+
+// socket 客户端：调用线程发出请求后自己阻塞 recv，直到这次调用的 done 执行
+void RunSocket(const char* name, bool use_unix, int calls, const std::string& payload) {
+    int fd = ConnectBlocking(use_unix);
+    if (fd < 0) {
+        std::printf("%14s  skipped: connect failed\n", name);
+        return;
+    }
+    SimpleRpcChannel channel([fd](const std::string& data) {
+        size_t off = 0;
+        while (off < data.size()) {
+            ssize_t n = ::send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+            if (n <= 0) return;
+            off += static_cast<size_t>(n);
+        }
+    });
+    channel.SetDefaultTimeout(0);
+    demo::EchoService_Stub stub(&channel);
+
+    std::string buffer;
+    char chunk[64 * 1024];
+    bool eof = false;
+    auto pump_until = [&](const bool* done) {
+        while (!*done && !eof) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                eof = true;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+            size_t consumed = FrameCodec::OnData(buffer.data(), buffer.size(), nullptr,
+                [&channel](const std::shared_ptr<RpcConnection>&, std::string_view frame) {
+                    channel.OnMessage(frame);
+                });
+            buffer.erase(0, consumed);
+        }
+    };
+
+    channel.StartHandshake();
+    // 握手响应没有单独的完成通知：发一次普通调用，它返回时握手响应已先到达
+    SimpleRpcController controller;
+    demo::EchoRequest request;
+    demo::EchoResponse response;
+    request.set_message(payload);
+    long failed = 0;
+    bool done = false;
+    auto done_cb = google::protobuf::NewPermanentCallback(+[](bool* flag) { *flag = true; }, &done);
+    auto call = [&]() {
+        controller.Reset();
+        response.Clear();
+        done = false;
+        stub.Echo(&controller, &request, &response, done_cb);
+        pump_until(&done);
+        if (controller.Failed()) ++failed;
+    };
+    call();
+
+    std::vector<double> samples;
+    if (!eof) Measure(calls, call, &samples);
+    delete done_cb;
+    ::close(fd);
+    Report(name, &samples, failed);
+}
+
+void RunShm(int calls, const std::string& payload) {
+    ShmRpcChannel channel;
+    std::string error;
+    bool ok = false;
+    for (int i = 0; i < 200 && !ok; ++i) {
+        ok = channel.Connect(kShmPath, &error);
+        if (!ok) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!ok) {
+        std::printf("%14s  skipped: %s\n", "shm", error.c_str());
+        return;
+    }
+    channel.channel().SetDefaultTimeout(0);
+    demo::EchoService_Stub stub(&channel);
+
+    SimpleRpcController controller;
+    demo::EchoRequest request;
+    demo::EchoResponse response;
+    request.set_message(payload);
+    long failed = 0;
+    std::atomic<bool> done{false};
+    auto done_cb = google::protobuf::NewPermanentCallback(
+        +[](std::atomic<bool>* flag) { flag->store(true, std::memory_order_release); }, &done);
+    auto call = [&]() {
+        controller.Reset();
+        response.Clear();
+        done.store(false, std::memory_order_relaxed);
+        stub.Echo(&controller, &request, &response, done_cb);
+        while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();   // 单核机器上让出 CPU 给收包线程
+        }
+        if (controller.Failed()) ++failed;
+    };
+
+    std::vector<double> samples;
+    Measure(calls, call, &samples);
+    channel.Close();
+    delete done_cb;
+    Report("shm", &samples, failed);
+}
+
+// 进程内：业务方法在调用线程里同步完成，测到的就是 channel 本身的开销
+void RunLocal(const char* name, RpcServer* server, LocalRpcChannel::Mode mode, int calls,
+              const std::string& payload) {
+    LocalRpcChannel channel(server, mode);
+    demo::EchoService_Stub stub(&channel);
+
+    SimpleRpcController controller;
+    demo::EchoRequest request;
+    demo::EchoResponse response;
+    request.set_message(payload);
+    long failed = 0;
+    bool done = false;
+    auto done_cb = google::protobuf::NewPermanentCallback(+[](bool* flag) { *flag = true; }, &done);
+    auto call = [&]() {
+        controller.Reset();
+        response.Clear();
+        done = false;
+        stub.Echo(&controller, &request, &response, done_cb);
+        if (!done || controller.Failed()) ++failed;
+    };
+
+    std::vector<double> samples;
+    Measure(calls, call, &samples);
+    delete done_cb;
+    Report(name, &samples, failed);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int calls = argc > 1 ? std::atoi(argv[1]) : 200000;
+    size_t size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    std::string payload(size, 'x');
+
+    EchoServiceImpl service;
+    // 两个服务端：epoll（TCP + Unix 域 socket）与共享内存，各一个 IO 线程，业务方法在 IO 线程内执行
+    auto epoll_server = RpcServerFactory()
+        .WithPort(kTcpPort)
+        .WithNetwork(NetworkType::Epoll)
+        .WithIOThreads(1)
+        .WithUnixSocket(kUnixPath)
+        .Build();
+    auto shm_server = RpcServerFactory()
+        .WithNetwork(NetworkType::SharedMemory)
+        .WithIOThreads(1)
+        .WithUnixSocket(kShmPath)
+        .Build();
+    epoll_server->RegisterService(&service);
+    shm_server->RegisterService(&service);
+    std::thread epoll_thread([&] { epoll_server->Run(); });
+    std::thread shm_thread([&] { shm_server->Run(); });
+
+    std::printf("calls=%d payload=%zu (latency in us)\n", calls, size);
+    std::printf("%14s %10s %10s %10s %10s %8s\n", "transport", "avg", "p50", "p99", "p99.9", "failed");
+    RunLocal("local/direct", epoll_server.get(), LocalRpcChannel::Mode::Direct, calls, payload);
+    RunLocal("local/copy", epoll_server.get(), LocalRpcChannel::Mode::Copy, calls, payload);
+    RunLocal("local/codec", epoll_server.get(), LocalRpcChannel::Mode::Codec, calls, payload);
+    RunSocket("epoll/tcp", false, calls, payload);
+    RunSocket("epoll/unix", true, calls, payload);
+    RunShm(calls, payload);
+
+    epoll_server->Stop();
+    shm_server->Stop();
+    epoll_thread.join();
+    shm_thread.join();
+    return 0;
+}
@@ -13,6 +13,8 @@ public:
         // 简单 echo + 加一点业务逻辑
         response->set_message("server echo: " + request->message());
 
-        if (done) done->Run(); // 这里我们是同步实现，可以不调用也行
+        // done->Run() 会编码并发送响应，必须调用且只能调用一次；
+        // 异步实现可以把 done 保存下来，等下游调用完成后在任意线程再调用
+        if (done) done->Run();
     }
 };
@@ -17,6 +17,7 @@ int main() {
                                         .WithPort(12345)
                                         .WithIOThreads(4)
                                         .WithNetwork(NetworkType::Muduo)
+                                        .WithUnixSocket("/tmp/tiny_rpc_echo.sock")   // 同机客户端可走 Unix 域 socket
                                         .Build());
     EchoServiceImpl echoService;
     server->RegisterService(&echoService);
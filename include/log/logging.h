@@ -0,0 +1,215 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*框架内部日志（网络层 / 分发器 / 客户端通道都用它，不再直接写 std::cerr 或同步 LOG_*）
+    - 编译期级别：低于 TINY_RPC_LOG_MIN_LEVEL 的 RPC_LOG_* 整条语句被编译器删掉，参数也不会求值；
+      默认去掉 TRACE（逐帧日志），需要时用 -DTINY_RPC_LOG_MIN_LEVEL=0 重新编译
+    - 运行期级别：SetLevel()，默认 INFO
+    - 异步：调用线程只把 (格式串指针, 文件, 行号, 时间, 参数的二进制值) 写进本线程的无锁环形缓冲区，
+      由后台线程取出后再格式化、写到输出（默认 stderr，可用 SetOutput 替换）；
+      环形缓冲区满时丢弃记录并计数，不会阻塞调用线程，也不会退化成同步写
+    - 格式串必须是字符串字面量（只保存指针），参数用 {} 占位：
+        RPC_LOG_INFO("conn {} frames={}", name, frames);
+      支持整数、浮点、bool、const char*、std::string、std::string_view；字符串参数会被拷贝（超长截断）
+    - 错误路径用 RPC_LOG_EVERY_MS 限流：同一条语句在 interval 内只输出一次，并带上期间被抑制的次数
+*/
+
+#ifndef TINY_RPC_LOG_MIN_LEVEL
+#define TINY_RPC_LOG_MIN_LEVEL 1
+#endif
+
+namespace rpclog {
+
+enum Level : int {
+    kTrace = 0,
+    kDebug,
+    kInfo,
+    kWarn,
+    kError,
+    kNumLevels,
+};
+
+namespace detail {
+extern std::atomic<int> g_level;
+}
+
+void SetLevel(Level level);
+Level GetLevel();
+
+inline bool Enabled(Level level) {
+    return level >= detail::g_level.load(std::memory_order_relaxed);
+}
+
+// 输出函数（后台线程调用，一次一批已格式化的行），默认写 stderr；运行中也可以替换
+using OutputFunc = void (*)(const char* msg, size_t len);
+using FlushFunc = void (*)();
+void SetOutput(OutputFunc out);
+void SetFlush(FlushFunc flush);
+
+// 等待后台线程把调用时刻之前提交的记录全部写出（测试、退出前使用）
+void Flush();
+
+// 因环形缓冲区满被丢弃的记录数
+uint64_t DroppedCount();
+
+namespace detail {
+
+enum class ArgType : uint8_t { kInt, kUint, kDouble, kString };
+
+constexpr size_t kMaxStringArg = 1024;   // 单个字符串参数最多拷贝的字节数
+
+// 一条记录的固定头部，后面紧跟编码后的参数；整条记录按 8 字节对齐
+struct RecordHeader {
+    uint32_t size;         // 整条记录（含头部、对齐填充）的字节数
+    uint8_t  level;        // kPadding 表示环尾的填充记录
+    uint8_t  nargs;
+    uint16_t reserved;
+    uint32_t line;
+    uint32_t reserved2;
+    int64_t  time_us;
+    const char* fmt;
+    const char* file;
+};
+constexpr uint8_t kPadding = 0xFF;
+
+// 在本线程的环形缓冲区中预留 size 字节（已对齐），满时返回 nullptr
+char* Reserve(size_t size);
+void Commit(size_t size);
+int64_t NowUs();
+
+// ---- 参数编码：[type][value]，字符串为 [type][u32 len][bytes] ----
+inline size_t StringArgSize(size_t len) {
+    return 1 + 4 + (len < kMaxStringArg ? len : kMaxStringArg);
+}
+inline char* PutString(char* p, const char* s, size_t len) {
+    if (len > kMaxStringArg) len = kMaxStringArg;
+    *p++ = static_cast<char>(ArgType::kString);
+    uint32_t n = static_cast<uint32_t>(len);
+    std::memcpy(p, &n, 4);
+    std::memcpy(p + 4, s, len);
+    return p + 4 + len;
+}
+template <typename T>
+inline char* PutScalar(char* p, ArgType type, T v) {
+    *p++ = static_cast<char>(type);
+    std::memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+template <typename T>
+inline size_t ArgSize(const T& v) {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        return 1 + 8;
+    } else if constexpr (std::is_convertible_v<const T&, const char*>) {
+        const char* s = v;
+        return StringArgSize(s ? std::strlen(s) : 0);
+    } else {
+        return StringArgSize(std::string_view(v).size());
+    }
+}
+
+template <typename T>
+inline char* PutArg(char* p, const T& v) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return PutScalar(p, ArgType::kDouble, static_cast<double>(v));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return PutScalar(p, ArgType::kInt, static_cast<int64_t>(v));
+    } else if constexpr (std::is_integral_v<T>) {
+        return PutScalar(p, ArgType::kUint, static_cast<uint64_t>(v));
+    } else if constexpr (std::is_enum_v<T>) {
+        return PutScalar(p, ArgType::kInt, static_cast<int64_t>(v));
+    } else if constexpr (std::is_convertible_v<const T&, const char*>) {
+        const char* s = v;
+        return s ? PutString(p, s, std::strlen(s)) : PutString(p, "", 0);
+    } else {
+        std::string_view s(v);
+        return PutString(p, s.data(), s.size());
+    }
+}
+
+} // namespace detail
+
+template <typename... Args>
+void Log(Level level, const char* file, int line, const char* fmt, const Args&... args) {
+    static_assert(sizeof...(Args) < 256, "too many log arguments");
+    size_t size = sizeof(detail::RecordHeader);
+    ((size += detail::ArgSize(args)), ...);
+    size = (size + 7) & ~static_cast<size_t>(7);
+
+    char* p = detail::Reserve(size);
+    if (!p) return;   // 缓冲区满：丢弃（已计数）
+
+    detail::RecordHeader h;
+    h.size = static_cast<uint32_t>(size);
+    h.level = static_cast<uint8_t>(level);
+    h.nargs = static_cast<uint8_t>(sizeof...(Args));
+    h.reserved = 0;
+    h.line = static_cast<uint32_t>(line);
+    h.reserved2 = 0;
+    h.time_us = detail::NowUs();
+    h.fmt = fmt;
+    h.file = file;
+    std::memcpy(p, &h, sizeof(h));
+    char* q = p + sizeof(h);
+    ((q = detail::PutArg(q, args)), ...);
+    (void)q;   // 无参数时折叠表达式为空
+    detail::Commit(size);
+}
+
+// 限流：interval_ms 内只放行一次，*suppressed 返回上次放行之后被拦下的次数
+class RateLimiter {
+public:
+    explicit RateLimiter(int64_t interval_ms) : interval_us_(interval_ms * 1000) {}
+
+    bool Allow(uint64_t* suppressed) {
+        int64_t now = detail::NowUs();
+        int64_t last = last_us_.load(std::memory_order_relaxed);
+        if (now - last < interval_us_ ||
+            !last_us_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        *suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    const int64_t interval_us_;
+    std::atomic<int64_t> last_us_{INT64_MIN / 2};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+} // namespace rpclog
+
+#define RPC_LOG(level, fmt, ...)                                                   \
+    do {                                                                           \
+        if ((level) >= TINY_RPC_LOG_MIN_LEVEL && ::rpclog::Enabled(level)) {      \
+            ::rpclog::Log((level), __FILE__, __LINE__, "" fmt, ##__VA_ARGS__);     \
+        }                                                                          \
+    } while (0)
+
+#define RPC_LOG_TRACE(fmt, ...) RPC_LOG(::rpclog::kTrace, fmt, ##__VA_ARGS__)
+#define RPC_LOG_DEBUG(fmt, ...) RPC_LOG(::rpclog::kDebug, fmt, ##__VA_ARGS__)
+#define RPC_LOG_INFO(fmt, ...)  RPC_LOG(::rpclog::kInfo, fmt, ##__VA_ARGS__)
+#define RPC_LOG_WARN(fmt, ...)  RPC_LOG(::rpclog::kWarn, fmt, ##__VA_ARGS__)
+#define RPC_LOG_ERROR(fmt, ...) RPC_LOG(::rpclog::kError, fmt, ##__VA_ARGS__)
+
+// 限流版本：每条语句各自一个 RateLimiter，输出时追加被抑制的次数
+#define RPC_LOG_EVERY_MS(level, interval_ms, fmt, ...)                             \
+    do {                                                                           \
+        if ((level) >= TINY_RPC_LOG_MIN_LEVEL && ::rpclog::Enabled(level)) {      \
+            static ::rpclog::RateLimiter rpc_log_limiter_(interval_ms);            \
+            uint64_t rpc_log_suppressed_ = 0;                                      \
+            if (rpc_log_limiter_.Allow(&rpc_log_suppressed_)) {                    \
+                ::rpclog::Log((level), __FILE__, __LINE__,                         \
+                              "" fmt " (suppressed {})", ##__VA_ARGS__,            \
+                              rpc_log_suppressed_);                                \
+            }                                                                      \
+        }                                                                          \
+    } while (0)
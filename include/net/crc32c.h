@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*CRC32C（Castagnoli），ChecksumFraming 用来校验整帧
+    编译时开启 SSE4.2（-msse4.2 / -march=native）时使用 crc32 指令，否则查表
+*/
+uint32_t Crc32c(const void* data, size_t len, uint32_t crc = 0);
@@ -0,0 +1,139 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include "net/crc32c.h"
+
+/*拆帧/组帧格式（帧 = RpcCodec 编出的 [meta_len][meta][body] 或 [定长头][ext][body]，这里只关心它前面的“帧前缀”）
+    - Fixed32：[4字节大端 frame_len][frame]，默认格式，与旧版本兼容
+    - Varint：[varint frame_len][frame]，小消息省 2~3 字节
+    - Checksum：[4字节大端 frame_len][4字节大端 crc32c(frame)][frame]，校验失败的连接直接断开
+  每种格式是一个只有静态方法的策略类，BasicFrameCodec<Policy> 在编译期选定，拆帧循环里没有虚调用；
+  需要运行期选择时（例如服务端按配置选），在整批数据或整条消息的粒度上 switch 一次（见 FramingPrefixLen）
+*/
+enum class FramingType {
+    Fixed32,
+    Varint,
+    Checksum,
+};
+
+enum class FrameStatus {
+    kNeedMore,   // 前缀或帧体不完整，等待更多数据
+    kFrame,      // 得到一条完整帧
+    kCorrupt,    // 数据无法解析（前缀非法、校验失败），连接应当关闭
+};
+
+/*策略类接口：
+    static FrameStatus Parse(const char* data, size_t readable, size_t* prefix_len, size_t* frame_len);
+        从 data 开始解析一条帧，kFrame 时 [data + prefix_len, data + prefix_len + frame_len) 即为帧
+    static size_t PrefixLen(size_t frame_len);
+    static void WritePrefix(char* p, size_t frame_len);
+        p 处预留了 PrefixLen(frame_len) 字节，帧已经写在它后面（Checksum 需要读帧内容）
+*/
+struct Fixed32Framing {
+    static constexpr FramingType kType = FramingType::Fixed32;
+
+    static FrameStatus Parse(const char* data, size_t readable,
+                             size_t* prefix_len, size_t* frame_len) {
+        if (readable < 4) return FrameStatus::kNeedMore;
+        uint32_t len_net = 0;
+        std::memcpy(&len_net, data, 4);
+        *prefix_len = 4;
+        *frame_len = ntohl(len_net);
+        return readable - 4 < *frame_len ? FrameStatus::kNeedMore : FrameStatus::kFrame;
+    }
+
+    static size_t PrefixLen(size_t) { return 4; }
+
+    static void WritePrefix(char* p, size_t frame_len) {
+        uint32_t len_net = htonl(static_cast<uint32_t>(frame_len));
+        std::memcpy(p, &len_net, 4);
+    }
+};
+
+struct VarintFraming {
+    static constexpr FramingType kType = FramingType::Varint;
+    static constexpr size_t kMaxPrefixLen = 5;   // uint32 的 varint 最多 5 字节
+
+    static FrameStatus Parse(const char* data, size_t readable,
+                             size_t* prefix_len, size_t* frame_len) {
+        uint64_t value = 0;
+        size_t n = 0;
+        while (true) {
+            if (n == readable) return FrameStatus::kNeedMore;
+            if (n == kMaxPrefixLen) return FrameStatus::kCorrupt;
+            uint8_t byte = static_cast<uint8_t>(data[n]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << (7 * n);
+            ++n;
+            if ((byte & 0x80) == 0) break;
+        }
+        if (value > UINT32_MAX) return FrameStatus::kCorrupt;
+        *prefix_len = n;
+        *frame_len = static_cast<size_t>(value);
+        return readable - n < *frame_len ? FrameStatus::kNeedMore : FrameStatus::kFrame;
+    }
+
+    static size_t PrefixLen(size_t frame_len) {
+        size_t n = 1;
+        while (frame_len >= 0x80) {
+            frame_len >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    static void WritePrefix(char* p, size_t frame_len) {
+        while (frame_len >= 0x80) {
+            *p++ = static_cast<char>((frame_len & 0x7F) | 0x80);
+            frame_len >>= 7;
+        }
+        *p = static_cast<char>(frame_len);
+    }
+};
+
+struct ChecksumFraming {
+    static constexpr FramingType kType = FramingType::Checksum;
+
+    static FrameStatus Parse(const char* data, size_t readable,
+                             size_t* prefix_len, size_t* frame_len) {
+        if (readable < 8) return FrameStatus::kNeedMore;
+        uint32_t len_net = 0, crc_net = 0;
+        std::memcpy(&len_net, data, 4);
+        std::memcpy(&crc_net, data + 4, 4);
+        *prefix_len = 8;
+        *frame_len = ntohl(len_net);
+        if (readable - 8 < *frame_len) return FrameStatus::kNeedMore;
+        if (Crc32c(data + 8, *frame_len) != ntohl(crc_net)) {
+            return FrameStatus::kCorrupt;
+        }
+        return FrameStatus::kFrame;
+    }
+
+    static size_t PrefixLen(size_t) { return 8; }
+
+    static void WritePrefix(char* p, size_t frame_len) {
+        Fixed32Framing::WritePrefix(p, frame_len);
+        uint32_t crc_net = htonl(Crc32c(p + 8, frame_len));
+        std::memcpy(p + 4, &crc_net, 4);
+    }
+};
+
+// 运行期选择格式的编码端：每条消息 switch 一次
+inline size_t FramingPrefixLen(FramingType type, size_t frame_len) {
+    switch (type) {
+    case FramingType::Varint:   return VarintFraming::PrefixLen(frame_len);
+    case FramingType::Checksum: return ChecksumFraming::PrefixLen(frame_len);
+    case FramingType::Fixed32:
+    default:                    return Fixed32Framing::PrefixLen(frame_len);
+    }
+}
+
+inline void WriteFramingPrefix(FramingType type, char* p, size_t frame_len) {
+    switch (type) {
+    case FramingType::Varint:   VarintFraming::WritePrefix(p, frame_len); break;
+    case FramingType::Checksum: ChecksumFraming::WritePrefix(p, frame_len); break;
+    case FramingType::Fixed32:
+    default:                    Fixed32Framing::WritePrefix(p, frame_len); break;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/*自有网络后端（epoll 等）使用的收发缓冲区：
+    [0, read_) 已消费 | [read_, write_) 可读数据 | [write_, size) 可写空间
+  与 muduo::net::Buffer 相同的思路：拆帧时直接 Peek() 可读区域，消费后 Retrieve()，
+  空间不够时先把可读数据挪到头部，仍不够再扩容
+*/
+class IoBuffer {
+public:
+    explicit IoBuffer(size_t initial = 4096) : buf_(initial) {}
+
+    const char* Peek() const { return buf_.data() + read_; }
+    size_t Readable() const { return write_ - read_; }
+    size_t Writable() const { return buf_.size() - write_; }
+    size_t Capacity() const { return buf_.size(); }
+
+    void Retrieve(size_t n) {
+        if (n < Readable()) {
+            read_ += n;
+        } else {
+            RetrieveAll();
+        }
+    }
+    void RetrieveAll() { read_ = write_ = 0; }
+
+    char* BeginWrite() { return buf_.data() + write_; }
+    void HasWritten(size_t n) { write_ += n; }
+
+    void EnsureWritable(size_t n) {
+        if (Writable() >= n) return;
+        size_t readable = Readable();
+        if (read_ + Writable() >= n) {
+            // 前面已消费的空间足够：挪动数据而不扩容
+            std::memmove(buf_.data(), buf_.data() + read_, readable);
+        } else {
+            std::vector<char> bigger(readable + n > 2 * buf_.size() ? readable + n : 2 * buf_.size());
+            std::memcpy(bigger.data(), buf_.data() + read_, readable);
+            buf_.swap(bigger);
+        }
+        read_ = 0;
+        write_ = readable;
+    }
+
+    void Append(const char* data, size_t len) {
+        EnsureWritable(len);
+        std::memcpy(BeginWrite(), data, len);
+        HasWritten(len);
+    }
+
+    // 空闲时归还大块内存（例如偶发的大请求之后），缓冲区中仍有数据时不做任何事
+    void ShrinkIfIdle(size_t max_capacity) {
+        if (Readable() == 0 && buf_.size() > max_capacity) {
+            std::vector<char>(max_capacity).swap(buf_);
+            RetrieveAll();
+        }
+    }
+
+private:
+    std::vector<char> buf_;
+    size_t read_ = 0;
+    size_t write_ = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <string_view>
 
 class RpcConnection;
 
@@ -15,9 +16,10 @@ class MessageHandler {
 public:
     virtual ~MessageHandler() = default;
 
+    // frame 指向网络层接收缓冲区，只在本次调用期间有效
     virtual void HandleMessage(
         const std::shared_ptr<RpcConnection>& conn,
-        const std::string& frame) = 0;
+        std::string_view frame) = 0;
 };
 
 class INetworkServer {
@@ -0,0 +1,36 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+
+// 网络后端（epoll / io_uring / muduo 的 Unix 域 socket 部分）与客户端共用的 socket 小工具
+namespace sockets {
+
+// 打开一个绑定 INADDR_ANY:port 的非阻塞 SO_REUSEPORT 监听 socket，失败抛出 std::runtime_error
+// 同一进程里多个 IO 线程各调用一次，由内核在这些 socket 之间分配新连接
+int OpenReusePortListener(int port);
+
+/*Unix 域 socket（同机部署的调用方绕过 TCP 回环协议栈，协议完全不变）：
+    OpenUnixListener 打开一个绑定 path 的非阻塞监听 socket，失败抛出 std::runtime_error；
+    path 上残留的旧 socket 文件（上次进程没有清理）会先删掉，但不会删除其他类型的文件。
+    多个 IO 线程可以共享同一个监听 fd（各自注册到自己的事件循环里），由内核把新连接交给其中一个
+*/
+int OpenUnixListener(const std::string& path);
+// 关闭监听 fd 并删除 socket 文件
+void CloseUnixListener(int fd, const std::string& path);
+// 非阻塞地连接到 path，成功返回（非阻塞的）fd；失败返回 -1（errno 有效）。
+// 服务端 backlog 已满时不等待，errno 为 EAGAIN，由调用方稍后重试
+int ConnectUnix(const std::string& path);
+
+// 把刚 accept 的 fd 投递给另一个 IO 线程时用：任务执行时取走（置 -1），
+// 任务没来得及执行（目标循环已退出）就被丢弃时析构即关闭，不会泄漏
+std::shared_ptr<int> MakeOwnedFd(int fd);
+
+// socket 实际绑定的本地端口（bind 端口 0 时由内核分配）
+int LocalPort(int fd);
+
+// "ip:port"；Unix 域 socket 为 "unix:path"（客户端一端通常没有绑定路径，为 "unix:"）
+std::string ToIpPort(const sockaddr_storage& addr);
+std::string PeerIpPort(int fd);
+
+} // namespace sockets
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+
+// 注册到 EpollLoop 上的 fd 的事件处理者（监听 socket、连接）
+class EpollHandler {
+public:
+    virtual ~EpollHandler() = default;
+    virtual void HandleEvents(uint32_t events) = 0;
+};
+
+/*一个 IO 线程的事件循环：epoll + eventfd 唤醒 + 待执行任务队列
+    - 每轮：epoll_wait -> 处理就绪 fd -> 执行 QueueInLoop 投递的任务
+    - 其他线程 QueueInLoop 时写 eventfd 唤醒；本线程处理事件期间 QueueInLoop 不唤醒，
+      任务在本轮事件处理完之后执行（写合并依赖这一点，与 muduo 的 queueInLoop 语义相同）
+    - 除 Quit/QueueInLoop/RunInLoop/IsInLoopThread 外，其余接口只能在循环线程调用
+*/
+class EpollLoop {
+public:
+    using Functor = std::function<void()>;
+
+    EpollLoop();
+    ~EpollLoop();
+
+    EpollLoop(const EpollLoop&) = delete;
+    EpollLoop& operator=(const EpollLoop&) = delete;
+
+    // 在调用线程中运行，直到 Quit()（Loop 之前就调用过 Quit 时立即返回）
+    void Loop();
+    void Quit();
+
+    bool IsInLoopThread() const {
+        return thread_id_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+    void RunInLoop(Functor cb);
+    void QueueInLoop(Functor cb);
+
+    // 注册/注销 fd；handler 的生命周期由调用方保证，至少持续到 Remove
+    bool Add(int fd, uint32_t events, EpollHandler* handler);
+    void Remove(int fd);
+
+private:
+    void Wakeup();
+    void DrainWakeup();
+    void DoPendingFunctors();
+
+    int epoll_fd_;
+    int wakeup_fd_;
+    std::atomic<bool> quit_{false};
+    std::atomic<std::thread::id> thread_id_{};   // Loop() 开始时设置，其他线程会并发读取
+    bool calling_functors_ = false;
+
+    std::mutex mutex_;
+    std::vector<Functor> pending_;
+    std::vector<epoll_event> events_;
+};
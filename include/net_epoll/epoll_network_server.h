@@ -0,0 +1,58 @@
+#pragma once
+#include "net/network_server.h"
+#include "net/framing.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*原生 Linux epoll 后端（边沿触发），不依赖 muduo：
+    - 每个 IO 线程一个 EpollLoop，并各自持有一个绑定同一端口的 SO_REUSEPORT 监听 socket，
+      由内核在这些监听 socket 之间分配新连接——没有单独的 acceptor 线程，也没有“accept 后再分发到 IO 线程”的跨线程投递
+    - 监听 socket 同样是 EPOLLET：一次可读事件里循环 accept4 直到 EAGAIN，一批新连接一次唤醒处理完
+    - 连接从建立到关闭都只在接受它的那个 IO 线程里处理（见 EpollRpcConnection）
+    - 跨线程（worker 线程发送响应、Stop）通过每个 loop 的 eventfd 唤醒
+    - 可同时监听一个 Unix 域 socket（SetUnixSocket）：Unix 域 socket 不支持 SO_REUSEPORT 分流，
+      由第 0 个 IO 线程 accept 后轮流投递给各 IO 线程，之后与 TCP 连接完全相同
+  Run() 在调用线程运行第 0 个 IO 线程的循环，其余 io_threads-1 个循环各自一个线程；Stop() 线程安全
+*/
+class EpollNetworkServer : public INetworkServer {
+public:
+    EpollNetworkServer(int port, int io_threads = 4);
+    ~EpollNetworkServer() override;
+
+    void Run() override;
+    void Stop() override;
+    void SetMessageHandler(std::shared_ptr<MessageHandler> handler) override;
+
+    // 写合并，语义同 MuduoNetworkServer::SetWriteCoalescing；需在 Run() 之前调用
+    void SetWriteCoalescing(size_t max_pending_bytes);
+    // 帧前缀格式（见 net/framing.h）；需在 Run() 之前调用
+    void SetFraming(FramingType framing);
+
+    // 在 TCP 端口之外再监听一个 Unix 域 socket 路径（Run() 时创建，退出时删除）；需在 Run() 之前调用
+    void SetUnixSocket(const std::string& path);
+
+    // 实际监听的端口（构造时 port 为 0 则由内核分配），Run() 开始监听之后有效
+    int port() const { return bound_port_.load(std::memory_order_acquire); }
+
+private:
+    struct IoThread;
+
+    void RunIoThread(IoThread* t);
+
+    int port_;
+    int io_threads_;
+    std::shared_ptr<MessageHandler> handler_;
+    size_t coalesce_max_bytes_ = 0;   // 写合并上限，0 表示关闭
+    FramingType framing_ = FramingType::Fixed32;
+    std::string unix_path_;           // 为空表示不监听 Unix 域 socket
+    int unix_listen_fd_ = -1;         // 注册在第 0 个 IO 线程
+    size_t next_unix_thread_ = 0;     // 下一个 Unix 域连接交给哪个 IO 线程，只在第 0 个 IO 线程访问
+
+    std::mutex mutex_;                // 保护 threads_ 的创建与 Stop 之间的竞争
+    std::vector<std::unique_ptr<IoThread>> threads_;
+    bool stopping_ = false;
+    std::atomic<int> bound_port_{0};
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "rpc/rpc_connection.h"
+#include "net/network_server.h"
+#include "net/io_buffer.h"
+#include "net_epoll/epoll_loop.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+/*epoll 后端的一个 TCP 连接：自己持有 fd、收发缓冲区和连接级统计，不经过任何第三方网络库
+    - 注册一次 EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET，之后不再 epoll_ctl 修改关注事件：
+      边沿触发下可写事件只在“写不下 -> 可写”时到来一次，输出缓冲区为空时什么也不做
+    - 可读：readv 到 input_ + 64KB 栈上缓冲，每读一次就在 input_ 上直接拆帧（BasicFrameCodec），
+      读到的字节数少于提供的空间说明内核缓冲区已空，不再多调用一次 read 去等 EAGAIN
+      （之后若有新数据到达，边沿触发会再次通知）
+    - 发送：IO 线程内且输出缓冲区为空时直接 write/writev 调用方内存，写不完的部分才拷贝进 output_；
+      其他线程的发送拷贝一份后投递回 IO 线程
+    - 写合并语义与 MuduoRpcConnection 相同（见 muduo_rpc_connection.h）
+  生命周期：由所属 IO 线程的连接表持有；关闭后 worker 线程手里残留的 shared_ptr 调用 Send 会直接丢弃
+*/
+class EpollRpcConnection : public RpcConnection,
+                           public EpollHandler,
+                           public std::enable_shared_from_this<EpollRpcConnection> {
+public:
+    using CloseCallback = std::function<void(int fd)>;
+
+    EpollRpcConnection(EpollLoop* loop, int fd, std::string peer,
+                       MessageHandler* handler,
+                       size_t coalesce_max_bytes = 0,
+                       FramingType framing = FramingType::Fixed32);
+    ~EpollRpcConnection() override;
+
+    // 注册到 epoll，开始收发（IO 线程内调用）
+    bool Start();
+    // 连接关闭时回调（IO 线程内），用于从连接表中移除
+    void SetCloseCallback(CloseCallback cb) { close_cb_ = std::move(cb); }
+    // 立即关闭（IO 线程内），未发出的数据被丢弃
+    void ForceClose();
+
+    void Send(const std::string& data) override;
+    void SendV(const IoSlice* slices, size_t count) override;
+    FramingType GetFraming() const override { return framing_; }
+
+    void HandleEvents(uint32_t events) override;
+
+    int fd() const { return fd_; }
+    const std::string& peer() const { return peer_; }
+
+private:
+    // hangup: 本次事件已带挂断/错误标志，必须读到 EOF 或错误为止
+    void HandleRead(bool hangup);
+    // 按 Framing 格式拆出 input_ 中的所有完整帧，返回已消费的字节数
+    template <typename Framing>
+    size_t SplitFrames(bool* corrupt);
+    void ProcessInput();
+
+    void SendInLoop(const char* data, size_t len);
+    void SendVInLoop(const IoSlice* slices, size_t count);
+    // 数据已追加进 output_ 之后：未开合并或达到合并上限时立即 flush，否则安排在本轮事件循环末尾 flush
+    void AfterAppend();
+    // 把 output_ 尽量写进内核，写不下的留到下一次可写事件
+    void Flush();
+    // 直接写调用方内存，返回已写出的字节数；出错时关闭连接并返回 -1
+    ssize_t WriteDirect(const char* data, size_t len);
+    void HandleClose();
+
+    EpollLoop* loop_;
+    const int fd_;
+    const std::string peer_;
+    MessageHandler* handler_;
+    size_t coalesce_max_bytes_;   // 0 表示不合并
+    FramingType framing_;
+
+    std::atomic<bool> closed_{false};
+    bool flush_scheduled_ = false;
+    CloseCallback close_cb_;
+
+    IoBuffer input_;
+    IoBuffer output_;
+
+    uint64_t reads_ = 0;          // 成功的 read 次数
+    uint64_t frames_ = 0;         // 拆出的完整帧数
+    uint64_t bytes_consumed_ = 0; // 已被拆帧消费的字节数（含帧前缀）
+};
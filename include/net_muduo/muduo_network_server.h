@@ -5,33 +5,81 @@
 #include <muduo/net/TcpServer.h>
 #include <muduo/net/EventLoop.h>
 #include <muduo/net/Buffer.h>
-#include <muduo/base/Logging.h>
+#include "log/logging.h"
 #include <boost/any.hpp>
+#include <map>
+#include <memory>
+#include <string>
 
+namespace muduo { namespace net { class Channel; } }
+
+/*每个 TCP 连接一份的上下文，挂在 TcpConnection 的 context 上，连接建立时创建、断开时清除
+    - rpc_conn: 整个连接生命周期内唯一的 RpcConnection 适配器（MuduoRpcConnection），不再每次可读事件都 make_shared 一次；
+      直接存成基类指针，传给 MessageHandler 时不必再构造一个转换出来的临时 shared_ptr（那会多一对原子增减）
+    - 接收数据本身留在 muduo 的 inputBuffer 中（半包也在那里），这里只记录连接级统计
+  注意：rpc_conn 持有 TcpConnectionPtr，而 context 又挂在 TcpConnection 上，形成循环引用，
+       所以连接断开时必须清空 context
+*/
 struct ConnContext {
-    std::string inbuf;
+    std::shared_ptr<RpcConnection> rpc_conn;
+
+    uint64_t reads = 0;          // 可读事件次数
+    uint64_t frames = 0;         // 拆出的完整帧数
+    uint64_t bytes_consumed = 0; // 已被拆帧消费的字节数（含长度前缀）
 };
 
 
 class MuduoNetworkServer : public INetworkServer {
 public:
     MuduoNetworkServer(int port,int threadNum=4);
+    ~MuduoNetworkServer() override;
 
     void Run() override;
     void Stop() override;
     void SetMessageHandler(std::shared_ptr<MessageHandler> handler) override;
 
+    // 开启写合并：同一轮事件循环中对同一连接的响应合并成一次 write
+    // max_pending_bytes: 合并缓冲区上限（达到即立刻 flush，单条超过上限的响应直接发送），0 表示关闭
+    // 需在 Run() 之前调用，只影响之后建立的连接
+    void SetWriteCoalescing(size_t max_pending_bytes);
+
+    // 本监听端口使用的帧前缀格式（见 net/framing.h），客户端必须使用同一格式；需在 Run() 之前调用
+    void SetFraming(FramingType framing);
+
+    /*在 TCP 端口之外再监听一个 Unix 域 socket 路径（Run() 时创建，退出时删除）；需在 Run() 之前调用
+      muduo 的 Acceptor / InetAddress 只支持 IP 地址，这里在主 loop 上自己 accept，
+      再像 TcpServer 一样把连接轮流交给 IO 线程池里的 loop：之后的收发、拆帧与 TCP 连接完全相同
+    */
+    void SetUnixSocket(const std::string& path);
+
 private:
     void onConnection(const muduo::net::TcpConnectionPtr& conn);
     void onMessage(const muduo::net::TcpConnectionPtr& conn,
                    muduo::net::Buffer* buffer,
                    muduo::Timestamp);
+    // 用 Framing 格式拆出 buffer 中的所有完整帧，返回已消费的字节数
+    template <typename Framing>
+    size_t SplitFrames(ConnContext* ctx, muduo::net::Buffer* buffer, bool* corrupt);
+
+    // Unix 域 socket：以下都在主 loop 线程执行
+    void startUnixListener();
+    void stopUnixListener();
+    void onUnixAccept();
+    void removeUnixConnection(const muduo::net::TcpConnectionPtr& conn);
 
 private:
+    muduo::net::EventLoop loop_;      // 必须先于 server_ 构造（server_ 的构造需要 &loop_）
     muduo::net::TcpServer server_;
-    muduo::net::EventLoop loop_;
-    FrameCodec frame_codec_;
     /*frame处理类：网络模块解析出frame后，通过这个进行处理即可——>由rpc_server注入*/
     /*网络模块只负责提取出frame，具体如何处理交给“上层注入的处理类/方法”*/
     std::shared_ptr<MessageHandler> handler_;
+    size_t coalesce_max_bytes_ = 0;   // 写合并上限，0 表示关闭
+    FramingType framing_ = FramingType::Fixed32;
+
+    std::string unix_path_;           // 为空表示不监听 Unix 域 socket
+    int unix_listen_fd_ = -1;
+    int unix_idle_fd_ = -1;           // 预留的 fd：fd 耗尽（EMFILE）时先关掉它，把待接受的连接 accept 后立即关闭
+    std::unique_ptr<muduo::net::Channel> unix_channel_;
+    std::map<std::string, muduo::net::TcpConnectionPtr> unix_conns_;   // 由我们自己持有，相当于 TcpServer::connections_
+    int next_unix_conn_id_ = 1;
 };
\ No newline at end of file
@@ -1,25 +1,134 @@
 #pragma once
 #include "rpc/rpc_connection.h"
 #include <muduo/net/TcpConnection.h>
-#include <muduo/base/Logging.h>
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/Buffer.h>
+#include "log/logging.h"
+#include <memory>
 
-class MuduoRpcConnection : public RpcConnection {
+/*写合并（auto-corking）：
+    coalesce_max_bytes > 0 时开启。同一次事件循环迭代里对本连接产生的所有响应先追加到 pending_，
+    第一次追加时 queueInLoop 一个 Flush，muduo 在处理完本轮 IO 事件后执行 pending functors，
+    于是一轮里的 N 个响应只需要一次 write（客户端 pipeline 50 个请求 -> 1 次系统调用而不是 50 次）。
+    - 字节上限：pending_ 达到 coalesce_max_bytes 立即 flush；单条 >= 上限的大响应不进 pending_，直接发送，不会被延迟
+    - 延迟上限：数据最多在 pending_ 中停留到本轮事件循环结束
+*/
+class MuduoRpcConnection : public RpcConnection,
+                           public std::enable_shared_from_this<MuduoRpcConnection> {
 public:
-    explicit MuduoRpcConnection(const muduo::net::TcpConnectionPtr& conn)
-        : conn_(conn) {}
+    explicit MuduoRpcConnection(const muduo::net::TcpConnectionPtr& conn,
+                                size_t coalesce_max_bytes = 0,
+                                FramingType framing = FramingType::Fixed32)
+        : conn_(conn), coalesce_max_bytes_(coalesce_max_bytes), framing_(framing) {}
+
+    FramingType GetFraming() const override { return framing_; }
 
     void Send(const std::string& data) override {
-        if (!conn_) {
-            LOG_ERROR << "RpcConnection null";
+        if (!CheckConnected()) return;
+        if (coalesce_max_bytes_ == 0) {
+            conn_->send(data);
+            return;
+        }
+        if (!conn_->getLoop()->isInLoopThread()) {
+            // 其他线程产生的响应：投递回所属 IO 线程再参与合并（muduo 自己跨线程 send 时同样要拷贝一份）
+            auto self = shared_from_this();
+            conn_->getLoop()->queueInLoop([self, data]() { self->Send(data); });
+            return;
+        }
+        Append(data.data(), data.size());
+    }
+
+    /*muduo 的 TcpConnection 没有暴露 fd，也没有 writev 接口，这里用最接近的方式实现：
+        - 小片段（头部、meta）合并成一次 send，避免每个 8 字节头部都单独一次系统调用
+        - 大片段（>= kLargeSliceBytes）直接把调用方内存交给 TcpConnection::send：
+          在 IO 线程且输出缓冲区为空时，muduo 会直接 ::write 调用方内存，只有内核暂时写不下的剩余部分才会拷贝进 outputBuffer
+        - 不在 IO 线程时 muduo 无论如何都会拷贝一份再投递，所以直接拼接成一段发送
+    */
+    void SendV(const IoSlice* slices, size_t count) override {
+        if (!CheckConnected()) return;
+        if (!conn_->getLoop()->isInLoopThread()) {
+            RpcConnection::SendV(slices, count);
             return;
         }
+
+        if (coalesce_max_bytes_ > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                Append(static_cast<const char*>(slices[i].data), slices[i].len);
+            }
+            return;
+        }
+
+        thread_local std::string gather;
+        gather.clear();
+        for (size_t i = 0; i < count; ++i) {
+            const char* data = static_cast<const char*>(slices[i].data);
+            if (slices[i].len < kLargeSliceBytes) {
+                gather.append(data, slices[i].len);
+                continue;
+            }
+            if (!gather.empty()) {
+                conn_->send(gather.data(), static_cast<int>(gather.size()));
+                gather.clear();
+            }
+            conn_->send(data, static_cast<int>(slices[i].len));
+        }
+        if (!gather.empty()) {
+            conn_->send(gather.data(), static_cast<int>(gather.size()));
+        }
+    }
+
+    // 立即发出 pending_ 中合并的数据（只能在 IO 线程调用）
+    void Flush() {
+        flush_scheduled_ = false;
+        if (pending_.readableBytes() == 0) return;
         if (!conn_->connected()) {
-            LOG_WARN << "RpcConnection disconnected, drop response";
+            pending_.retrieveAll();
             return;
         }
-        conn_->send(data);
+        conn_->send(&pending_);   // IO 线程内：直接 write，写不完的部分进 outputBuffer，并清空 pending_
     }
 
 private:
+    static constexpr size_t kLargeSliceBytes = 64 * 1024;
+
+    bool CheckConnected() const {
+        if (!conn_) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "RpcConnection null");
+            return false;
+        }
+        if (!conn_->connected()) {
+            // 对端断开后，积压的响应会逐条走到这里
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcConnection disconnected, drop response");
+            return false;
+        }
+        return true;
+    }
+
+    // 合并模式下追加一段数据（IO 线程内）
+    void Append(const char* data, size_t len) {
+        if (len >= coalesce_max_bytes_) {
+            // 大块数据不等待：先把之前合并的发出去保证顺序，再直接发送
+            Flush();
+            conn_->send(data, static_cast<int>(len));
+            return;
+        }
+        pending_.append(data, len);
+        if (pending_.readableBytes() >= coalesce_max_bytes_) {
+            Flush();
+            return;
+        }
+        if (!flush_scheduled_) {
+            flush_scheduled_ = true;
+            // 在 IO 线程内 queueInLoop 不会唤醒 poller，回调会在本轮事件处理完之后执行
+            auto self = shared_from_this();
+            conn_->getLoop()->queueInLoop([self]() { self->Flush(); });
+        }
+    }
+
     muduo::net::TcpConnectionPtr conn_;
+
+    size_t coalesce_max_bytes_;      // 0 表示不合并
+    muduo::net::Buffer pending_;     // 本轮事件循环中待合并发送的数据
+    bool flush_scheduled_ = false;
+    FramingType framing_;
 };
@@ -0,0 +1,58 @@
+#pragma once
+#include <muduo/net/Callbacks.h>
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/TcpConnection.h>
+#include <muduo/net/TimerId.h>
+#include <mutex>
+#include <string>
+
+/*Unix 域 socket 客户端：muduo::net::TcpClient 只能连 InetAddress，同机调用方用这个连服务端的
+  WithUnixSocket(path)。接口与 TcpClient 对齐（连接 / 消息回调、connect / disconnect），
+  连接建立后得到的仍是普通的 TcpConnectionPtr，上层的 FrameCodec / SimpleRpcChannel 用法不变
+    - connect() 失败（服务端还没起来、backlog 满）时按 0.5s 起、翻倍到 30s 的间隔重试
+    - 连接断开后不会自动重连，需要的话在连接回调里再调 connect()
+  必须在 loop 所在线程析构
+*/
+class MuduoUnixClient {
+public:
+    MuduoUnixClient(muduo::net::EventLoop* loop, std::string path, std::string name);
+    ~MuduoUnixClient();
+
+    MuduoUnixClient(const MuduoUnixClient&) = delete;
+    MuduoUnixClient& operator=(const MuduoUnixClient&) = delete;
+
+    void setConnectionCallback(muduo::net::ConnectionCallback cb) { connection_callback_ = std::move(cb); }
+    void setMessageCallback(muduo::net::MessageCallback cb) { message_callback_ = std::move(cb); }
+
+    // 线程安全
+    void connect();
+    void disconnect();
+
+    muduo::net::TcpConnectionPtr connection() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return connection_;
+    }
+
+private:
+    void connectInLoop();
+    void retry();
+    void removeConnection(const muduo::net::TcpConnectionPtr& conn);
+
+    muduo::net::EventLoop* loop_;
+    const std::string path_;
+    const std::string name_;
+    muduo::net::ConnectionCallback connection_callback_;
+    muduo::net::MessageCallback message_callback_;
+
+    double retry_delay_s_ = kInitRetryDelaySeconds;
+    muduo::net::TimerId retry_timer_;
+    bool retry_pending_ = false;
+    bool connect_ = false;          // 用户是否希望处于连接状态（disconnect() 后停止重试）
+    int next_conn_id_ = 1;
+
+    mutable std::mutex mutex_;
+    muduo::net::TcpConnectionPtr connection_;
+
+    static constexpr double kInitRetryDelaySeconds = 0.5;
+    static constexpr double kMaxRetryDelaySeconds = 30.0;
+};
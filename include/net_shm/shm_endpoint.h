@@ -0,0 +1,114 @@
+#pragma once
+#include "net_shm/shm_segment.h"
+#include "net/frame_codec.h"
+#include "net/io_buffer.h"
+#include "rpc/rpc_connection.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/*共享内存连接的一端（服务端连接与客户端 channel 共用）：消费一个环，生产另一个环
+    发送（任意线程，内部一把只在本端发送者之间竞争的锁）：
+      - 环里放得下整段数据时直接拷进环并发布；BeginFrame/CommitFrame 让编码器直接写进环，连一次拷贝都没有
+      - 放不下时追加到 overflow_，等对端读走数据腾出空间后由所属线程 FlushOverflow 继续写（字节流可以分段写）；
+        overflow_ 非空时之后的数据都排在它后面，保证顺序
+    接收（只在所属线程）：ReadFrames 直接在环上拆帧，回调拿到的帧就是共享内存的视图，回调返回后才归还空间；
+      生产者按整帧写入，正常情况下环里不会留下半包。只有超过半个环的大帧（必须分段写）才搬进 input_ 拼完整，
+      否则环被半包占满，对端再也写不进剩下的部分
+    对端可信度：head/tail 都在共享内存里，对端可以随意改写。读到 tail - head 超过环容量时视为环已损坏（broken()）：
+      不再返回可读数据、不再写入，所属线程发现后必须关闭连接
+    唤醒：只在对端已经睡眠（waiting 标志）时才写对端的 eventfd；忙碌时双方只读写共享内存，数据路径上没有系统调用
+      睡眠方：置 waiting -> 全屏障 -> 再检查一次有没有事可做 -> 真的没有才睡
+      唤醒方：发布 tail/head -> 全屏障 -> 看到 waiting 就清掉并写 eventfd
+*/
+class ShmEndpoint {
+public:
+    // segment 由调用方持有，生命周期长于本对象；peer_efd 为对端等待的 eventfd（不接管所有权）
+    ShmEndpoint(ShmSegment* segment, ShmSide side, int peer_efd);
+
+    ShmEndpoint(const ShmEndpoint&) = delete;
+    ShmEndpoint& operator=(const ShmEndpoint&) = delete;
+
+    // ---- 发送（任意线程） ----
+    void Send(const IoSlice* slices, size_t count);
+    char* BeginFrame(size_t len);    // 成功时持有发送锁直到 CommitFrame
+    void CommitFrame();
+    // 把 overflow_ 尽量写进环；返回 overflow_ 是否已清空
+    bool FlushOverflow();
+
+    // ---- 接收（所属线程） ----
+    // 拆出当前所有完整帧，每帧调用一次 cb(std::string_view frame)；遇到无法解析的数据或环已损坏返回 false
+    template <typename Framing, typename Callback>
+    bool ReadFrames(Callback&& cb);
+    // 环里当前可读的数据；环已损坏时返回 false
+    bool Readable(std::string_view* data);
+    void Consume(size_t n);
+
+    // 对端把 head/tail 改到了越界的位置：连接不能再用
+    bool broken() const { return broken_.load(std::memory_order_acquire); }
+
+    // ---- 睡眠协议（所属线程） ----
+    // 现在有没有事可做：有可读数据，或者 overflow_ 非空且环里有空间
+    bool HasWork();
+    // 忙轮询最多 micros 微秒等待 HasWork()，等到返回 true
+    bool SpinForWork(int micros);
+    // 默认忙轮询时长：多核时 50us；单核上忙轮询只会抢走对端需要的 CPU，为 0
+    static int DefaultBusyPollMicros();
+    // 准备睡眠：返回 false 表示置标志后发现又有事可做（标志已清除），不能睡
+    bool PrepareWait();
+    // 醒来后清除自己的睡眠标志，对端不必再写 eventfd
+    void ClearWaiting() { my_waiting_->store(0, std::memory_order_relaxed); }
+
+private:
+    size_t FreeSpaceLocked();
+    void MarkBroken();
+    void PublishLocked(size_t n);
+    void WriteLocked(const char* data, size_t len);
+    void WakePeer();
+
+    ShmRingControl* in_;
+    ShmRingControl* out_;
+    const char* in_data_;
+    char* out_data_;
+    const size_t capacity_;
+    const size_t mask_;
+    std::atomic<uint32_t>* my_waiting_;
+    std::atomic<uint32_t>* peer_waiting_;
+    const int peer_efd_;
+
+    IoBuffer input_;              // 大帧的半包（只在所属线程访问）
+
+    std::mutex send_mutex_;
+    std::string overflow_;        // 环满时暂存的待发数据（受 send_mutex_ 保护）
+    size_t reserved_ = 0;         // BeginFrame 预留的长度（持锁期间有效）
+    std::atomic<bool> broken_{false};
+};
+
+template <typename Framing, typename Callback>
+bool ShmEndpoint::ReadFrames(Callback&& cb)
+{
+    std::string_view data;
+    if (!Readable(&data)) return false;
+    if (data.empty()) return true;
+
+    bool corrupt = false;
+    auto on_frame = [&cb](const std::shared_ptr<RpcConnection>&, std::string_view frame) { cb(frame); };
+    if (input_.Readable() == 0) {
+        size_t consumed = BasicFrameCodec<Framing>::OnData(data.data(), data.size(), nullptr, on_frame, &corrupt);
+        size_t rest = data.size() - consumed;
+        if (!corrupt && rest >= capacity_ / 2) {
+            input_.Append(data.data() + consumed, rest);
+            consumed = data.size();
+        }
+        Consume(consumed);
+    } else {
+        input_.Append(data.data(), data.size());
+        Consume(data.size());
+        size_t consumed = BasicFrameCodec<Framing>::OnData(input_.Peek(), input_.Readable(), nullptr,
+                                                           on_frame, &corrupt);
+        input_.Retrieve(consumed);
+        input_.ShrinkIfIdle(capacity_);
+    }
+    return !corrupt;
+}
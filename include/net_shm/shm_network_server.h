@@ -0,0 +1,55 @@
+#pragma once
+#include "net/network_server.h"
+#include "net/framing.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*同机共享内存传输的服务端：数据路径上不经过内核
+    - 建连：客户端连上 Unix 域 socket（只用来握手和探测对端存活），服务端为这个连接新建一个 ShmSegment
+      （两个方向各一个 SPSC 字节环）和两个 eventfd，通过 SCM_RIGHTS 把三个 fd 交给客户端（见 shm_segment.h）
+    - 之后请求/响应都直接读写共享内存；响应由 RpcCodec::SendResponse 经 BeginFrame/CommitFrame 直接编码进环
+    - 唤醒：连接处理完手头的帧后先忙轮询 busy_poll_us 微秒，仍然没有新数据才置睡眠标志、回到 epoll 等自己的 eventfd；
+      对端只在看到睡眠标志时才写 eventfd（见 ShmEndpoint），持续有流量时双方都不进内核
+    - 线程模型与 EpollNetworkServer 相同：每个 IO 线程一个 EpollLoop，第 0 个 IO 线程负责握手，
+      握手完成后轮流交给各 IO 线程，连接此后只在该线程处理
+    - 握手 socket 上的任何挂断/错误都视为对端退出，连接随之关闭
+  忙轮询期间 IO 线程不处理同一线程上的其他连接：连接数多于 IO 线程时应调小 busy_poll_us（0 关闭忙轮询）
+*/
+class ShmNetworkServer : public INetworkServer {
+public:
+    ShmNetworkServer(const std::string& path, int io_threads = 4);
+    ~ShmNetworkServer() override;
+
+    void Run() override;
+    void Stop() override;
+    void SetMessageHandler(std::shared_ptr<MessageHandler> handler) override;
+
+    // 帧前缀格式，握手时告诉客户端；需在 Run() 之前调用
+    void SetFraming(FramingType framing);
+    // 每个方向的环大小（字节，向上取整到 2 的幂）；需在 Run() 之前调用
+    void SetCapacity(size_t capacity);
+    // 空闲前的忙轮询时长（微秒），0 表示处理完立即睡眠，默认见 ShmEndpoint::DefaultBusyPollMicros；需在 Run() 之前调用
+    void SetBusyPollMicros(int micros);
+
+private:
+    struct IoThread;
+    class Connection;
+
+    void RunIoThread(IoThread* t);
+
+    std::string path_;
+    int io_threads_;
+    std::shared_ptr<MessageHandler> handler_;
+    FramingType framing_ = FramingType::Fixed32;
+    size_t capacity_;
+    int busy_poll_us_;
+    int listen_fd_ = -1;              // 注册在第 0 个 IO 线程
+    size_t next_thread_ = 0;          // 下一个连接交给哪个 IO 线程，只在第 0 个 IO 线程访问
+
+    std::mutex mutex_;                // 保护 threads_ 的创建与 Stop 之间的竞争
+    std::vector<std::unique_ptr<IoThread>> threads_;
+    bool stopping_ = false;
+};
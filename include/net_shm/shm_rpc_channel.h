@@ -0,0 +1,67 @@
+#pragma once
+#include "rpc/rpc_channel.h"
+#include <google/protobuf/service.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+class ShmSegment;
+class ShmEndpoint;
+
+/*共享内存传输的客户端（服务端见 ShmNetworkServer）：同机、延迟敏感的调用方用它代替 socket 连接
+    - Connect：连上服务端的握手 Unix 域 socket，收下 memfd 和两个 eventfd，映射共享内存，
+      按服务端告知的帧格式设置内部的 SimpleRpcChannel 并发起方法编号握手
+    - 请求：SimpleRpcChannel 编码好的帧拷贝进环（调用线程直接写，环满时暂存，由收包线程续写）
+    - 响应：一个收包线程直接在环上拆帧交给 SimpleRpcChannel::OnMessage；处理完先忙轮询 busy_poll_us 微秒，
+      仍然没有数据才置睡眠标志、poll 自己的 eventfd（同时驱动超时检查）
+    - 握手 socket 挂断即服务端已退出：之后的调用不再发出，在超时后失败；不会自动重连
+  CallMethod 线程安全；Connect 只能调用一次
+*/
+class ShmRpcChannel : public google::protobuf::RpcChannel {
+public:
+    static constexpr int kHandshakeTimeoutMs = 1000;
+
+    explicit ShmRpcChannel(size_t max_pending = PendingCallTable::kDefaultCapacity);
+    ~ShmRpcChannel() override;
+
+    ShmRpcChannel(const ShmRpcChannel&) = delete;
+    ShmRpcChannel& operator=(const ShmRpcChannel&) = delete;
+
+    // 阻塞完成握手；失败返回 false 并填写 error
+    bool Connect(const std::string& path, std::string* error);
+    // 停止收包线程（析构时自动调用）；未完成的调用不再有响应，按超时失败
+    void Close();
+
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+
+    void CallMethod(const google::protobuf::MethodDescriptor* method,
+                    google::protobuf::RpcController* controller,
+                    const google::protobuf::Message* request,
+                    google::protobuf::Message* response,
+                    google::protobuf::Closure* done) override;
+
+    // 超时、未完成调用数等设置直接作用在内部 channel 上
+    SimpleRpcChannel& channel() { return channel_; }
+    // 空闲前的忙轮询时长（微秒），0 表示处理完立即睡眠，默认见 ShmEndpoint::DefaultBusyPollMicros；需在 Connect 之前调用
+    void SetBusyPollMicros(int micros) { busy_poll_us_ = micros; }
+
+private:
+    void Write(const std::string& data);
+    void ReadLoop();
+    bool ReadFrames();
+
+    SimpleRpcChannel channel_;
+    FramingType framing_ = FramingType::Fixed32;
+    int busy_poll_us_;
+
+    int sock_ = -1;
+    int my_efd_ = -1;     // 客户端 eventfd：服务端看到我们在睡时写它；Close 也用它唤醒收包线程
+    int peer_efd_ = -1;
+    std::unique_ptr<ShmSegment> segment_;
+    std::unique_ptr<ShmEndpoint> endpoint_;
+
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> stop_{false};
+    std::thread reader_;
+};
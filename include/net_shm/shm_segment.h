@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*同机共享内存传输的内存布局：每个连接一个 memfd，
+    [0, 4096)                控制页 ShmControl（两个环的读写位置 + 两端的睡眠标志）
+    [4096, 4096 + cap)       环 0：客户端 -> 服务端
+    [4096 + cap, 4096 + 2cap) 环 1：服务端 -> 客户端
+  每个环的数据区被连续映射两次（镜像映射）：任意位置开始的 cap 字节在虚拟地址上都是连续的，
+  环里跑的就是和 socket 上完全相同的“帧前缀 + 帧”字节流，拆帧、编码都不需要处理回绕
+*/
+
+// 一个方向的 SPSC 字节环：tail 只由生产者写，head 只由消费者写，各占一个 cache line 避免伪共享
+struct ShmRingControl {
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint64_t> head;
+};
+
+enum ShmSide : int {
+    kShmServer = 0,
+    kShmClient = 1,
+};
+
+struct ShmControl {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    ShmRingControl rings[2];                    // 下标即生产者一侧：rings[kShmClient] 是客户端 -> 服务端
+    alignas(64) std::atomic<uint32_t> waiting[2];   // 该侧已经（或正准备）睡眠，对端有进展时需要写它的 eventfd
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory rings need lock-free 64-bit atomics");
+static_assert(sizeof(ShmControl) <= 4096, "ShmControl must fit in the control page");
+
+// 握手：服务端通过 Unix 域 socket 发一条 ShmHello，附带 [memfd, 服务端 eventfd, 客户端 eventfd] 三个 fd
+struct ShmHello {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t framing;     // FramingType，客户端必须用同一格式
+    uint32_t reserved;
+    uint64_t capacity;
+};
+
+class ShmSegment {
+public:
+    static constexpr uint32_t kMagic = 0x53484d52;   // "SHMR"
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kControlSize = 4096;
+    static constexpr size_t kDefaultCapacity = 1 << 20;
+
+    ~ShmSegment();
+
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+
+    // 服务端：新建一个 memfd 并初始化控制页；capacity 会向上取整到 2 的幂（至少一页）。失败返回 nullptr
+    static std::unique_ptr<ShmSegment> Create(size_t capacity, std::string* error);
+    // 客户端：映射握手收到的 memfd（接管 fd 的所有权），校验魔数、版本和大小。失败返回 nullptr
+    static std::unique_ptr<ShmSegment> Attach(int fd, std::string* error);
+
+    int fd() const { return fd_; }
+    size_t capacity() const { return capacity_; }
+    ShmControl* control() const { return control_; }
+    // 生产者一侧为 producer 的环的数据区（镜像映射，长度 2 * capacity 可读写）
+    char* data(ShmSide producer) const { return data_[producer]; }
+
+private:
+    ShmSegment() = default;
+    bool Map(size_t capacity, std::string* error);
+
+    int fd_ = -1;
+    size_t capacity_ = 0;
+    ShmControl* control_ = nullptr;
+    char* data_[2] = {nullptr, nullptr};
+};
+
+namespace shm {
+
+// 通过 Unix 域 socket 发送 / 接收 ShmHello 与附带的 fd（SCM_RIGHTS）；成功返回 true
+bool SendHello(int sock, const ShmHello& hello, const int* fds, int nfds);
+// 阻塞等待最多 timeout_ms；收到的 fd 个数不是 nfds 时全部关闭并返回 false
+bool RecvHello(int sock, ShmHello* hello, int* fds, int nfds, int timeout_ms);
+
+} // namespace shm
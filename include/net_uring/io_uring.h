@@ -0,0 +1,122 @@
+#pragma once
+#include <linux/io_uring.h>
+#include <cstddef>
+#include <cstdint>
+
+/*不依赖 liburing 的最小 io_uring 封装（只直接用 io_uring_setup / io_uring_enter / io_uring_register 三个系统调用）
+    - 只在一个线程里使用（创建、提交、收割都在同一个 IO 线程）
+    - 尽量打开 SINGLE_ISSUER | DEFER_TASKRUN：完成事件只在本线程 io_uring_enter 时处理，
+      不会被内核随时打断插入 task work；内核不支持时退化为 COOP_TASKRUN。使用方（UringNetworkServer）要求 Linux 6.0+
+    - GetSqe 只在本地推进 SQ 尾指针，SubmitAndWait 一次性发布并进入内核：
+      一轮事件循环里准备的所有 SQE（recv 重新挂起、send、accept ...）只需要一次 io_uring_enter
+*/
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // entries: SQ 大小（会被内核向上取 2 的幂），CQ 为其 4 倍；成功返回 0，失败返回 -errno
+    int Init(unsigned entries);
+    void Close();
+
+    int fd() const { return fd_; }
+
+    // 取一个空闲 SQE（已清零）；SQ 满时先把已准备的提交给内核
+    io_uring_sqe* GetSqe();
+
+    // SQ 中还能再准备的 SQE 个数
+    unsigned SqSpaceLeft() const {
+        return sq_entries_ - (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE));
+    }
+
+    // 提交所有已准备的 SQE，并等待至少 wait_nr 个完成事件；返回提交数或 -errno
+    int SubmitAndWait(unsigned wait_nr);
+
+    // 依次处理所有已就绪的 CQE，最后只更新一次 CQ 头指针；返回处理的个数
+    template <typename F>
+    unsigned ForEachCqe(F&& f) {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned n = 0;
+        for (; head != tail; ++head, ++n) {
+            f(&cqes_[head & cq_mask_]);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return n;
+    }
+
+    // 注册一个 provided buffer ring（内核 5.19+）；返回 0 或 -errno
+    int RegisterBufRing(io_uring_buf_ring* ring, unsigned entries, uint16_t bgid);
+    int UnregisterBufRing(uint16_t bgid);
+
+    // 通过 IORING_REGISTER_PROBE 查询内核是否支持某个操作码（需在 Init 成功之后调用）
+    bool SupportsOp(uint8_t opcode) const;
+    // 运行中的内核版本不低于 major.minor（操作码标志位一类的能力 probe 查不到，只能看版本）
+    static bool KernelAtLeast(int major, int minor);
+
+    uint64_t enter_calls() const { return enter_calls_; }
+
+private:
+    int Enter(unsigned to_submit, unsigned wait_nr, unsigned flags);
+
+    int fd_ = -1;
+    unsigned setup_flags_ = 0;
+
+    // SQ
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned sqe_tail_ = 0;       // 本地已准备到的位置，SubmitAndWait 时才发布给内核
+
+    // CQ
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;     // 内核支持 SINGLE_MMAP 时与 sq_ring_ 相同
+    size_t cq_ring_size_ = 0;
+    size_t sqes_size_ = 0;
+
+    uint64_t enter_calls_ = 0;
+};
+
+/*provided buffer ring：一组固定大小的接收缓冲区交给内核，multishot recv 每次就绪时由内核挑一个填入，
+  CQE 里带回缓冲区编号；用户处理完后 Recycle 归还。连接不再各自预留接收内存，空闲连接不占缓冲区
+*/
+class ProvidedBuffers {
+public:
+    ProvidedBuffers() = default;
+    ~ProvidedBuffers();
+
+    ProvidedBuffers(const ProvidedBuffers&) = delete;
+    ProvidedBuffers& operator=(const ProvidedBuffers&) = delete;
+
+    // count 必须是 2 的幂；成功返回 0，失败返回 -errno
+    int Init(IoUring* ring, unsigned count, unsigned buffer_size, uint16_t bgid);
+    // 在关闭 ring 之前调用：注销之后内核不会再往这些缓冲区写数据
+    void Unregister();
+
+    uint16_t group() const { return bgid_; }
+    char* Buffer(uint16_t bid) { return data_ + static_cast<size_t>(bid) * buffer_size_; }
+    // 归还一个缓冲区（立即对内核可见）
+    void Recycle(uint16_t bid);
+
+private:
+    IoUring* ring_ = nullptr;
+    io_uring_buf_ring* br_ = nullptr;
+    size_t br_size_ = 0;
+    char* data_ = nullptr;
+    unsigned count_ = 0;
+    unsigned buffer_size_ = 0;
+    uint16_t bgid_ = 0;
+    uint16_t tail_ = 0;
+    bool registered_ = false;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include "net/network_server.h"
+#include "net/framing.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*io_uring 后端（需要 Linux 6.0+：multishot recv；6.1+ 效果最好），与 epoll 后端同样的线程模型：
+  每个 IO 线程一个 ring + 一个 SO_REUSEPORT 监听 socket，连接从建立到关闭只在一个线程里处理
+    - 接受连接：每个监听 socket 挂一个 multishot accept，一次提交持续产生新连接
+    - 接收：每个连接挂一个 multishot recv，缓冲区来自本线程的 provided buffer ring（见 net_uring/io_uring.h），
+      完整帧直接在内核填好的缓冲区上拆出交给 MessageHandler，只有半包才拷贝进连接自己的缓冲区
+    - 发送：一轮循环里对同一连接的多次 Send 在循环末尾一起提交为一串 IOSQE_IO_LINK 链接的 send，保证顺序；
+      开启写合并时小响应先拼成一个 send
+    - 每轮循环：准备好的所有 SQE 一次 io_uring_enter 提交并同时等待完成事件，然后批量收割 CQE；
+      负载高时一次系统调用处理几十上百个请求
+    - 跨线程（worker 线程发送响应、Stop）通过 eventfd 唤醒：ring 上常驻一个读 eventfd 的请求
+    - 可同时监听一个 Unix 域 socket（SetUnixSocket）：第 0 个 IO 线程的 ring 上挂一个 multishot accept，
+      接受的连接轮流投递给各 IO 线程
+  内核不支持 io_uring 或所需特性时 Run() 抛出 std::runtime_error
+*/
+class UringNetworkServer : public INetworkServer {
+public:
+    UringNetworkServer(int port, int io_threads = 4);
+    ~UringNetworkServer() override;
+
+    void Run() override;
+    void Stop() override;
+    void SetMessageHandler(std::shared_ptr<MessageHandler> handler) override;
+
+    // 写合并上限，语义同 MuduoNetworkServer::SetWriteCoalescing；需在 Run() 之前调用
+    void SetWriteCoalescing(size_t max_pending_bytes);
+    // 帧前缀格式（见 net/framing.h）；需在 Run() 之前调用
+    void SetFraming(FramingType framing);
+
+    // 在 TCP 端口之外再监听一个 Unix 域 socket 路径（Run() 时创建，退出时删除）；需在 Run() 之前调用
+    void SetUnixSocket(const std::string& path);
+
+    // 实际监听的端口（构造时 port 为 0 则由内核分配），Run() 开始监听之后有效
+    int port() const { return bound_port_.load(std::memory_order_acquire); }
+
+private:
+    class Connection;
+    struct IoThread;
+
+    void RunIoThread(IoThread* t);
+
+    int port_;
+    int io_threads_;
+    std::shared_ptr<MessageHandler> handler_;
+    size_t coalesce_max_bytes_ = 0;   // 写合并上限，0 表示关闭
+    FramingType framing_ = FramingType::Fixed32;
+    std::string unix_path_;           // 为空表示不监听 Unix 域 socket
+    int unix_listen_fd_ = -1;         // 只由第 0 个 IO 线程 accept
+    size_t next_unix_thread_ = 0;     // 下一个 Unix 域连接交给哪个 IO 线程，只在第 0 个 IO 线程访问
+
+    std::mutex mutex_;                // 保护 threads_ 的创建与 Stop 之间的竞争
+    std::vector<std::unique_ptr<IoThread>> threads_;
+    bool stopping_ = false;
+    std::string init_error_;          // 某个 IO 线程初始化 ring 失败的原因，Run() 据此抛异常
+    std::atomic<int> bound_port_{0};
+};
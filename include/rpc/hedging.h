@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*一个方法的延迟分布（对冲用来估计 pN）：对数分桶的直方图
+    每个 2 的幂区间再分 kSubBuckets 档，分位数的相对误差不超过 1/kSubBuckets；计数器都是原子的，任意线程并发 Record
+    每 kDecayEvery 个样本把所有计数减半：旧样本按指数衰减，分布能跟上服务端的变化。
+    减半与并发的 Record 之间不加锁，可能丢掉个别样本，对分位数估计没有影响
+*/
+class LatencyHistogram {
+public:
+    static constexpr int kSubBuckets = 4;
+    static constexpr int kMaxExponent = 33;              // 超过 2^33 微秒（约 2.4 小时）的样本计入最后一档
+    static constexpr int kBuckets = (kMaxExponent - 1) * kSubBuckets + kSubBuckets;
+    static constexpr uint64_t kDecayEvery = 4096;
+    static constexpr uint64_t kMinSamples = 100;         // 样本少于这个数时不给出估计
+
+    void Record(int64_t latency_us);
+    // 分位数 q（0~1）所在分桶的上界（微秒）；样本不足时返回 -1
+    int64_t Quantile(double q) const;
+
+private:
+    static int BucketOf(int64_t latency_us);
+    static int64_t UpperBound(int bucket);
+
+    std::atomic<uint64_t> counts_[kBuckets] = {};
+    std::atomic<uint64_t> records_{0};
+};
+
+/*重试 / 对冲预算：按流量比例积攒令牌的令牌桶
+    每个原始调用存入 ratio 个令牌（最多攒 max_tokens 个），每次重试或对冲取走一个，取不到就不发。
+    额外发出的请求因此不超过原始流量的 ratio（外加 max_tokens 的突发）：
+    下游过载、调用普遍变慢时，对冲和重试不会反过来把负载放大。无锁，任意线程并发调用
+*/
+class RetryBudget {
+public:
+    RetryBudget(double ratio, double max_tokens);
+
+    void Deposit();
+    bool TryWithdraw();
+    double tokens() const { return static_cast<double>(tokens_.load(std::memory_order_relaxed)) / kScale; }
+
+private:
+    static constexpr int64_t kScale = 1000;              // 令牌按千分之一计，整数原子操作即可
+
+    const int64_t deposit_;
+    const int64_t max_;
+    std::atomic<int64_t> tokens_{0};
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class LoadBalancePolicy {
+    PowerOfTwoChoices,  // 随机取两个后端，选代价（延迟 EWMA × 在途数）低的那个
+    LeastOutstanding,   // 在途调用最少的后端
+    RoundRobin,         // 轮转，不看负载（对照用）
+    ConsistentHash,     // 带路由键的调用按有界负载一致性哈希选后端（见 ConsistentHashRouter），没有键的按 P2C
+};
+
+/*一个后端（endpoint）的负载统计：在途调用数、延迟 EWMA、上线时间
+  调用线程在发起 / 完成调用时更新，选择时无锁读取
+    - 延迟用 peak EWMA：样本高于当前值时直接取样本（变慢立即可见），低于时按时间指数衰减（默认时间常数 10s）
+    - 失败的调用按 max(耗时, 2 × 当前 EWMA) 计入：快速失败的后端（连接被拒、服务端报错）不会因为“响应快”吸走流量
+    - 上线（第一条连接建立）后的 slow_start 窗口内权重从 kMinSlowStartWeight 线性升到 1，
+      选择代价除以权重：新加入或刚重启的后端逐步接流量，不会因为还没有延迟样本或样本偏乐观被一下子压垮
+    - 服务端开启负载报告（RpcServerFactory::WithLoadReports）时，最近 kLoadReportTtlUs 内收到的报告参与计算：
+      并发数取本客户端在途数与服务端报告的 在途 + 排队 中较大者（看得到其它客户端压上去的负载），
+      权重再乘以 CPU 余量（1 - 利用率，下限 kMinCpuHeadroom）；报告过期后退回只看本地统计
+*/
+class EndpointStats {
+public:
+    static constexpr int64_t kDefaultDecayUs = 10 * 1000 * 1000;
+    static constexpr double kMinSlowStartWeight = 0.1;
+    // 还没有延迟样本时按这个值估算代价（微秒），在途数再乘上去：没有样本的后端同一时刻只接少量探测调用
+    static constexpr double kUnknownLatencyUs = 100 * 1000;
+    static constexpr int64_t kLoadReportTtlUs = 1000 * 1000;
+    static constexpr double kMinCpuHeadroom = 0.1;
+
+    explicit EndpointStats(std::string address) : address_(std::move(address)) {}
+
+    const std::string& address() const { return address_; }
+
+    void OnCallStart() { in_flight_.fetch_add(1, std::memory_order_relaxed); }
+    void OnCallFinish(int64_t latency_us, bool failed, int64_t now_us);
+    // 调用被主动放弃（对冲输掉后取消）：只减在途数，不计入延迟和失败
+    void OnCallCanceled() { in_flight_.fetch_sub(1, std::memory_order_relaxed); }
+
+    // 连接建立 / 断开时调用，用于判断是否可用以及 slow-start 的起点
+    void OnConnectionUp(int64_t now_us);
+    void OnConnectionDown();
+
+    // 收到服务端负载报告时调用（在连接的 IO 线程里）
+    void OnLoadReport(uint32_t queue_depth, uint32_t in_flight, uint32_t cpu_permille, int64_t now_us);
+
+    bool available() const { return up_connections_.load(std::memory_order_acquire) > 0; }
+    size_t in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+    // 没有样本时返回 0
+    double latency_ewma_us() const { return ewma_us_.load(std::memory_order_relaxed); }
+    // 选择时使用的并发数：本地在途数，或新鲜的服务端报告里的 在途 + 排队（取较大者）
+    double Concurrency(int64_t now_us) const;
+    // slow-start 权重 × CPU 余量，(0, 1]
+    double Weight(int64_t now_us, int64_t slow_start_us) const;
+    // P2C 的比较代价：越小越好
+    double Cost(int64_t now_us, int64_t slow_start_us) const;
+
+private:
+    const std::string address_;
+    std::atomic<size_t> in_flight_{0};
+    std::atomic<int> up_connections_{0};
+    std::atomic<int64_t> up_since_us_{0};
+
+    // 最近一次服务端负载报告；report_us_ 为 0 表示还没收到过
+    std::atomic<uint32_t> report_load_{0};          // 在途 + 排队
+    std::atomic<uint32_t> report_cpu_permille_{0};
+    std::atomic<int64_t> report_us_{0};
+
+    std::mutex ewma_mutex_;                 // 串行化 EWMA 更新（在各连接的 IO 线程里）
+    std::atomic<double> ewma_us_{0};
+    int64_t ewma_stamp_us_ = 0;             // 上次更新的时间，受 ewma_mutex_ 保护
+};
+
+/*选择后端的策略：RpcClient 每次调用先用它选出后端，再在该后端的连接里选在途最少的一条
+  Pick 在任意调用线程并发调用，实现需线程安全；candidates 非空，且都有已建立的连接
+*/
+class LoadBalancer {
+public:
+    virtual ~LoadBalancer() = default;
+    // 返回 candidates 中的下标
+    virtual size_t Pick(const std::vector<EndpointStats*>& candidates, int64_t now_us) = 0;
+};
+
+/*有界负载的一致性哈希（Maglev 查找表）：同一个路由键总是落在同一个后端上，后端的本地缓存才有命中率
+    - 查找表按 endpoint 地址构建，与添加顺序无关：endpoint 列表相同的各个客户端进程把同一个键路由到同一个后端
+    - 每个键有一个确定的探测序列（键哈希反复混合后各查一次表），取第一个可用且未超出负载上限的后端：
+      后端下线时只有原本落在它上面的键改道，且均匀分散到其余后端；它恢复后这些键回到原处
+    - 负载上限：在途数 + 1 不超过 ceil(load_factor × (全部在途数 + 1) / 可用后端数)。热点键溢出到序列里的下一个后端，
+      不会把一个副本压垮；load_factor 越大越看重缓存亲和性，<= 0 表示不设上限
+  表在构造后只读，Pick 在任意调用线程无锁并发调用
+*/
+class ConsistentHashRouter {
+public:
+    static constexpr size_t kTableSize = 65537;          // 质数，远大于后端数时各后端分到的表项近乎相等
+    static constexpr double kDefaultLoadFactor = 1.5;
+    static constexpr int kMaxProbes = 16;
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    ConsistentHashRouter(std::vector<EndpointStats*> endpoints, double load_factor);
+
+    // 返回构造时 endpoints 中的下标；没有可用后端时返回 kNone
+    size_t Pick(uint64_t key_hash) const;
+
+private:
+    std::vector<EndpointStats*> endpoints_;
+    double load_factor_;
+    std::vector<uint32_t> table_;                       // 表项 -> endpoints_ 下标
+};
+
+// 路由键的哈希：与平台、进程无关（FNV-1a + 混合），不同客户端进程对同一个键得到同一个值
+uint64_t HashRoutingKey(std::string_view key);
+
+// 按策略创建；slow_start_us 为 slow-start 窗口（<=0 关闭）
+std::unique_ptr<LoadBalancer> NewLoadBalancer(LoadBalancePolicy policy, int64_t slow_start_us);
+
+// 读取 endpoint 列表文件：每行一个 "host:port" 或 "unix:/path"，忽略空行和 # 开头的注释；文件无法读取时抛出 std::runtime_error
+std::vector<std::string> ReadEndpointsFile(const std::string& path);
@@ -0,0 +1,66 @@
+#pragma once
+#include <google/protobuf/service.h>
+#include <memory>
+#include <mutex>
+
+#include "rpc/rpc_channel.h"
+#include "rpc/rpc_dispatcher.h"
+
+class RpcServer;
+
+/*进程内 channel：直接绑定到 RpcDispatcher（或 RpcServer 的 dispatcher），不经过 socket
+  用于测试、基准，以及和服务部署在同一个二进制里的模块——调用方代码与走网络时完全相同（同一个 Stub）
+    - Direct（默认）：把调用方的 request / response / controller 原样交给业务方法，没有任何拷贝和序列化；
+      业务方法拿到的就是调用方的对象：request 与调用方共享，response 的中间状态调用方也看得到
+    - Copy：请求先 CopyFrom 到服务端自己的对象，完成时把服务端的 response CopyFrom 回调用方，错误文本拷回调用方 controller；
+      业务方法保存 request 指针、done 之后还写 response 之类的问题在这里与走网络时一样被隔离
+    - Codec：经过完整的编解码往返（握手、方法编号、定长头、帧前缀，与 SimpleRpcChannel + 网络后端完全相同，
+      只是把“网络”换成函数调用），用来在单元测试里验证编码，也是衡量框架开销的对照组
+  三种模式的完成语义都与网络调用相同：业务方法调用 done->Run() 时（可以在任意线程、任意时刻）才完成调用方的 done。
+  调用在调用线程里直接执行业务方法（相当于 worker 线程数为 0），dispatcher 配置的 worker 线程池只对 Codec 模式生效；
+  没有超时：业务方法不调用 done，调用方的 done 就永远不会执行
+  线程安全；必须在所有服务注册之后才发起调用
+*/
+class LocalRpcChannel : public google::protobuf::RpcChannel {
+public:
+    enum class Mode {
+        Direct,
+        Copy,
+        Codec,
+    };
+
+    explicit LocalRpcChannel(std::shared_ptr<RpcDispatcher> dispatcher, Mode mode = Mode::Direct);
+    explicit LocalRpcChannel(RpcServer* server, Mode mode = Mode::Direct);
+    ~LocalRpcChannel() override;
+
+    LocalRpcChannel(const LocalRpcChannel&) = delete;
+    LocalRpcChannel& operator=(const LocalRpcChannel&) = delete;
+
+    void CallMethod(const google::protobuf::MethodDescriptor* method,
+                    google::protobuf::RpcController* controller,
+                    const google::protobuf::Message* request,
+                    google::protobuf::Message* response,
+                    google::protobuf::Closure* done) override;
+
+    Mode mode() const { return mode_; }
+
+private:
+    class LoopbackConnection;
+    struct CopyCall;
+
+    void CallCopy(const MethodEntry* entry,
+                  google::protobuf::RpcController* controller,
+                  const google::protobuf::Message* request,
+                  google::protobuf::Message* response,
+                  google::protobuf::Closure* done);
+    static void OnCopyDone(CopyCall* call);
+    void SendToDispatcher(const std::string& data);
+
+    std::shared_ptr<RpcDispatcher> dispatcher_;
+    Mode mode_;
+
+    // Codec 模式：请求经 codec_channel_ 编码后交给 dispatcher，响应经 loopback_ 回到 codec_channel_
+    std::unique_ptr<SimpleRpcChannel> codec_channel_;
+    std::shared_ptr<LoopbackConnection> loopback_;
+    std::once_flag handshake_once_;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <google/protobuf/service.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/descriptor.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 一个 (service, method) 的分发信息：注册时一次性解析好，请求路径上不再查描述符、不再访问 MessageFactory
+struct MethodEntry {
+    google::protobuf::Service* service = nullptr;
+    const google::protobuf::MethodDescriptor* method = nullptr;
+    const google::protobuf::Message* request_prototype = nullptr;   // New() 出请求对象
+    const google::protobuf::Message* response_prototype = nullptr;  // New() 出响应对象
+    std::string service_name;   // 如 "order.OrderService"
+    std::string method_name;    // 如 "GetOrder"
+    uint64_t hash = 0;          // HashName(service_name, method_name)
+    uint32_t method_id = 0;     // 方法编号（entries_ 下标 + 1），握手后客户端只发送它
+};
+
+/*冻结的方法分发表
+    - AddService 在注册阶段把服务的每个方法展开成一个 MethodEntry，并重建开放寻址索引（桶数 >= 2 * 方法数）
+    - Find 对 "service.method" 做一次 FNV-1a 哈希后线性探测，通常一次探测命中；
+      不拼接字符串、不分配内存、不碰 DescriptorPool 的锁
+  只在服务启动前注册，启动后只读，因此查找不需要加锁
+*/
+class MethodTable {
+public:
+    // 注册服务的全部方法；服务已注册时返回 false
+    bool AddService(google::protobuf::Service* service);
+
+    const MethodEntry* Find(std::string_view service_name, std::string_view method_name) const;
+
+    // 按握手协商出的方法编号查找：直接数组下标访问
+    const MethodEntry* FindById(uint32_t method_id) const {
+        if (method_id == 0 || method_id > entries_.size()) return nullptr;
+        return &entries_[method_id - 1];
+    }
+
+    const std::vector<MethodEntry>& entries() const { return entries_; }
+
+    // 是否注册过该服务（只在查找失败、需要区分“未知服务/未知方法”时使用）
+    bool HasService(std::string_view service_name) const;
+
+    size_t size() const { return entries_.size(); }
+
+    // 按 "service.method" 计算的哈希，不需要真的拼接
+    static uint64_t HashName(std::string_view service_name, std::string_view method_name);
+
+private:
+    void RebuildIndex();
+
+    std::vector<MethodEntry> entries_;
+    std::vector<int32_t> buckets_;   // 存 entries_ 下标，-1 表示空桶
+    size_t bucket_mask_ = 0;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <google/protobuf/service.h>
+#include <google/protobuf/message.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// 客户端一次尚未完成的调用
+struct PendingCall {
+    google::protobuf::Message* response = nullptr;         // 由调用方分配，RpcChannel 只负责填充
+    google::protobuf::Closure* done = nullptr;             // 完成后调用 done->Run()
+    google::protobuf::RpcController* controller = nullptr; // 可选，用于设置错误
+};
+
+/*无锁、定容的 pending call 表（替代 mutex + unordered_map）
+    request_id 由原子计数器生成：低 kIndexBits 位是槽下标，高位是“代数”（计数器每绕槽数组一圈加一）
+      request_id = seq，slot = seq & mask，generation = seq >> index_bits
+    - Insert：fetch_add 取一个 seq，CAS 槽状态 kFree -> kBusy，写入调用信息后发布 state = request_id；
+              槽仍被上一圈的调用占用时换下一个 seq 重试（槽满才会失败）
+    - Take：CAS 槽状态 request_id -> kBusy，读出调用信息后把槽置回 kFree；
+            过期/重复/未知的 request_id 由于代数不同 CAS 必然失败，
+            响应与超时并发时也只有一方能取走这次调用
+  整个过程没有锁，也没有每次调用的内存分配；每个槽独占一条 cache line，避免相邻 request_id 的伪共享
+*/
+class PendingCallTable {
+public:
+    // capacity 会向上取整为 2 的幂
+    explicit PendingCallTable(size_t capacity = kDefaultCapacity);
+
+    // 登记一次调用，成功时通过 request_id 返回分配的 id；表满时返回 false
+    bool Insert(const PendingCall& call, uint64_t* request_id);
+
+    // 取走并移除 request_id 对应的调用；不存在（已完成、已超时、未知 id）时返回 false
+    bool Take(uint64_t request_id, PendingCall* call);
+
+    // 取走当前所有已登记的调用（连接断开时用）；正在登记中的调用不会被取走，它们只能等超时
+    void TakeAll(std::vector<PendingCall>* calls);
+
+    size_t capacity() const { return mask_ + 1; }
+    // 当前未完成的调用数（近似值，供负载均衡等参考）
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t kDefaultCapacity = 4096;
+
+private:
+    static constexpr uint64_t kFree = 0;
+    static constexpr uint64_t kBusy = 1;   // 正在写入或读出；真实 request_id >= 槽数，不会与之冲突
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> state{kFree};
+        PendingCall call;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> next_seq_;
+    alignas(64) std::atomic<size_t> size_{0};
+};
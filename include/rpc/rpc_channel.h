@@ -3,19 +3,34 @@
 #include <google/protobuf/service.h>
 #include <google/protobuf/message.h>
 #include <functional>
-#include <unordered_map>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "rpc_meta.pb.h"
+#include "rpc/timer_wheel.h"
+#include "rpc/pending_call_table.h"
+#include "rpc/mpmc_queue.h"
+#include "rpc/rpc_controller.h"
+#include "net/framing.h"
 
-/*客户端使用*/
+/*客户端使用
+    线程安全：任意多个应用线程可以同时 CallMethod，网络线程同时 OnMessage，
+    调用/响应路径上没有锁（见 PendingCallTable），也没有每次调用的内存分配
+*/
 class SimpleRpcChannel : public google::protobuf::RpcChannel {
 public:
     using SendFunction = std::function<void(const std::string&)>;
+    using LoadReportCallback = std::function<void(const rpc::LoadReport&)>;
 
-    explicit SimpleRpcChannel(SendFunction send);
+    // max_pending: 同时未完成调用数的上限（PendingCallTable 的槽数），超过时 CallMethod 直接失败
+    explicit SimpleRpcChannel(SendFunction send,
+                              size_t max_pending = PendingCallTable::kDefaultCapacity);
 
     // protobuf Stub 调用时会走到这里
     void CallMethod(const google::protobuf::MethodDescriptor* method,
@@ -24,20 +39,98 @@ public:
                     google::protobuf::Message* response,
                     google::protobuf::Closure* done) override;
 
-    // 由网络层在收到“响应帧”时调用
-    void OnMessage(const std::string& frame);
+    /*同 CallMethod，但返回这次发送的 request_id（可传给 Cancel）；立即失败（done 已经执行）时返回 0。
+      每次发送在 pending_calls_ 里各占一项：同一个逻辑调用要发多份（对冲、重试）时，每份用各自的 response / controller / done*/
+    uint64_t StartCall(const google::protobuf::MethodDescriptor* method,
+                       google::protobuf::RpcController* controller,
+                       const google::protobuf::Message* request,
+                       google::protobuf::Message* response,
+                       google::protobuf::Closure* done);
+    // 放弃等待 request_id 的响应：调用以 "RPC canceled" 失败完成（在当前线程执行 done），之后到达的响应被丢弃；
+    // 请求可能已经在服务端执行。调用已完成时返回 false
+    bool Cancel(uint64_t request_id);
+
+    // 由网络层在收到“响应帧”时调用（frame 只在调用期间有效）
+    void OnMessage(std::string_view frame);
+
+    // 发出请求时使用的帧前缀格式，必须与服务端监听配置一致（默认 Fixed32）；
+    // 收到的数据请用同一格式的 BasicFrameCodec 拆帧。需在发起调用前设置
+    void SetFraming(FramingType framing);
+
+    /*超时控制：
+        每次调用的超时取 SimpleRpcController::TimeoutMs()，为 0（或 controller 不是 SimpleRpcController）时用 default_timeout_ms_；
+        <= 0 表示永不超时。
+        到期检查由使用方的事件循环驱动：定期（建议 kTimerTickMs 一次）调用 ExpireTimeouts()，
+        到期的调用以 "RPC timeout" 失败完成，并从 pending_calls_ 中移除；之后才到达的响应会被当作未知 request_id 丢弃。
+        调用方线程只把 (request_id, deadline) 无锁地放进 timer_queue_，由 ExpireTimeouts 所在线程搬进时间轮
+    */
+    void SetDefaultTimeout(int64_t timeout_ms);
+    void ExpireTimeouts();
+
+    // 连接断开时调用：所有未完成的调用立即以 reason 失败，而不是等到超时
+    void FailPending(const std::string& reason);
+
+    static constexpr int64_t kTimerTickMs = 10;
+    static constexpr int64_t kHandshakeTimeoutMs = 500;
+
+    // 当前未完成的调用数
+    size_t PendingCount() const { return pending_calls_.size(); }
+
+    /*方法编号握手（每个连接一次）：
+        连接建立后调用 StartHandshake()，服务端返回方法编号表后，对表中的方法只发送 method_id，
+        不再携带服务名/方法名；握手完成前、或对端不支持握手时，继续按名字发送。
+        不认识握手的旧服务端对未知服务不回复，握手因此最多只等 kHandshakeTimeoutMs（不超过默认超时），超时后按名字发送，
+        期间的调用不受影响（本来就按名字发送）。
+        对端在握手响应中声明支持定长头格式（binary_version）时，之后的请求改用定长头格式（见 rpc_codec.h）。
+        连接断开后应调用 ResetHandshake()：重连的对端可能是另一个进程，编号不一定相同。
+    */
+    void StartHandshake();
+    void ResetHandshake();
+
+    // 响应里带有服务端负载报告（见 RpcDispatcher::SetLoadReportSampling）时，在 OnMessage 所在线程、
+    // 对应调用的 done 之前回调 cb。需在发起调用前设置
+    void SetLoadReportCallback(LoadReportCallback cb);
 
 private:
-    struct PendingCall {
-        google::protobuf::Message* response;   // 由调用方分配，RpcChannel 只负责填充
-        google::protobuf::Closure* done;       // 完成后调用 done->Run()
-        google::protobuf::RpcController* controller; // 可选，用于设置错误
+    using MethodIdMap = std::unordered_map<const google::protobuf::MethodDescriptor*, uint32_t>;
+
+    // 一次待登记到时间轮的超时
+    struct TimerEntry {
+        uint64_t request_id;
+        int64_t deadline_ms;
     };
 
-    uint64_t NextRequestId();
+    int64_t TimeoutFor(google::protobuf::RpcController* controller) const;
+    bool EncodeRequest(const google::protobuf::MethodDescriptor* method,
+                       uint64_t request_id,
+                       const google::protobuf::Message& request,
+                       std::string* out) const;
+    void AddTimer(uint64_t request_id, int64_t deadline_ms);
+    void OnHandshakeDone(uint64_t generation);
+    static int64_t NowMs();
+
+    PendingCallTable pending_calls_;          // 无锁：request_id 的生成、登记、取走都在这里
+    BoundedMpmcQueue<TimerEntry> timer_queue_;
+
+    std::mutex timer_mutex_;                  // 只保护时间轮：ExpireTimeouts 持有；调用方仅在 timer_queue_ 满时才会用到
+    TimerWheel timer_wheel_;
+    std::vector<uint64_t> expired_;           // ExpireTimeouts 的临时列表，复用容量
+
+    std::atomic<int64_t> default_timeout_ms_{5000};
+
+    // 协商出的方法编号表：发布后只读，CallMethod 无锁读取；为空表示按名字发送
+    std::atomic<const MethodIdMap*> method_ids_{nullptr};
+    std::atomic<bool> binary_{false};         // 对端支持定长头格式（握手成功后置位）
+    std::mutex handshake_mutex_;
+    // 发布过的编号表保留到 channel 析构，读者无需引用计数；内容相同的表复用，反复重连同一个服务端不会增长
+    std::vector<std::unique_ptr<MethodIdMap>> method_id_maps_;
+    std::atomic<bool> handshake_in_flight_{false};
+    std::atomic<uint64_t> handshake_generation_{0};   // ResetHandshake 时加一，之前发出的握手结果作废
+    std::atomic<uint64_t> handshake_request_id_{0};   // 在途握手的 request_id，ResetHandshake 据此取消
+    rpc::HandshakeResponse handshake_response_;
+    SimpleRpcController handshake_controller_;
 
-    std::mutex mutex_;
-    uint64_t next_id_ = 1;
-    std::unordered_map<uint64_t, PendingCall> pending_calls_;
+    FramingType framing_ = FramingType::Fixed32;
     SendFunction send_;
+    LoadReportCallback load_callback_;
 };
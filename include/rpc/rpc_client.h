@@ -0,0 +1,146 @@
+#pragma once
+#include <google/protobuf/service.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "net/framing.h"
+#include "rpc/hedging.h"
+#include "rpc/load_balancer.h"
+
+namespace muduo {
+namespace net {
+class EventLoop;
+class EventLoopThread;
+}
+}
+
+/*库级客户端：自带事件循环线程，连接一组服务端（endpoint），对外是一个线程安全的 RpcChannel
+    - 每个 endpoint 建 N 条连接（SetConnectionsPerEndpoint），每条连接一个 SimpleRpcChannel，
+      调用在连接上多路复用（按 request_id 配对），一条连接上可以同时有任意多个在途调用
+    - 连接轮流分到各事件循环线程：每个线程负责自己那些连接的收包、超时检查和重连，
+      多个线程、多条连接一起才能压满多核服务端（单条连接的收发只能用到服务端的一个 IO 线程）
+    - 选连接分两步：先按负载均衡策略（SetLoadBalancePolicy，默认 power-of-two-choices）在有可用连接的
+      endpoint 里选一个，再在它的连接里选未完成调用最少的一条。每个 endpoint 统计在途数和延迟 EWMA，
+      新上线（或重启后重新连上）的 endpoint 在 slow-start 窗口内逐步加流量；服务端开启负载报告
+      （RpcServerFactory::WithLoadReports）时，响应里捎带的排队数 / 在途数 / CPU 也计入，见 rpc/load_balancer.h
+    - ConsistentHash 策略：带路由键的调用（SimpleRpcController::SetRoutingKey，或 SetRoutingKeyExtractor 从请求里取）
+      按有界负载一致性哈希选 endpoint，同一个键固定发往同一个副本，服务端按键缓存时命中率不随副本数下降
+    - 按方法开启的对冲与重试（SetHedgePolicy），受全局预算限制，见下
+    - 断线：该连接上的未完成调用立即以 "Connection lost" 失败；后台重连（0.5s 起、翻倍到 30s），
+      重连后重新握手方法编号
+    - 没有任何可用连接时调用立即失败，不排队等连接
+  endpoint 格式："host:port" 或 "unix:/path"（服务端 WithUnixSocket 的路径）
+  AddEndpoint / Set* 需在 Start() 之前调用；CallMethod 线程安全，可在任意线程（包括 done 回调里）调用，
+  done 在连接所属的事件循环线程里执行
+*/
+class RpcClient : public google::protobuf::RpcChannel {
+public:
+    static constexpr int kDefaultConnectionsPerEndpoint = 2;
+    static constexpr int64_t kDefaultSlowStartMs = 10000;
+
+    explicit RpcClient(int io_threads = 1);
+    ~RpcClient() override;
+
+    RpcClient(const RpcClient&) = delete;
+    RpcClient& operator=(const RpcClient&) = delete;
+
+    void AddEndpoint(const std::string& endpoint);
+    // 从文件读取 endpoint 列表（格式见 ReadEndpointsFile），逐个 AddEndpoint；文件无法读取时抛出 std::runtime_error
+    void AddEndpointsFromFile(const std::string& path);
+    void SetConnectionsPerEndpoint(int n);
+    // 帧前缀格式，必须与服务端一致
+    void SetFraming(FramingType framing);
+    // 调用的默认超时（毫秒），语义同 SimpleRpcChannel::SetDefaultTimeout
+    void SetDefaultTimeout(int64_t timeout_ms);
+    void SetLoadBalancePolicy(LoadBalancePolicy policy);
+    // slow-start 窗口（毫秒），<=0 关闭
+    void SetSlowStart(int64_t ms);
+
+    /*路由键提取（ConsistentHash 策略）：controller 上没有设置路由键时，对请求调用 extractor，
+        返回 true 时 *key 即路由键；在调用线程里执行，需线程安全。RoutingKeyField 按字段名从请求里取（字符串或整数字段）*/
+    using RoutingKeyExtractor = std::function<bool(const google::protobuf::MethodDescriptor* method,
+                                                   const google::protobuf::Message& request,
+                                                   std::string* key)>;
+    void SetRoutingKeyExtractor(RoutingKeyExtractor extractor);
+    static RoutingKeyExtractor RoutingKeyField(const std::string& field_name);
+    // 一致性哈希的负载上限系数（见 ConsistentHashRouter），<= 0 表示只看路由键、不设上限
+    void SetHashLoadFactor(double factor);
+
+    /*对冲与重试（按方法开启；开启即表示该方法幂等，可以在多个副本上重复执行）：
+        - 对冲：发出后超过该方法最近的 pN 延迟（quantile）还没有响应，就向另一个 endpoint 再发一份，
+          先到的成功响应生效，其余的取消（SimpleRpcChannel::Cancel：响应到达后丢弃，服务端可能已经执行）
+        - 重试：一次发送因连接断开或没有可用连接而失败、且没有其它在途的发送时，换一个 endpoint 重发
+        - 对冲和重试各有一个全局预算（SetHedgeBudget / SetRetryBudget，占这些方法原始调用量的百分比，见 RetryBudget），
+          用完就不再额外发送：下游过载、调用普遍变慢时不会被放大
+        - 所有发送共用这次调用的超时（controller 上的或默认超时）；response 只由胜出的那次发送写入
+      延迟样本不足 LatencyHistogram::kMinSamples 时只重试、不对冲。没有开启的方法走原来的路径，没有额外开销
+    */
+    struct HedgePolicy {
+        double quantile = 0.95;   // 等到这个分位的延迟还没有响应就发对冲
+        int max_attempts = 2;     // 一次调用最多发送几次（含第一次、对冲和重试）
+    };
+    static constexpr double kDefaultHedgeBudgetPercent = 5;
+    static constexpr double kDefaultRetryBudgetPercent = 10;
+    static constexpr double kBudgetBurst = 10;             // 预算最多攒下的令牌数（允许的突发额外请求数）
+    // method_full_name 即 MethodDescriptor::full_name()，如 "demo.EchoService.Echo"。
+    // 以下三个需在 Start() 之前调用（CallMethod 无锁读取这些配置），之后调用抛出 std::runtime_error
+    void SetHedgePolicy(const std::string& method_full_name, const HedgePolicy& policy);
+    void SetHedgeBudget(double percent);
+    void SetRetryBudget(double percent);
+
+    // 启动事件循环线程并开始连接（不等待连接建立）；地址无法解析时抛出 std::runtime_error
+    void Start();
+    // 断开所有连接并停止线程，未完成的调用以 "Client stopped" 失败；析构时自动调用
+    void Stop();
+
+    // 阻塞等到至少 n 条连接建立或超时，返回当时的已连接数（启动后马上要发起调用的场景用）
+    size_t WaitForConnections(size_t n, int timeout_ms) const;
+    size_t ConnectedCount() const;
+
+    void CallMethod(const google::protobuf::MethodDescriptor* method,
+                    google::protobuf::RpcController* controller,
+                    const google::protobuf::Message* request,
+                    google::protobuf::Message* response,
+                    google::protobuf::Closure* done) override;
+
+private:
+    class Connection;
+    struct Endpoint;
+    struct IoThread;
+    struct MethodHedge;
+    class HedgedCall;
+
+    // exclude 非空时跳过其中的 endpoint（对冲 / 重试换副本）
+    Connection* PickConnection(const std::string* routing_key, Endpoint** endpoint,
+                               const std::vector<Endpoint*>* exclude = nullptr);
+    void CheckNotStarted(const char* setter);   // 需持有 mutex_
+
+    int io_threads_;
+    int conns_per_endpoint_ = kDefaultConnectionsPerEndpoint;
+    FramingType framing_ = FramingType::Fixed32;
+    int64_t default_timeout_ms_ = 5000;
+    LoadBalancePolicy policy_ = LoadBalancePolicy::PowerOfTwoChoices;
+    int64_t slow_start_ms_ = kDefaultSlowStartMs;
+    RoutingKeyExtractor key_extractor_;
+    double hash_load_factor_ = ConsistentHashRouter::kDefaultLoadFactor;
+    std::unordered_map<std::string, std::unique_ptr<MethodHedge>> hedged_methods_;   // Start 之后只读
+    std::unique_ptr<RetryBudget> hedge_budget_;
+    std::unique_ptr<RetryBudget> retry_budget_;
+    std::vector<std::string> addresses_;
+
+    std::mutex mutex_;                                 // 保护 Start / Stop
+    bool started_ = false;
+    std::vector<std::unique_ptr<IoThread>> threads_;
+    // 以下 Start 之后不再变化，选连接时无锁遍历
+    std::vector<std::unique_ptr<Endpoint>> endpoints_;
+    std::vector<std::unique_ptr<Connection>> conns_;
+    std::unique_ptr<LoadBalancer> balancer_;
+    std::unique_ptr<ConsistentHashRouter> router_;     // 仅 ConsistentHash 策略
+    std::atomic<size_t> next_{0};                      // 同一 endpoint 内选连接的轮转起点
+};
@@ -1,20 +1,139 @@
 #pragma once
 #include "rpc_meta.pb.h"
 #include <google/protobuf/message.h>
+#include "net/framing.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+class RpcConnection;
+
+/*线上帧格式：由 total_len 之后的第一个字节区分，两种格式可以在同一个服务端上并存
+    - Legacy：[total_len][meta_len][RpcMeta][body]，meta_len 为大端 uint32，首字节恒为 0
+    - Binary：[total_len][32 字节定长头][ext][body]，首字节为 RpcCodec::kMagic
+      定长头（大端，各字段按自身大小对齐）：
+        0  magic      u8      8  request_id  u64     24 body_len  u32
+        1  version    u8      16 status      i32     28 reserved  u32
+        2  flags      u16     20 ext_len     u32
+        4  method_id  u32
+      ext 是可选的 RpcMeta 扩展段（ext_len == 0 时不存在），只在有服务名/方法名、错误文本等可选字段时才写
+*/
+enum class WireFormat {
+    Legacy,
+    Binary,
+};
+
+// 帧头中热路径需要的字段，两种格式解码后都统一成这个结构
+struct RpcHeader {
+    uint64_t request_id = 0;
+    uint32_t method_id = 0;     // 0 表示按名字分发（名字在 RpcMeta 中）
+    int32_t  status = 0;        // 0 成功，非 0 失败（错误文本在 RpcMeta.error_msg）
+    bool     is_request = false;
+};
 
 class RpcCodec {
 public:
+    // 旧格式帧固定头部：[4字节total_len][4字节meta_len]
+    static constexpr size_t kWireHeaderLen = 8;
+
+    // 定长头格式：魔数、版本号、定长头长度（不含 total_len）
+    static constexpr uint8_t kMagic = 0xB5;
+    static constexpr uint8_t kBinaryVersion = 1;
+    static constexpr size_t  kBinaryHeaderLen = 32;
+    static constexpr uint16_t kFlagRequest = 1 << 0;
+
+    // 解码结果：payload 和 frame 一样只是接收缓冲区的视图
+    struct DecodedFrame {
+        WireFormat format = WireFormat::Legacy;
+        RpcHeader header;
+        bool has_meta = false;       // meta 是否被解析过（旧格式总是；定长头格式只在带 ext 时）
+        std::string_view payload;
+    };
+
+    // 方法编号握手请求使用的保留服务名（见 rpc_meta.proto 中 HandshakeResponse 的说明）
+    static constexpr const char* kHandshakeService = "__handshake__";
+
+    /*以下 Encode* 都输出“可以直接发送的整帧”，帧前缀由 framing 决定（见 net/framing.h），
+      默认 Fixed32 即文档中的 [total_len]；格式在每条消息上只判断一次*/
+
+    // 编码：RpcMeta + Message => 完整线上帧 [total_len][meta_len][meta][body]
+    // - 先用 ByteSizeLong() 算出 meta/body 长度，再用 SerializeWithCachedSizesToArray 直接写入 out，
+    //   没有任何中间 std::string；out 的已有容量会被复用，容量足够时零分配
+    static bool EncodeMessage(const rpc::RpcMeta& meta,
+                              const google::protobuf::Message& msg,
+                              std::string* out,
+                              FramingType framing = FramingType::Fixed32);
+
+    // 只编码头部 [total_len][meta_len][meta]，body 由调用方另行提供（已序列化好的大 body / 附件）
+    // 配合 RpcConnection::SendV 使用，body 不需要再拷贝进同一块缓冲区：
+    //   RpcCodec::EncodeHeader(meta, body.size(), &head);
+    //   IoSlice slices[] = {{head.data(), head.size()}, {body.data(), body.size()}};
+    //   conn->SendV(slices, 2);
+    // Checksum 格式需要整帧内容才能算校验和，body_len > 0 时不支持（返回 false）
+    static bool EncodeHeader(const rpc::RpcMeta& meta,
+                             size_t body_len,
+                             std::string* out,
+                             FramingType framing = FramingType::Fixed32);
+
+    // 定长头格式编码：[total_len][定长头][ext][body]，整帧一次写入 out
+    // - ext 为 nullptr 时不写扩展段；成功的请求（已协商 method_id）和成功的响应都不需要它
+    // - msg 为 nullptr 时 body 为空（错误响应、握手请求）
+    static bool EncodeBinary(const RpcHeader& header,
+                             const rpc::RpcMeta* ext,
+                             const google::protobuf::Message* msg,
+                             std::string* out,
+                             FramingType framing = FramingType::Fixed32);
+
+    // 按请求所用的格式编码响应：服务端总是用对方发来的格式回复，旧客户端收到的仍是旧格式
+    // error_msg 为空且 load 为 nullptr 时不携带可选字段（定长头格式下也就不需要扩展段）；
+    // load 为采样到的服务端负载报告，写进 meta / 扩展段（旧客户端不认识这个字段，解析时忽略）
+    static bool EncodeResponse(WireFormat format,
+                               uint64_t request_id,
+                               int32_t status,
+                               const std::string& error_msg,
+                               const google::protobuf::Message* msg,
+                               std::string* out,
+                               FramingType framing = FramingType::Fixed32,
+                               const rpc::LoadReport* load = nullptr);
+
+    // 编码响应并通过 conn 发送：连接提供发送缓冲区（RpcConnection::BeginFrame，如共享内存环）时
+    // 直接编码进去，省掉一次整帧拷贝；否则编码进 ScratchBuffer 再 Send。帧前缀取 conn->GetFraming()
+    static bool SendResponse(RpcConnection* conn,
+                             WireFormat format,
+                             uint64_t request_id,
+                             int32_t status,
+                             const std::string& error_msg,
+                             const google::protobuf::Message* msg,
+                             const rpc::LoadReport* load = nullptr);
+
+    // 当前线程可复用的编码缓冲区，配合 EncodeMessage 使用：
+    //   std::string& out = RpcCodec::ScratchBuffer();
+    //   RpcCodec::EncodeMessage(meta, msg, &out);
+    //   conn->Send(out);   // 发送函数返回前必须用完 out，不能跨调用持有
+    static std::string& ScratchBuffer();
+
     // 编码：RpcMeta + Message => frame（二进制，不包含总长度前缀）
     static bool EncodeFrame(const rpc::RpcMeta& meta,
                             const google::protobuf::Message& msg,
                             std::string* out);
 
+    // 解码任一格式的 frame（按首字节判断格式）：
+    // - 定长头格式只做一次 32 字节拷贝 + 字节序转换，只有带 ext 时才解析 protobuf
+    // - 旧格式解析 RpcMeta，再把其中的字段填进 out->header
+    // - meta 只在 out->has_meta 时被写入，否则保持原样：调用方可以复用同一个 RpcMeta，
+    //   但只能在 has_meta 时读取其中的可选字段（名字、错误文本）
+    static bool Decode(std::string_view frame,
+                       DecodedFrame* out,
+                       rpc::RpcMeta* meta);
+
     // 解码：frame（二进制） => RpcMeta + payload bytes
-    static bool DecodeFrame(const std::string& frame,
+    // - meta 直接用 ParseFromArray 从 frame 内部解析（定长头格式的帧会把头部字段补进 meta）
+    // - payload 只是 frame 内部的视图（不拷贝），生命周期与 frame 相同，调用方应直接对它 ParseFromArray
+    // - 热路径请用 Decode
+    static bool DecodeFrame(std::string_view frame,
                             rpc::RpcMeta* meta,
-                            std::string* payload);
+                            std::string_view* payload);
 
-    // 可选：把 frame 再加一个 length 前缀，方便在客户端用
+    // 可选：把 frame 再加一个 length 前缀，方便在客户端用（会整帧拷贝一次，热路径请用 EncodeMessage）
     static std::string AddLengthPrefix(const std::string& frame);
 };
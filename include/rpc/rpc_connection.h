@@ -1,8 +1,48 @@
 #pragma once
 #include <string>
+#include <cstddef>
+#include "net/framing.h"
+
+// 一段待发送的数据（类似 struct iovec），只是“借用”调用方的内存，不拥有它
+struct IoSlice {
+    const void* data;
+    size_t len;
+};
 
 class RpcConnection {
 public:
     virtual ~RpcConnection() = default;
     virtual void Send(const std::string& data) = 0;
+
+    // 本连接使用的帧前缀格式（由监听端配置决定），编码响应时据此写前缀
+    virtual FramingType GetFraming() const { return FramingType::Fixed32; }
+
+    /*分散/聚集发送：把 count 个不连续的片段按顺序作为一段连续字节流发出
+        典型用法：[8字节头部][meta][大 body/附件] 三段分别来自不同内存，不需要先拼成一个 std::string
+        slices 指向的内存只需要在本次调用期间有效
+        默认实现退化为“拼接后 Send”，具体网络实现应覆盖它（writev 或直接从调用方内存写 socket）
+    */
+    virtual void SendV(const IoSlice* slices, size_t count) {
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i) total += slices[i].len;
+
+        std::string data;
+        data.reserve(total);
+        for (size_t i = 0; i < count; ++i) {
+            data.append(static_cast<const char*>(slices[i].data), slices[i].len);
+        }
+        Send(data);
+    }
+
+    /*直接编码进发送缓冲区（见 RpcCodec::SendResponse）：
+        BeginFrame 在连接自己的发送缓冲区里预留 len 字节（一整帧，含帧前缀）并返回写入位置，
+        调用方写完后必须立即 CommitFrame 发布，中间不能再调用本连接的其他发送函数；
+        返回 nullptr 表示不支持或此刻无法预留（缓冲区满等），调用方改用 Send。
+        默认实现不支持：socket 连接的数据本来就要拷贝进内核，没有可以直接写的缓冲区
+    */
+    virtual char* BeginFrame(size_t len) {
+        (void)len;
+        return nullptr;
+    }
+    virtual void CommitFrame() {}
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <google/protobuf/service.h>
+#include <cstdint>
 #include <string>
 
 class SimpleRpcController : public google::protobuf::RpcController {
@@ -12,8 +13,19 @@ public:
     void Reset() override {
         failed_ = false;
         error_text_.clear();
+        timeout_ms_ = 0;
+        routing_key_.clear();
     }
 
+    // 本次调用的超时时间（毫秒），0 表示使用 RpcChannel 的默认超时；需在发起调用前设置
+    void SetTimeout(int64_t timeout_ms) { timeout_ms_ = timeout_ms; }
+    int64_t TimeoutMs() const { return timeout_ms_; }
+
+    // 路由键：RpcClient 使用 ConsistentHash 策略时，同一个键总是发往同一个后端（除非它下线或超出负载上限）；
+    // 为空表示没有，需在发起调用前设置
+    void SetRoutingKey(std::string key) { routing_key_ = std::move(key); }
+    const std::string& RoutingKey() const { return routing_key_; }
+
     // 是否失败
     bool Failed() const override {
         return failed_;
@@ -50,4 +62,6 @@ public:
 private:
     bool failed_{false};
     std::string error_text_;
+    int64_t timeout_ms_{0};
+    std::string routing_key_;
 };
\ No newline at end of file
@@ -1,23 +1,98 @@
 #pragma once
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 #include <google/protobuf/service.h>
 #include "rpc_meta.pb.h"
 #include "rpc/rpc_connection.h"
+#include "rpc/rpc_codec.h"
+#include "rpc/method_table.h"
 #include "net/network_server.h"
 
+namespace muduo {
+class ThreadPool;
+class Timestamp;
+}
+
 /*因为RpcDispatcher要处理网络层的frame，所以继承MessageHandler*/
 class RpcDispatcher: public MessageHandler {
 public:
+    // worker 线程池的运行统计
+    struct WorkerStats {
+        size_t   queue_depth = 0;    // 当前排队等待执行的请求数
+        uint64_t tasks = 0;          // 已开始执行的请求数
+        uint64_t total_wait_us = 0;  // 累计排队时间（微秒），除以 tasks 即平均等待
+        uint64_t max_wait_us = 0;    // 最大排队时间（微秒）
+    };
+
+    RpcDispatcher();
+    ~RpcDispatcher() override;
+
+    // 必须在服务启动（Run）之前注册
     void RegisterService(google::protobuf::Service* service);
+
+    /*业务线程池：n > 0 时，IO 线程解码出请求后把 CallMethod 投递到 worker 线程执行，
+        慢 handler 不会再阻塞同一 EventLoop 上的其他连接；n == 0（默认）时在 IO 线程内直接执行
+      需在 Start() 之前设置*/
+    void SetWorkerThreads(int n);
+    void Start();
+    // 先执行完已排队的调用再停止 worker；需在网络层停止（不再有新请求进来）之后调用
+    void Stop();
+    WorkerStats GetWorkerStats() const;
+
+    /*负载报告：每 every_n 个响应（按发送响应的线程计数）附带一份 rpc::LoadReport
+        （worker 排队数、在途请求数、最近的进程 CPU 利用率），客户端据此把流量从繁忙的副本上移开，见 rpc/load_balancer.h
+      0（默认）关闭：不统计在途请求数，响应里也不带报告。需在 Start() 之前设置*/
+    void SetLoadReportSampling(uint32_t every_n);
+    // 当前负载（即随响应发出的报告内容）；未开启负载报告时 in_flight 恒为 0
+    rpc::LoadReport GetLoadReport();
+
+    // 按方法描述符查分发表（进程内调用 LocalRpcChannel 使用），未注册返回 nullptr
+    const MethodEntry* FindMethod(const google::protobuf::MethodDescriptor* method) const;
+
     //重载HandleMessage
     void HandleMessage(const std::shared_ptr<RpcConnection>& conn,
-        const std::string& frame) override;
+        std::string_view frame) override;
 private:
     void OnRpcMessage(const std::shared_ptr<RpcConnection>& conn,
-                                      const rpc::RpcMeta& meta,
-                                      const std::string& payload);
+                      const RpcCodec::DecodedFrame& frame,
+                      const rpc::RpcMeta& meta);
+    struct ServerCall;
+    void Invoke(ServerCall* call);
+    void OnCallDone(ServerCall* call);
+    void SendError(const std::shared_ptr<RpcConnection>& conn,
+                   const RpcCodec::DecodedFrame& frame,
+                   const std::string& error_msg);
+    void SendHandshake(const std::shared_ptr<RpcConnection>& conn,
+                       const RpcCodec::DecodedFrame& frame);
+    void RecordWait(muduo::Timestamp enqueue_time);
+    uint32_t CpuPermille();
+
+    MethodTable methods_;   // 注册时构建、启动后只读的 (服务, 方法) 分发表
+    std::once_flag handshake_once_;
+    rpc::HandshakeResponse handshake_;   // 方法编号表，第一次握手时构建
+
+    int worker_threads_ = 0;
+    std::unique_ptr<muduo::ThreadPool> workers_;
+    // 已投递、还没开始执行的调用数：统计和负载报告读它而不是 workers_（Stop 会释放线程池，读者不持锁）
+    std::atomic<size_t> queued_{0};
+    std::atomic<bool> draining_{false};   // Stop 正在等待队列排空
+    std::mutex drain_mutex_;
+    std::condition_variable drain_cond_;
+    std::atomic<uint64_t> tasks_done_{0};
+    std::atomic<uint64_t> total_wait_us_{0};
+    std::atomic<uint64_t> max_wait_us_{0};
 
-    std::unordered_map<std::string, google::protobuf::Service*> services_;
+    uint32_t load_report_every_ = 0;
+    std::atomic<uint32_t> in_flight_{0};
+    // 进程 CPU 利用率：生成报告时若距上次采样超过 kCpuSampleIntervalUs 才重新计算
+    static constexpr int64_t kCpuSampleIntervalUs = 100 * 1000;
+    std::mutex cpu_mutex_;
+    int64_t cpu_sample_wall_us_ = 0;   // 以下两项受 cpu_mutex_ 保护
+    int64_t cpu_sample_cpu_us_ = 0;
+    std::atomic<uint32_t> cpu_permille_{0};
 };
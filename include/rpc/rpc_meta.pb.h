@@ -8,12 +8,12 @@
 #include <string>
 
 #include <google/protobuf/port_def.inc>
-#if PROTOBUF_VERSION < 3014000
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 3014000 < PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
 #error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
@@ -23,7 +23,6 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/arena.h>
 #include <google/protobuf/arenastring.h>
-#include <google/protobuf/generated_message_table_driven.h>
 #include <google/protobuf/generated_message_util.h>
 #include <google/protobuf/metadata_lite.h>
 #include <google/protobuf/generated_message_reflection.h>
@@ -42,34 +41,39 @@ PROTOBUF_NAMESPACE_CLOSE
 
 // Internal implementation detail -- do not use these members.
 struct TableStruct_rpc_5fmeta_2eproto {
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTableField entries[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::AuxiliaryParseTableField aux[]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::ParseTable schema[1]
-    PROTOBUF_SECTION_VARIABLE(protodesc_cold);
-  static const ::PROTOBUF_NAMESPACE_ID::internal::FieldMetadata field_metadata[];
-  static const ::PROTOBUF_NAMESPACE_ID::internal::SerializationTable serialization_table[];
-  static const ::PROTOBUF_NAMESPACE_ID::uint32 offsets[];
+  static const uint32_t offsets[];
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_rpc_5fmeta_2eproto;
 namespace rpc {
+class HandshakeResponse;
+struct HandshakeResponseDefaultTypeInternal;
+extern HandshakeResponseDefaultTypeInternal _HandshakeResponse_default_instance_;
+class LoadReport;
+struct LoadReportDefaultTypeInternal;
+extern LoadReportDefaultTypeInternal _LoadReport_default_instance_;
+class MethodIdEntry;
+struct MethodIdEntryDefaultTypeInternal;
+extern MethodIdEntryDefaultTypeInternal _MethodIdEntry_default_instance_;
 class RpcMeta;
-class RpcMetaDefaultTypeInternal;
+struct RpcMetaDefaultTypeInternal;
 extern RpcMetaDefaultTypeInternal _RpcMeta_default_instance_;
 }  // namespace rpc
 PROTOBUF_NAMESPACE_OPEN
+template<> ::rpc::HandshakeResponse* Arena::CreateMaybeMessage<::rpc::HandshakeResponse>(Arena*);
+template<> ::rpc::LoadReport* Arena::CreateMaybeMessage<::rpc::LoadReport>(Arena*);
+template<> ::rpc::MethodIdEntry* Arena::CreateMaybeMessage<::rpc::MethodIdEntry>(Arena*);
 template<> ::rpc::RpcMeta* Arena::CreateMaybeMessage<::rpc::RpcMeta>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace rpc {
 
 // ===================================================================
 
-class RpcMeta PROTOBUF_FINAL :
+class RpcMeta final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:rpc.RpcMeta) */ {
  public:
   inline RpcMeta() : RpcMeta(nullptr) {}
-  virtual ~RpcMeta();
+  ~RpcMeta() override;
+  explicit PROTOBUF_CONSTEXPR RpcMeta(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   RpcMeta(const RpcMeta& from);
   RpcMeta(RpcMeta&& from) noexcept
@@ -82,8 +86,13 @@ class RpcMeta PROTOBUF_FINAL :
     return *this;
   }
   inline RpcMeta& operator=(RpcMeta&& from) noexcept {
-    if (GetArena() == from.GetArena()) {
-      if (this != &from) InternalSwap(&from);
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
     } else {
       CopyFrom(from);
     }
@@ -94,13 +103,14 @@ class RpcMeta PROTOBUF_FINAL :
     return GetDescriptor();
   }
   static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
-    return GetMetadataStatic().descriptor;
+    return default_instance().GetMetadata().descriptor;
   }
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
-    return GetMetadataStatic().reflection;
+    return default_instance().GetMetadata().reflection;
+  }
+  static const RpcMeta& default_instance() {
+    return *internal_default_instance();
   }
-  static const RpcMeta& default_instance();
-
   static inline const RpcMeta* internal_default_instance() {
     return reinterpret_cast<const RpcMeta*>(
                &_RpcMeta_default_instance_);
@@ -113,7 +123,12 @@ class RpcMeta PROTOBUF_FINAL :
   }
   inline void Swap(RpcMeta* other) {
     if (other == this) return;
-    if (GetArena() == other->GetArena()) {
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
       InternalSwap(other);
     } else {
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
@@ -121,56 +136,53 @@ class RpcMeta PROTOBUF_FINAL :
   }
   void UnsafeArenaSwap(RpcMeta* other) {
     if (other == this) return;
-    GOOGLE_DCHECK(GetArena() == other->GetArena());
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
   }
 
   // implements Message ----------------------------------------------
 
-  inline RpcMeta* New() const final {
-    return CreateMaybeMessage<RpcMeta>(nullptr);
-  }
-
-  RpcMeta* New(::PROTOBUF_NAMESPACE_ID::Arena* arena) const final {
+  RpcMeta* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<RpcMeta>(arena);
   }
-  void CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
-  void MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) final;
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const RpcMeta& from);
-  void MergeFrom(const RpcMeta& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const RpcMeta& from) {
+    RpcMeta::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
   PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
   bool IsInitialized() const final;
 
   size_t ByteSizeLong() const final;
   const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  ::PROTOBUF_NAMESPACE_ID::uint8* _InternalSerialize(
-      ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _cached_size_.Get(); }
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
 
   private:
-  inline void SharedCtor();
-  inline void SharedDtor();
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
   void SetCachedSize(int size) const final;
   void InternalSwap(RpcMeta* other);
+
+  private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
     return "rpc.RpcMeta";
   }
   protected:
-  explicit RpcMeta(::PROTOBUF_NAMESPACE_ID::Arena* arena);
-  private:
-  static void ArenaDtor(void* object);
-  inline void RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena* arena);
+  explicit RpcMeta(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
 
-  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
-  private:
-  static ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadataStatic() {
-    ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&::descriptor_table_rpc_5fmeta_2eproto);
-    return ::descriptor_table_rpc_5fmeta_2eproto.file_level_metadata[kIndexInFileMessages];
-  }
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
 
-  public:
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
@@ -180,65 +192,79 @@ class RpcMeta PROTOBUF_FINAL :
     kServiceNameFieldNumber = 1,
     kMethodNameFieldNumber = 2,
     kErrorMsgFieldNumber = 6,
+    kLoadFieldNumber = 8,
     kRequestIdFieldNumber = 3,
     kIsRequestFieldNumber = 4,
     kErrorCodeFieldNumber = 5,
+    kMethodIdFieldNumber = 7,
   };
   // string service_name = 1;
   void clear_service_name();
   const std::string& service_name() const;
-  void set_service_name(const std::string& value);
-  void set_service_name(std::string&& value);
-  void set_service_name(const char* value);
-  void set_service_name(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_service_name(ArgT0&& arg0, ArgT... args);
   std::string* mutable_service_name();
-  std::string* release_service_name();
+  PROTOBUF_NODISCARD std::string* release_service_name();
   void set_allocated_service_name(std::string* service_name);
   private:
   const std::string& _internal_service_name() const;
-  void _internal_set_service_name(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_service_name(const std::string& value);
   std::string* _internal_mutable_service_name();
   public:
 
   // string method_name = 2;
   void clear_method_name();
   const std::string& method_name() const;
-  void set_method_name(const std::string& value);
-  void set_method_name(std::string&& value);
-  void set_method_name(const char* value);
-  void set_method_name(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_method_name(ArgT0&& arg0, ArgT... args);
   std::string* mutable_method_name();
-  std::string* release_method_name();
+  PROTOBUF_NODISCARD std::string* release_method_name();
   void set_allocated_method_name(std::string* method_name);
   private:
   const std::string& _internal_method_name() const;
-  void _internal_set_method_name(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_method_name(const std::string& value);
   std::string* _internal_mutable_method_name();
   public:
 
   // string error_msg = 6;
   void clear_error_msg();
   const std::string& error_msg() const;
-  void set_error_msg(const std::string& value);
-  void set_error_msg(std::string&& value);
-  void set_error_msg(const char* value);
-  void set_error_msg(const char* value, size_t size);
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_error_msg(ArgT0&& arg0, ArgT... args);
   std::string* mutable_error_msg();
-  std::string* release_error_msg();
+  PROTOBUF_NODISCARD std::string* release_error_msg();
   void set_allocated_error_msg(std::string* error_msg);
   private:
   const std::string& _internal_error_msg() const;
-  void _internal_set_error_msg(const std::string& value);
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_error_msg(const std::string& value);
   std::string* _internal_mutable_error_msg();
   public:
 
+  // .rpc.LoadReport load = 8;
+  bool has_load() const;
+  private:
+  bool _internal_has_load() const;
+  public:
+  void clear_load();
+  const ::rpc::LoadReport& load() const;
+  PROTOBUF_NODISCARD ::rpc::LoadReport* release_load();
+  ::rpc::LoadReport* mutable_load();
+  void set_allocated_load(::rpc::LoadReport* load);
+  private:
+  const ::rpc::LoadReport& _internal_load() const;
+  ::rpc::LoadReport* _internal_mutable_load();
+  public:
+  void unsafe_arena_set_allocated_load(
+      ::rpc::LoadReport* load);
+  ::rpc::LoadReport* unsafe_arena_release_load();
+
   // uint64 request_id = 3;
   void clear_request_id();
-  ::PROTOBUF_NAMESPACE_ID::uint64 request_id() const;
-  void set_request_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t request_id() const;
+  void set_request_id(uint64_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::uint64 _internal_request_id() const;
-  void _internal_set_request_id(::PROTOBUF_NAMESPACE_ID::uint64 value);
+  uint64_t _internal_request_id() const;
+  void _internal_set_request_id(uint64_t value);
   public:
 
   // bool is_request = 4;
@@ -252,11 +278,20 @@ class RpcMeta PROTOBUF_FINAL :
 
   // int32 error_code = 5;
   void clear_error_code();
-  ::PROTOBUF_NAMESPACE_ID::int32 error_code() const;
-  void set_error_code(::PROTOBUF_NAMESPACE_ID::int32 value);
+  int32_t error_code() const;
+  void set_error_code(int32_t value);
+  private:
+  int32_t _internal_error_code() const;
+  void _internal_set_error_code(int32_t value);
+  public:
+
+  // uint32 method_id = 7;
+  void clear_method_id();
+  uint32_t method_id() const;
+  void set_method_id(uint32_t value);
   private:
-  ::PROTOBUF_NAMESPACE_ID::int32 _internal_error_code() const;
-  void _internal_set_error_code(::PROTOBUF_NAMESPACE_ID::int32 value);
+  uint32_t _internal_method_id() const;
+  void _internal_set_method_id(uint32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:rpc.RpcMeta)
@@ -266,13 +301,536 @@ class RpcMeta PROTOBUF_FINAL :
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr service_name_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr method_name_;
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_msg_;
-  ::PROTOBUF_NAMESPACE_ID::uint64 request_id_;
-  bool is_request_;
-  ::PROTOBUF_NAMESPACE_ID::int32 error_code_;
-  mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr service_name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr method_name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_msg_;
+    ::rpc::LoadReport* load_;
+    uint64_t request_id_;
+    bool is_request_;
+    int32_t error_code_;
+    uint32_t method_id_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_rpc_5fmeta_2eproto;
+};
+// -------------------------------------------------------------------
+
+class LoadReport final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:rpc.LoadReport) */ {
+ public:
+  inline LoadReport() : LoadReport(nullptr) {}
+  ~LoadReport() override;
+  explicit PROTOBUF_CONSTEXPR LoadReport(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  LoadReport(const LoadReport& from);
+  LoadReport(LoadReport&& from) noexcept
+    : LoadReport() {
+    *this = ::std::move(from);
+  }
+
+  inline LoadReport& operator=(const LoadReport& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline LoadReport& operator=(LoadReport&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const LoadReport& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const LoadReport* internal_default_instance() {
+    return reinterpret_cast<const LoadReport*>(
+               &_LoadReport_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(LoadReport& a, LoadReport& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(LoadReport* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(LoadReport* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  LoadReport* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<LoadReport>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const LoadReport& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const LoadReport& from) {
+    LoadReport::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(LoadReport* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "rpc.LoadReport";
+  }
+  protected:
+  explicit LoadReport(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kQueueDepthFieldNumber = 1,
+    kInFlightFieldNumber = 2,
+    kCpuPermilleFieldNumber = 3,
+  };
+  // uint32 queue_depth = 1;
+  void clear_queue_depth();
+  uint32_t queue_depth() const;
+  void set_queue_depth(uint32_t value);
+  private:
+  uint32_t _internal_queue_depth() const;
+  void _internal_set_queue_depth(uint32_t value);
+  public:
+
+  // uint32 in_flight = 2;
+  void clear_in_flight();
+  uint32_t in_flight() const;
+  void set_in_flight(uint32_t value);
+  private:
+  uint32_t _internal_in_flight() const;
+  void _internal_set_in_flight(uint32_t value);
+  public:
+
+  // uint32 cpu_permille = 3;
+  void clear_cpu_permille();
+  uint32_t cpu_permille() const;
+  void set_cpu_permille(uint32_t value);
+  private:
+  uint32_t _internal_cpu_permille() const;
+  void _internal_set_cpu_permille(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:rpc.LoadReport)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    uint32_t queue_depth_;
+    uint32_t in_flight_;
+    uint32_t cpu_permille_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_rpc_5fmeta_2eproto;
+};
+// -------------------------------------------------------------------
+
+class MethodIdEntry final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:rpc.MethodIdEntry) */ {
+ public:
+  inline MethodIdEntry() : MethodIdEntry(nullptr) {}
+  ~MethodIdEntry() override;
+  explicit PROTOBUF_CONSTEXPR MethodIdEntry(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  MethodIdEntry(const MethodIdEntry& from);
+  MethodIdEntry(MethodIdEntry&& from) noexcept
+    : MethodIdEntry() {
+    *this = ::std::move(from);
+  }
+
+  inline MethodIdEntry& operator=(const MethodIdEntry& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline MethodIdEntry& operator=(MethodIdEntry&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const MethodIdEntry& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const MethodIdEntry* internal_default_instance() {
+    return reinterpret_cast<const MethodIdEntry*>(
+               &_MethodIdEntry_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(MethodIdEntry& a, MethodIdEntry& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(MethodIdEntry* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(MethodIdEntry* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  MethodIdEntry* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<MethodIdEntry>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const MethodIdEntry& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const MethodIdEntry& from) {
+    MethodIdEntry::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(MethodIdEntry* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "rpc.MethodIdEntry";
+  }
+  protected:
+  explicit MethodIdEntry(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kServiceNameFieldNumber = 1,
+    kMethodNameFieldNumber = 2,
+    kMethodIdFieldNumber = 3,
+  };
+  // string service_name = 1;
+  void clear_service_name();
+  const std::string& service_name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_service_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_service_name();
+  PROTOBUF_NODISCARD std::string* release_service_name();
+  void set_allocated_service_name(std::string* service_name);
+  private:
+  const std::string& _internal_service_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_service_name(const std::string& value);
+  std::string* _internal_mutable_service_name();
+  public:
+
+  // string method_name = 2;
+  void clear_method_name();
+  const std::string& method_name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_method_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_method_name();
+  PROTOBUF_NODISCARD std::string* release_method_name();
+  void set_allocated_method_name(std::string* method_name);
+  private:
+  const std::string& _internal_method_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_method_name(const std::string& value);
+  std::string* _internal_mutable_method_name();
+  public:
+
+  // uint32 method_id = 3;
+  void clear_method_id();
+  uint32_t method_id() const;
+  void set_method_id(uint32_t value);
+  private:
+  uint32_t _internal_method_id() const;
+  void _internal_set_method_id(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:rpc.MethodIdEntry)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr service_name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr method_name_;
+    uint32_t method_id_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_rpc_5fmeta_2eproto;
+};
+// -------------------------------------------------------------------
+
+class HandshakeResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:rpc.HandshakeResponse) */ {
+ public:
+  inline HandshakeResponse() : HandshakeResponse(nullptr) {}
+  ~HandshakeResponse() override;
+  explicit PROTOBUF_CONSTEXPR HandshakeResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  HandshakeResponse(const HandshakeResponse& from);
+  HandshakeResponse(HandshakeResponse&& from) noexcept
+    : HandshakeResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline HandshakeResponse& operator=(const HandshakeResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline HandshakeResponse& operator=(HandshakeResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const HandshakeResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const HandshakeResponse* internal_default_instance() {
+    return reinterpret_cast<const HandshakeResponse*>(
+               &_HandshakeResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    3;
+
+  friend void swap(HandshakeResponse& a, HandshakeResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(HandshakeResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(HandshakeResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  HandshakeResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HandshakeResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const HandshakeResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const HandshakeResponse& from) {
+    HandshakeResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(HandshakeResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "rpc.HandshakeResponse";
+  }
+  protected:
+  explicit HandshakeResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMethodsFieldNumber = 1,
+    kBinaryVersionFieldNumber = 2,
+  };
+  // repeated .rpc.MethodIdEntry methods = 1;
+  int methods_size() const;
+  private:
+  int _internal_methods_size() const;
+  public:
+  void clear_methods();
+  ::rpc::MethodIdEntry* mutable_methods(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::rpc::MethodIdEntry >*
+      mutable_methods();
+  private:
+  const ::rpc::MethodIdEntry& _internal_methods(int index) const;
+  ::rpc::MethodIdEntry* _internal_add_methods();
+  public:
+  const ::rpc::MethodIdEntry& methods(int index) const;
+  ::rpc::MethodIdEntry* add_methods();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::rpc::MethodIdEntry >&
+      methods() const;
+
+  // uint32 binary_version = 2;
+  void clear_binary_version();
+  uint32_t binary_version() const;
+  void set_binary_version(uint32_t value);
+  private:
+  uint32_t _internal_binary_version() const;
+  void _internal_set_binary_version(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:rpc.HandshakeResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::rpc::MethodIdEntry > methods_;
+    uint32_t binary_version_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_rpc_5fmeta_2eproto;
 };
 // ===================================================================
@@ -288,53 +846,38 @@ class RpcMeta PROTOBUF_FINAL :
 
 // string service_name = 1;
 inline void RpcMeta::clear_service_name() {
-  service_name_.ClearToEmpty();
+  _impl_.service_name_.ClearToEmpty();
 }
 inline const std::string& RpcMeta::service_name() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.service_name)
   return _internal_service_name();
 }
-inline void RpcMeta::set_service_name(const std::string& value) {
-  _internal_set_service_name(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RpcMeta::set_service_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.service_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:rpc.RpcMeta.service_name)
 }
 inline std::string* RpcMeta::mutable_service_name() {
+  std::string* _s = _internal_mutable_service_name();
   // @@protoc_insertion_point(field_mutable:rpc.RpcMeta.service_name)
-  return _internal_mutable_service_name();
+  return _s;
 }
 inline const std::string& RpcMeta::_internal_service_name() const {
-  return service_name_.Get();
+  return _impl_.service_name_.Get();
 }
 inline void RpcMeta::_internal_set_service_name(const std::string& value) {
   
-  service_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void RpcMeta::set_service_name(std::string&& value) {
-  
-  service_name_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:rpc.RpcMeta.service_name)
-}
-inline void RpcMeta::set_service_name(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  service_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:rpc.RpcMeta.service_name)
-}
-inline void RpcMeta::set_service_name(const char* value,
-    size_t size) {
-  
-  service_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:rpc.RpcMeta.service_name)
+  _impl_.service_name_.Set(value, GetArenaForAllocation());
 }
 inline std::string* RpcMeta::_internal_mutable_service_name() {
   
-  return service_name_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  return _impl_.service_name_.Mutable(GetArenaForAllocation());
 }
 inline std::string* RpcMeta::release_service_name() {
   // @@protoc_insertion_point(field_release:rpc.RpcMeta.service_name)
-  return service_name_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  return _impl_.service_name_.Release();
 }
 inline void RpcMeta::set_allocated_service_name(std::string* service_name) {
   if (service_name != nullptr) {
@@ -342,60 +885,49 @@ inline void RpcMeta::set_allocated_service_name(std::string* service_name) {
   } else {
     
   }
-  service_name_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), service_name,
-      GetArena());
+  _impl_.service_name_.SetAllocated(service_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.service_name_.IsDefault()) {
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:rpc.RpcMeta.service_name)
 }
 
 // string method_name = 2;
 inline void RpcMeta::clear_method_name() {
-  method_name_.ClearToEmpty();
+  _impl_.method_name_.ClearToEmpty();
 }
 inline const std::string& RpcMeta::method_name() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.method_name)
   return _internal_method_name();
 }
-inline void RpcMeta::set_method_name(const std::string& value) {
-  _internal_set_method_name(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RpcMeta::set_method_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.method_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:rpc.RpcMeta.method_name)
 }
 inline std::string* RpcMeta::mutable_method_name() {
+  std::string* _s = _internal_mutable_method_name();
   // @@protoc_insertion_point(field_mutable:rpc.RpcMeta.method_name)
-  return _internal_mutable_method_name();
+  return _s;
 }
 inline const std::string& RpcMeta::_internal_method_name() const {
-  return method_name_.Get();
+  return _impl_.method_name_.Get();
 }
 inline void RpcMeta::_internal_set_method_name(const std::string& value) {
   
-  method_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void RpcMeta::set_method_name(std::string&& value) {
-  
-  method_name_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:rpc.RpcMeta.method_name)
-}
-inline void RpcMeta::set_method_name(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  method_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:rpc.RpcMeta.method_name)
-}
-inline void RpcMeta::set_method_name(const char* value,
-    size_t size) {
-  
-  method_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:rpc.RpcMeta.method_name)
+  _impl_.method_name_.Set(value, GetArenaForAllocation());
 }
 inline std::string* RpcMeta::_internal_mutable_method_name() {
   
-  return method_name_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  return _impl_.method_name_.Mutable(GetArenaForAllocation());
 }
 inline std::string* RpcMeta::release_method_name() {
   // @@protoc_insertion_point(field_release:rpc.RpcMeta.method_name)
-  return method_name_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  return _impl_.method_name_.Release();
 }
 inline void RpcMeta::set_allocated_method_name(std::string* method_name) {
   if (method_name != nullptr) {
@@ -403,37 +935,41 @@ inline void RpcMeta::set_allocated_method_name(std::string* method_name) {
   } else {
     
   }
-  method_name_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), method_name,
-      GetArena());
+  _impl_.method_name_.SetAllocated(method_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.method_name_.IsDefault()) {
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:rpc.RpcMeta.method_name)
 }
 
 // uint64 request_id = 3;
 inline void RpcMeta::clear_request_id() {
-  request_id_ = PROTOBUF_ULONGLONG(0);
+  _impl_.request_id_ = uint64_t{0u};
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 RpcMeta::_internal_request_id() const {
-  return request_id_;
+inline uint64_t RpcMeta::_internal_request_id() const {
+  return _impl_.request_id_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::uint64 RpcMeta::request_id() const {
+inline uint64_t RpcMeta::request_id() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.request_id)
   return _internal_request_id();
 }
-inline void RpcMeta::_internal_set_request_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void RpcMeta::_internal_set_request_id(uint64_t value) {
   
-  request_id_ = value;
+  _impl_.request_id_ = value;
 }
-inline void RpcMeta::set_request_id(::PROTOBUF_NAMESPACE_ID::uint64 value) {
+inline void RpcMeta::set_request_id(uint64_t value) {
   _internal_set_request_id(value);
   // @@protoc_insertion_point(field_set:rpc.RpcMeta.request_id)
 }
 
 // bool is_request = 4;
 inline void RpcMeta::clear_is_request() {
-  is_request_ = false;
+  _impl_.is_request_ = false;
 }
 inline bool RpcMeta::_internal_is_request() const {
-  return is_request_;
+  return _impl_.is_request_;
 }
 inline bool RpcMeta::is_request() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.is_request)
@@ -441,7 +977,7 @@ inline bool RpcMeta::is_request() const {
 }
 inline void RpcMeta::_internal_set_is_request(bool value) {
   
-  is_request_ = value;
+  _impl_.is_request_ = value;
 }
 inline void RpcMeta::set_is_request(bool value) {
   _internal_set_is_request(value);
@@ -450,73 +986,58 @@ inline void RpcMeta::set_is_request(bool value) {
 
 // int32 error_code = 5;
 inline void RpcMeta::clear_error_code() {
-  error_code_ = 0;
+  _impl_.error_code_ = 0;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 RpcMeta::_internal_error_code() const {
-  return error_code_;
+inline int32_t RpcMeta::_internal_error_code() const {
+  return _impl_.error_code_;
 }
-inline ::PROTOBUF_NAMESPACE_ID::int32 RpcMeta::error_code() const {
+inline int32_t RpcMeta::error_code() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.error_code)
   return _internal_error_code();
 }
-inline void RpcMeta::_internal_set_error_code(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void RpcMeta::_internal_set_error_code(int32_t value) {
   
-  error_code_ = value;
+  _impl_.error_code_ = value;
 }
-inline void RpcMeta::set_error_code(::PROTOBUF_NAMESPACE_ID::int32 value) {
+inline void RpcMeta::set_error_code(int32_t value) {
   _internal_set_error_code(value);
   // @@protoc_insertion_point(field_set:rpc.RpcMeta.error_code)
 }
 
 // string error_msg = 6;
 inline void RpcMeta::clear_error_msg() {
-  error_msg_.ClearToEmpty();
+  _impl_.error_msg_.ClearToEmpty();
 }
 inline const std::string& RpcMeta::error_msg() const {
   // @@protoc_insertion_point(field_get:rpc.RpcMeta.error_msg)
   return _internal_error_msg();
 }
-inline void RpcMeta::set_error_msg(const std::string& value) {
-  _internal_set_error_msg(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RpcMeta::set_error_msg(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.error_msg_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:rpc.RpcMeta.error_msg)
 }
 inline std::string* RpcMeta::mutable_error_msg() {
+  std::string* _s = _internal_mutable_error_msg();
   // @@protoc_insertion_point(field_mutable:rpc.RpcMeta.error_msg)
-  return _internal_mutable_error_msg();
+  return _s;
 }
 inline const std::string& RpcMeta::_internal_error_msg() const {
-  return error_msg_.Get();
+  return _impl_.error_msg_.Get();
 }
 inline void RpcMeta::_internal_set_error_msg(const std::string& value) {
   
-  error_msg_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, value, GetArena());
-}
-inline void RpcMeta::set_error_msg(std::string&& value) {
-  
-  error_msg_.Set(
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::move(value), GetArena());
-  // @@protoc_insertion_point(field_set_rvalue:rpc.RpcMeta.error_msg)
-}
-inline void RpcMeta::set_error_msg(const char* value) {
-  GOOGLE_DCHECK(value != nullptr);
-  
-  error_msg_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(value), GetArena());
-  // @@protoc_insertion_point(field_set_char:rpc.RpcMeta.error_msg)
-}
-inline void RpcMeta::set_error_msg(const char* value,
-    size_t size) {
-  
-  error_msg_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, ::std::string(
-      reinterpret_cast<const char*>(value), size), GetArena());
-  // @@protoc_insertion_point(field_set_pointer:rpc.RpcMeta.error_msg)
+  _impl_.error_msg_.Set(value, GetArenaForAllocation());
 }
 inline std::string* RpcMeta::_internal_mutable_error_msg() {
   
-  return error_msg_.Mutable(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, GetArena());
+  return _impl_.error_msg_.Mutable(GetArenaForAllocation());
 }
 inline std::string* RpcMeta::release_error_msg() {
   // @@protoc_insertion_point(field_release:rpc.RpcMeta.error_msg)
-  return error_msg_.Release(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
+  return _impl_.error_msg_.Release();
 }
 inline void RpcMeta::set_allocated_error_msg(std::string* error_msg) {
   if (error_msg != nullptr) {
@@ -524,14 +1045,386 @@ inline void RpcMeta::set_allocated_error_msg(std::string* error_msg) {
   } else {
     
   }
-  error_msg_.SetAllocated(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), error_msg,
-      GetArena());
+  _impl_.error_msg_.SetAllocated(error_msg, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_msg_.IsDefault()) {
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:rpc.RpcMeta.error_msg)
 }
 
+// uint32 method_id = 7;
+inline void RpcMeta::clear_method_id() {
+  _impl_.method_id_ = 0u;
+}
+inline uint32_t RpcMeta::_internal_method_id() const {
+  return _impl_.method_id_;
+}
+inline uint32_t RpcMeta::method_id() const {
+  // @@protoc_insertion_point(field_get:rpc.RpcMeta.method_id)
+  return _internal_method_id();
+}
+inline void RpcMeta::_internal_set_method_id(uint32_t value) {
+  
+  _impl_.method_id_ = value;
+}
+inline void RpcMeta::set_method_id(uint32_t value) {
+  _internal_set_method_id(value);
+  // @@protoc_insertion_point(field_set:rpc.RpcMeta.method_id)
+}
+
+// .rpc.LoadReport load = 8;
+inline bool RpcMeta::_internal_has_load() const {
+  return this != internal_default_instance() && _impl_.load_ != nullptr;
+}
+inline bool RpcMeta::has_load() const {
+  return _internal_has_load();
+}
+inline void RpcMeta::clear_load() {
+  if (GetArenaForAllocation() == nullptr && _impl_.load_ != nullptr) {
+    delete _impl_.load_;
+  }
+  _impl_.load_ = nullptr;
+}
+inline const ::rpc::LoadReport& RpcMeta::_internal_load() const {
+  const ::rpc::LoadReport* p = _impl_.load_;
+  return p != nullptr ? *p : reinterpret_cast<const ::rpc::LoadReport&>(
+      ::rpc::_LoadReport_default_instance_);
+}
+inline const ::rpc::LoadReport& RpcMeta::load() const {
+  // @@protoc_insertion_point(field_get:rpc.RpcMeta.load)
+  return _internal_load();
+}
+inline void RpcMeta::unsafe_arena_set_allocated_load(
+    ::rpc::LoadReport* load) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.load_);
+  }
+  _impl_.load_ = load;
+  if (load) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:rpc.RpcMeta.load)
+}
+inline ::rpc::LoadReport* RpcMeta::release_load() {
+  
+  ::rpc::LoadReport* temp = _impl_.load_;
+  _impl_.load_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::rpc::LoadReport* RpcMeta::unsafe_arena_release_load() {
+  // @@protoc_insertion_point(field_release:rpc.RpcMeta.load)
+  
+  ::rpc::LoadReport* temp = _impl_.load_;
+  _impl_.load_ = nullptr;
+  return temp;
+}
+inline ::rpc::LoadReport* RpcMeta::_internal_mutable_load() {
+  
+  if (_impl_.load_ == nullptr) {
+    auto* p = CreateMaybeMessage<::rpc::LoadReport>(GetArenaForAllocation());
+    _impl_.load_ = p;
+  }
+  return _impl_.load_;
+}
+inline ::rpc::LoadReport* RpcMeta::mutable_load() {
+  ::rpc::LoadReport* _msg = _internal_mutable_load();
+  // @@protoc_insertion_point(field_mutable:rpc.RpcMeta.load)
+  return _msg;
+}
+inline void RpcMeta::set_allocated_load(::rpc::LoadReport* load) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.load_;
+  }
+  if (load) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(load);
+    if (message_arena != submessage_arena) {
+      load = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, load, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.load_ = load;
+  // @@protoc_insertion_point(field_set_allocated:rpc.RpcMeta.load)
+}
+
+// -------------------------------------------------------------------
+
+// LoadReport
+
+// uint32 queue_depth = 1;
+inline void LoadReport::clear_queue_depth() {
+  _impl_.queue_depth_ = 0u;
+}
+inline uint32_t LoadReport::_internal_queue_depth() const {
+  return _impl_.queue_depth_;
+}
+inline uint32_t LoadReport::queue_depth() const {
+  // @@protoc_insertion_point(field_get:rpc.LoadReport.queue_depth)
+  return _internal_queue_depth();
+}
+inline void LoadReport::_internal_set_queue_depth(uint32_t value) {
+  
+  _impl_.queue_depth_ = value;
+}
+inline void LoadReport::set_queue_depth(uint32_t value) {
+  _internal_set_queue_depth(value);
+  // @@protoc_insertion_point(field_set:rpc.LoadReport.queue_depth)
+}
+
+// uint32 in_flight = 2;
+inline void LoadReport::clear_in_flight() {
+  _impl_.in_flight_ = 0u;
+}
+inline uint32_t LoadReport::_internal_in_flight() const {
+  return _impl_.in_flight_;
+}
+inline uint32_t LoadReport::in_flight() const {
+  // @@protoc_insertion_point(field_get:rpc.LoadReport.in_flight)
+  return _internal_in_flight();
+}
+inline void LoadReport::_internal_set_in_flight(uint32_t value) {
+  
+  _impl_.in_flight_ = value;
+}
+inline void LoadReport::set_in_flight(uint32_t value) {
+  _internal_set_in_flight(value);
+  // @@protoc_insertion_point(field_set:rpc.LoadReport.in_flight)
+}
+
+// uint32 cpu_permille = 3;
+inline void LoadReport::clear_cpu_permille() {
+  _impl_.cpu_permille_ = 0u;
+}
+inline uint32_t LoadReport::_internal_cpu_permille() const {
+  return _impl_.cpu_permille_;
+}
+inline uint32_t LoadReport::cpu_permille() const {
+  // @@protoc_insertion_point(field_get:rpc.LoadReport.cpu_permille)
+  return _internal_cpu_permille();
+}
+inline void LoadReport::_internal_set_cpu_permille(uint32_t value) {
+  
+  _impl_.cpu_permille_ = value;
+}
+inline void LoadReport::set_cpu_permille(uint32_t value) {
+  _internal_set_cpu_permille(value);
+  // @@protoc_insertion_point(field_set:rpc.LoadReport.cpu_permille)
+}
+
+// -------------------------------------------------------------------
+
+// MethodIdEntry
+
+// string service_name = 1;
+inline void MethodIdEntry::clear_service_name() {
+  _impl_.service_name_.ClearToEmpty();
+}
+inline const std::string& MethodIdEntry::service_name() const {
+  // @@protoc_insertion_point(field_get:rpc.MethodIdEntry.service_name)
+  return _internal_service_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MethodIdEntry::set_service_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.service_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:rpc.MethodIdEntry.service_name)
+}
+inline std::string* MethodIdEntry::mutable_service_name() {
+  std::string* _s = _internal_mutable_service_name();
+  // @@protoc_insertion_point(field_mutable:rpc.MethodIdEntry.service_name)
+  return _s;
+}
+inline const std::string& MethodIdEntry::_internal_service_name() const {
+  return _impl_.service_name_.Get();
+}
+inline void MethodIdEntry::_internal_set_service_name(const std::string& value) {
+  
+  _impl_.service_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MethodIdEntry::_internal_mutable_service_name() {
+  
+  return _impl_.service_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MethodIdEntry::release_service_name() {
+  // @@protoc_insertion_point(field_release:rpc.MethodIdEntry.service_name)
+  return _impl_.service_name_.Release();
+}
+inline void MethodIdEntry::set_allocated_service_name(std::string* service_name) {
+  if (service_name != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.service_name_.SetAllocated(service_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.service_name_.IsDefault()) {
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:rpc.MethodIdEntry.service_name)
+}
+
+// string method_name = 2;
+inline void MethodIdEntry::clear_method_name() {
+  _impl_.method_name_.ClearToEmpty();
+}
+inline const std::string& MethodIdEntry::method_name() const {
+  // @@protoc_insertion_point(field_get:rpc.MethodIdEntry.method_name)
+  return _internal_method_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void MethodIdEntry::set_method_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.method_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:rpc.MethodIdEntry.method_name)
+}
+inline std::string* MethodIdEntry::mutable_method_name() {
+  std::string* _s = _internal_mutable_method_name();
+  // @@protoc_insertion_point(field_mutable:rpc.MethodIdEntry.method_name)
+  return _s;
+}
+inline const std::string& MethodIdEntry::_internal_method_name() const {
+  return _impl_.method_name_.Get();
+}
+inline void MethodIdEntry::_internal_set_method_name(const std::string& value) {
+  
+  _impl_.method_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* MethodIdEntry::_internal_mutable_method_name() {
+  
+  return _impl_.method_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* MethodIdEntry::release_method_name() {
+  // @@protoc_insertion_point(field_release:rpc.MethodIdEntry.method_name)
+  return _impl_.method_name_.Release();
+}
+inline void MethodIdEntry::set_allocated_method_name(std::string* method_name) {
+  if (method_name != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.method_name_.SetAllocated(method_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.method_name_.IsDefault()) {
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:rpc.MethodIdEntry.method_name)
+}
+
+// uint32 method_id = 3;
+inline void MethodIdEntry::clear_method_id() {
+  _impl_.method_id_ = 0u;
+}
+inline uint32_t MethodIdEntry::_internal_method_id() const {
+  return _impl_.method_id_;
+}
+inline uint32_t MethodIdEntry::method_id() const {
+  // @@protoc_insertion_point(field_get:rpc.MethodIdEntry.method_id)
+  return _internal_method_id();
+}
+inline void MethodIdEntry::_internal_set_method_id(uint32_t value) {
+  
+  _impl_.method_id_ = value;
+}
+inline void MethodIdEntry::set_method_id(uint32_t value) {
+  _internal_set_method_id(value);
+  // @@protoc_insertion_point(field_set:rpc.MethodIdEntry.method_id)
+}
+
+// -------------------------------------------------------------------
+
+// HandshakeResponse
+
+// repeated .rpc.MethodIdEntry methods = 1;
+inline int HandshakeResponse::_internal_methods_size() const {
+  return _impl_.methods_.size();
+}
+inline int HandshakeResponse::methods_size() const {
+  return _internal_methods_size();
+}
+inline void HandshakeResponse::clear_methods() {
+  _impl_.methods_.Clear();
+}
+inline ::rpc::MethodIdEntry* HandshakeResponse::mutable_methods(int index) {
+  // @@protoc_insertion_point(field_mutable:rpc.HandshakeResponse.methods)
+  return _impl_.methods_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::rpc::MethodIdEntry >*
+HandshakeResponse::mutable_methods() {
+  // @@protoc_insertion_point(field_mutable_list:rpc.HandshakeResponse.methods)
+  return &_impl_.methods_;
+}
+inline const ::rpc::MethodIdEntry& HandshakeResponse::_internal_methods(int index) const {
+  return _impl_.methods_.Get(index);
+}
+inline const ::rpc::MethodIdEntry& HandshakeResponse::methods(int index) const {
+  // @@protoc_insertion_point(field_get:rpc.HandshakeResponse.methods)
+  return _internal_methods(index);
+}
+inline ::rpc::MethodIdEntry* HandshakeResponse::_internal_add_methods() {
+  return _impl_.methods_.Add();
+}
+inline ::rpc::MethodIdEntry* HandshakeResponse::add_methods() {
+  ::rpc::MethodIdEntry* _add = _internal_add_methods();
+  // @@protoc_insertion_point(field_add:rpc.HandshakeResponse.methods)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::rpc::MethodIdEntry >&
+HandshakeResponse::methods() const {
+  // @@protoc_insertion_point(field_list:rpc.HandshakeResponse.methods)
+  return _impl_.methods_;
+}
+
+// uint32 binary_version = 2;
+inline void HandshakeResponse::clear_binary_version() {
+  _impl_.binary_version_ = 0u;
+}
+inline uint32_t HandshakeResponse::_internal_binary_version() const {
+  return _impl_.binary_version_;
+}
+inline uint32_t HandshakeResponse::binary_version() const {
+  // @@protoc_insertion_point(field_get:rpc.HandshakeResponse.binary_version)
+  return _internal_binary_version();
+}
+inline void HandshakeResponse::_internal_set_binary_version(uint32_t value) {
+  
+  _impl_.binary_version_ = value;
+}
+inline void HandshakeResponse::set_binary_version(uint32_t value) {
+  _internal_set_binary_version(value);
+  // @@protoc_insertion_point(field_set:rpc.HandshakeResponse.binary_version)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
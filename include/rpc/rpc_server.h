@@ -16,7 +16,19 @@ public:
         dispatcher_->RegisterService(service);
     }
 
-    void Run() { network_->Run(); }
+    // 业务线程数（0 表示在 IO 线程内直接执行业务方法），需在 Run() 之前设置
+    void SetWorkerThreads(int n) { dispatcher_->SetWorkerThreads(n); }
+    RpcDispatcher::WorkerStats GetWorkerStats() const { return dispatcher_->GetWorkerStats(); }
+    // 每 every_n 个响应附带一份负载报告（0 关闭），需在 Run() 之前设置，见 RpcDispatcher::SetLoadReportSampling
+    void SetLoadReportSampling(uint32_t every_n) { dispatcher_->SetLoadReportSampling(every_n); }
+    // 进程内调用（LocalRpcChannel）直接绑定到它
+    const std::shared_ptr<RpcDispatcher>& dispatcher() const { return dispatcher_; }
+
+    void Run() {
+        dispatcher_->Start();
+        network_->Run();
+        dispatcher_->Stop();
+    }
     void Stop()  { network_->Stop(); }
 
 private:
@@ -1,12 +1,16 @@
 #pragma once
 #include<memory>
+#include <string>
 #include "rpc_server.h"
+#include "net/framing.h"
 
 
 enum class NetworkType {
     Muduo,
     // Asio,
-    // Epoll,
+    Epoll,      // 原生 epoll 边沿触发后端（仅 Linux），见 net_epoll/epoll_network_server.h
+    IoUring,    // io_uring 后端（Linux 6.0+，构建时需 TINY_RPC_WITH_IO_URING），见 net_uring/uring_network_server.h
+    SharedMemory, // 同机共享内存环（仅 Linux），握手走 WithUnixSocket 的路径、不监听 TCP，见 net_shm/shm_network_server.h
 };
 
 class RpcServerFactory {
@@ -16,11 +20,29 @@ public:
     RpcServerFactory& WithPort(int port);
     RpcServerFactory& WithNetwork(NetworkType type);
     RpcServerFactory& WithIOThreads(int n);
+    // 开启写合并（同一轮事件循环内对同一连接的响应合并为一次 write），max_pending_bytes 为合并上限
+    RpcServerFactory& WithWriteCoalescing(size_t max_pending_bytes);
+    // 业务线程池大小：>0 时业务方法在 worker 线程执行，IO 线程只负责网络收发
+    RpcServerFactory& WithWorkerThreads(int n);
+    // 帧前缀格式（见 net/framing.h）：小消息为主的服务可选 Varint，需要端到端校验的选 Checksum；
+    // 客户端必须使用同一格式（SimpleRpcChannel::SetFraming + 对应的 BasicFrameCodec）
+    RpcServerFactory& WithFraming(FramingType framing);
+    // 在 TCP 端口之外同时监听一个 Unix 域 socket 路径（同机调用方绕过 TCP 回环，协议不变）；
+    // 客户端用 MuduoUnixClient（net_muduo/muduo_unix_client.h）或 sockets::ConnectUnix 连接。
+    // SharedMemory 后端只用这个路径做握手（客户端用 net_shm/shm_rpc_channel.h 的 ShmRpcChannel）
+    RpcServerFactory& WithUnixSocket(const std::string& path);
+    // 每 every_n 个响应附带一份服务端负载报告（排队数、在途数、CPU），RpcClient 用它调整各副本的权重
+    RpcServerFactory& WithLoadReports(uint32_t every_n);
 
     std::unique_ptr<RpcServer> Build();
 
 private:
     int port_ = 0;
     int io_threads_ = 1;
+    size_t coalesce_max_bytes_ = 0; //默认不开启写合并
+    int worker_threads_ = 0;        //默认在 IO 线程内执行业务方法
+    FramingType framing_ = FramingType::Fixed32; //默认 4 字节长度前缀
+    std::string unix_path_;                      //默认不监听 Unix 域 socket
+    uint32_t load_report_every_ = 0;             //默认不附带负载报告
     NetworkType net_type_ = NetworkType::Muduo; //默认为Muduo库
 };
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/*哈希时间轮（hashed timing wheel）
+    - 时间被切成 tick_ms 的格子，共 slot_count 个槽，到期时间为 deadline 的定时项放在 ceil(deadline/tick) % slot_count 槽中
+    - Add：O(1)，只是往槽里 push_back
+    - Advance：每推进一个 tick 只扫描一个槽；超过一圈的定时项留在槽里等下一圈
+    - 不支持主动删除：调用方（如 SimpleRpcChannel）在到期时自行判断定时项是否仍然有效（惰性删除），
+      已完成的调用最多在轮中多停留一个超时周期
+  非线程安全，由使用者加锁
+*/
+class TimerWheel {
+public:
+    TimerWheel(size_t slot_count, int64_t tick_ms, int64_t now_ms);
+
+    // 加入一个在 deadline_ms 到期的定时项
+    void Add(uint64_t id, int64_t deadline_ms);
+
+    // 推进到 now_ms，把所有 deadline <= now_ms 的定时项 id 追加到 expired
+    void Advance(int64_t now_ms, std::vector<uint64_t>* expired);
+
+    size_t size() const { return size_; }
+
+private:
+    struct Entry {
+        uint64_t id;
+        int64_t deadline_ms;
+    };
+
+    std::vector<std::vector<Entry>> slots_;
+    int64_t tick_ms_;
+    int64_t current_tick_;   // 已经处理到的 tick
+    size_t size_ = 0;
+};
@@ -0,0 +1,406 @@
+#include "log/logging.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rpclog {
+
+namespace detail {
+std::atomic<int> g_level{kInfo};
+}
+
+namespace {
+
+using detail::ArgType;
+using detail::RecordHeader;
+using detail::kPadding;
+
+constexpr size_t kRingBytes = 256 * 1024;        // 每个线程的环形缓冲区大小（2 的幂）
+constexpr int kPollIntervalMs = 10;               // 后台线程空闲时的轮询间隔
+
+const char* const kLevelNames[kNumLevels] = { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+void DefaultOutput(const char* msg, size_t len) {
+    fwrite(msg, 1, len, stderr);
+}
+
+void DefaultFlush() {
+    fflush(stderr);
+}
+
+/*单生产者（所属线程）单消费者（后台线程）的字节环：
+    head_ 只由生产者推进，tail_ 只由消费者推进；记录不跨越环尾，放不下时在环尾写一条填充记录再从头开始
+*/
+struct Ring {
+    Ring() : buf(new char[kRingBytes]), tid(static_cast<int>(::syscall(SYS_gettid))) {}
+
+    std::unique_ptr<char[]> buf;
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    uint64_t cached_tail = 0;         // 生产者缓存的 tail，减少跨核读取
+    int tid;
+    std::atomic<bool> retired{false}; // 所属线程已退出，排空后由后台线程回收
+};
+
+class Backend {
+public:
+    Backend() {
+        std::atexit([]() { Instance().Stop(); });
+    }
+
+    // 永不析构：其他静态对象析构时仍可能打日志
+    static Backend& Instance() {
+        static Backend* backend = new Backend;
+        return *backend;
+    }
+
+    std::shared_ptr<Ring> Register() {
+        auto ring = std::make_shared<Ring>();
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.push_back(ring);
+        if (!started_ && !stopped_) {
+            started_ = true;
+            thread_ = std::thread([this]() { ThreadFunc(); });
+        }
+        return ring;
+    }
+
+    void Flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!started_ || stopped_) return;
+        uint64_t target = ++flush_requested_;
+        cond_.notify_all();
+        done_cond_.wait(lock, [&]() { return flush_done_ >= target || stopped_; });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) return;
+            stopped_ = true;
+            cond_.notify_all();
+        }
+        if (thread_.joinable()) thread_.join();
+        DrainAll();   // 线程退出后再排空一次，之后的日志直接同步输出
+    }
+
+    bool stopped() const { return stopped_.load(std::memory_order_acquire); }
+
+    // 生产者的环超过半满时调用：提前唤醒后台线程，不必等到下一次轮询
+    void Wakeup() {
+        if (!wakeup_pending_.exchange(true, std::memory_order_relaxed)) {
+            cond_.notify_one();
+        }
+    }
+
+    // SetOutput/SetFlush 可能与后台线程（或退出阶段同步输出的线程）并发，函数指针用原子变量
+    std::atomic<OutputFunc> output{DefaultOutput};
+    std::atomic<FlushFunc> flush{DefaultFlush};
+    std::atomic<uint64_t> dropped{0};
+
+    void Format(const RecordHeader& h, const char* args, int tid, std::string* line);
+
+private:
+    void ThreadFunc() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopped_) {
+            uint64_t target = flush_requested_;
+            wakeup_pending_.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            DrainAll();
+            lock.lock();
+            flush_done_ = target;
+            done_cond_.notify_all();
+            if (flush_requested_ == target && !stopped_ &&
+                !wakeup_pending_.load(std::memory_order_relaxed)) {
+                cond_.wait_for(lock, std::chrono::milliseconds(kPollIntervalMs));
+            }
+        }
+    }
+
+    void DrainAll() {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rings = rings_;
+        }
+        out_.clear();
+        for (const auto& ring : rings) {
+            Drain(ring.get());
+        }
+        uint64_t dropped_now = dropped.load(std::memory_order_relaxed);
+        if (dropped_now != reported_dropped_) {
+            char msg[96];
+            int n = snprintf(msg, sizeof(msg), "rpclog: %llu records dropped (ring buffer full)\n",
+                             static_cast<unsigned long long>(dropped_now - reported_dropped_));
+            out_.append(msg, n);
+            reported_dropped_ = dropped_now;
+        }
+        if (!out_.empty()) {
+            output.load(std::memory_order_acquire)(out_.data(), out_.size());
+            flush.load(std::memory_order_acquire)();
+        }
+        if (out_.capacity() > kRingBytes) {
+            std::string().swap(out_);
+        }
+
+        // 回收已退出线程的空环
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < rings_.size();) {
+            Ring* r = rings_[i].get();
+            if (r->retired.load(std::memory_order_acquire) &&
+                r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire)) {
+                rings_[i] = rings_.back();
+                rings_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    void Drain(Ring* ring) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        while (tail != head) {
+            const char* p = ring->buf.get() + (tail & (kRingBytes - 1));
+            RecordHeader h;
+            std::memcpy(&h, p, sizeof(uint32_t) + sizeof(uint8_t));   // size + level 总是存在
+            if (h.level != kPadding) {
+                std::memcpy(&h, p, sizeof(h));
+                Format(h, p + sizeof(h), ring->tid, &out_);
+            }
+            tail += h.size;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable done_cond_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::thread thread_;
+    bool started_ = false;
+    std::atomic<bool> stopped_{false};
+    std::atomic<bool> wakeup_pending_{false};
+    uint64_t flush_requested_ = 0;
+    uint64_t flush_done_ = 0;
+    uint64_t reported_dropped_ = 0;
+    std::string out_;    // 一批格式化好的日志行
+};
+
+void AppendArg(const char** args, std::string* line) {
+    const char* p = *args;
+    ArgType type = static_cast<ArgType>(*p++);
+    char num[32];
+    int n = 0;
+    switch (type) {
+    case ArgType::kInt: {
+        int64_t v;
+        std::memcpy(&v, p, 8);
+        p += 8;
+        n = snprintf(num, sizeof(num), "%lld", static_cast<long long>(v));
+        break;
+    }
+    case ArgType::kUint: {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        p += 8;
+        n = snprintf(num, sizeof(num), "%llu", static_cast<unsigned long long>(v));
+        break;
+    }
+    case ArgType::kDouble: {
+        double v;
+        std::memcpy(&v, p, 8);
+        p += 8;
+        n = snprintf(num, sizeof(num), "%g", v);
+        break;
+    }
+    case ArgType::kString: {
+        uint32_t len;
+        std::memcpy(&len, p, 4);
+        line->append(p + 4, len);
+        p += 4 + len;
+        break;
+    }
+    }
+    if (n > 0) line->append(num, n);
+    *args = p;
+}
+
+// 每个线程一个环；线程退出时只做标记，环由后台线程排空后回收
+struct ThreadRing {
+    std::shared_ptr<Ring> ring;
+    ~ThreadRing() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+thread_local ThreadRing t_ring;
+
+// 后台线程已停止（进程退出阶段）时，记录写到这里并在 Commit 中同步输出
+thread_local std::string t_sync_buf;
+thread_local bool t_sync = false;
+
+// 同一秒内的记录复用已格式化的日期时间。按线程缓存：退出阶段多个线程可能同时同步格式化
+struct TimeCache {
+    time_t sec = -1;
+    char text[32] = {};
+};
+thread_local TimeCache t_time_cache;
+
+} // namespace
+
+// 格式：20261017 12:00:00.123456 12345 INFO  message - file.cc:42
+void Backend::Format(const RecordHeader& h, const char* args, int tid, std::string* line)
+{
+    TimeCache& cache = t_time_cache;
+    time_t sec = static_cast<time_t>(h.time_us / 1000000);
+    if (sec != cache.sec) {
+        struct tm tm_time;
+        gmtime_r(&sec, &tm_time);
+        // 各字段按位宽取模：编译器能推出输出不超过缓冲区（-Wformat-truncation），正常日期不受影响
+        snprintf(cache.text, sizeof(cache.text), "%04u%02u%02u %02u:%02u:%02u",
+                 static_cast<unsigned>(tm_time.tm_year + 1900) % 10000u,
+                 static_cast<unsigned>(tm_time.tm_mon + 1) % 100u,
+                 static_cast<unsigned>(tm_time.tm_mday) % 100u,
+                 static_cast<unsigned>(tm_time.tm_hour) % 100u,
+                 static_cast<unsigned>(tm_time.tm_min) % 100u,
+                 static_cast<unsigned>(tm_time.tm_sec) % 100u);
+        cache.sec = sec;
+    }
+    char head[64];
+    int n = snprintf(head, sizeof(head), "%s.%06d %d %s ",
+                     cache.text, static_cast<int>(h.time_us % 1000000), tid,
+                     h.level < kNumLevels ? kLevelNames[h.level] : "?????");
+    line->append(head, n);
+
+    // 依次替换 {}，多出来的参数追加在末尾
+    int remaining = h.nargs;
+    for (const char* f = h.fmt; *f; ++f) {
+        if (f[0] == '{' && f[1] == '}' && remaining > 0) {
+            AppendArg(&args, line);
+            --remaining;
+            ++f;
+        } else {
+            line->push_back(*f);
+        }
+    }
+    while (remaining-- > 0) {
+        line->push_back(' ');
+        AppendArg(&args, line);
+    }
+
+    const char* base = std::strrchr(h.file, '/');
+    line->append(" - ");
+    line->append(base ? base + 1 : h.file);
+    n = snprintf(head, sizeof(head), ":%u\n", h.line);
+    line->append(head, n);
+}
+
+namespace detail {
+
+int64_t NowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+char* Reserve(size_t size) {
+    Backend& backend = Backend::Instance();
+    if (backend.stopped()) {
+        t_sync_buf.resize(size);
+        t_sync = true;
+        return &t_sync_buf[0];
+    }
+
+    if (!t_ring.ring) {
+        t_ring.ring = backend.Register();
+    }
+    Ring* ring = t_ring.ring.get();
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    size_t offset = head & (kRingBytes - 1);
+    size_t pad = offset + size > kRingBytes ? kRingBytes - offset : 0;
+    size_t need = pad + size;
+
+    if (need > kRingBytes - (head - ring->cached_tail)) {
+        ring->cached_tail = ring->tail.load(std::memory_order_acquire);
+        if (need > kRingBytes - (head - ring->cached_tail)) {
+            backend.dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    if (pad > 0) {
+        // 记录不跨越环尾：剩余空间写一条填充记录，从环头开始写真正的记录
+        RecordHeader filler;
+        filler.size = static_cast<uint32_t>(pad);
+        filler.level = kPadding;
+        std::memcpy(ring->buf.get() + offset, &filler, sizeof(uint32_t) + sizeof(uint8_t));
+        head += pad;
+        ring->head.store(head, std::memory_order_release);
+        offset = 0;
+    }
+    return ring->buf.get() + offset;
+}
+
+void Commit(size_t size) {
+    if (t_sync) {
+        // 进程退出阶段：同步格式化并输出
+        t_sync = false;
+        Backend& backend = Backend::Instance();
+        RecordHeader h;
+        std::memcpy(&h, t_sync_buf.data(), sizeof(h));
+        std::string line;
+        backend.Format(h, t_sync_buf.data() + sizeof(h),
+                       static_cast<int>(::syscall(SYS_gettid)), &line);
+        backend.output.load(std::memory_order_acquire)(line.data(), line.size());
+        backend.flush.load(std::memory_order_acquire)();
+        return;
+    }
+    Ring* ring = t_ring.ring.get();
+    uint64_t head = ring->head.load(std::memory_order_relaxed) + size;
+    ring->head.store(head, std::memory_order_release);
+    if (head - ring->cached_tail > kRingBytes / 2) {
+        ring->cached_tail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->cached_tail > kRingBytes / 2) {
+            Backend::Instance().Wakeup();
+        }
+    }
+}
+
+} // namespace detail
+
+void SetLevel(Level level) {
+    detail::g_level.store(level, std::memory_order_relaxed);
+}
+
+Level GetLevel() {
+    return static_cast<Level>(detail::g_level.load(std::memory_order_relaxed));
+}
+
+void SetOutput(OutputFunc out) {
+    Backend::Instance().output.store(out, std::memory_order_release);
+}
+
+void SetFlush(FlushFunc flush) {
+    Backend::Instance().flush.store(flush, std::memory_order_release);
+}
+
+void Flush() {
+    Backend::Instance().Flush();
+}
+
+uint64_t DroppedCount() {
+    return Backend::Instance().dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace rpclog
@@ -0,0 +1,51 @@
+#include "net/crc32c.h"
+#include <cstring>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace {
+
+#if !defined(__SSE4_2__)
+// 反射多项式 0x82F63B78 的逐字节查找表，首次使用时生成
+struct Crc32cTable {
+    uint32_t t[256];
+    Crc32cTable() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : (c >> 1);
+            }
+            t[i] = c;
+        }
+    }
+};
+#endif
+
+} // namespace
+
+uint32_t Crc32c(const void* data, size_t len, uint32_t crc)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+#if defined(__SSE4_2__)
+    while (len >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = static_cast<uint32_t>(_mm_crc32_u64(crc, v));
+        p += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        --len;
+    }
+#else
+    static const Crc32cTable table;
+    while (len > 0) {
+        crc = table.t[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        --len;
+    }
+#endif
+    return ~crc;
+}
@@ -0,0 +1,159 @@
+#include "net/socket_util.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace sockets {
+
+namespace {
+
+// 填 sockaddr_un，路径超长返回 false（sun_path 只有 108 字节）
+bool MakeUnixAddr(const std::string& path, sockaddr_un* addr, socklen_t* len)
+{
+    if (path.empty() || path.size() >= sizeof(addr->sun_path)) return false;
+    std::memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, path.data(), path.size());
+    *len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+    return true;
+}
+
+} // namespace
+
+int OpenReusePortListener(int port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+    }
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("SO_REUSEPORT failed: ") + std::strerror(err));
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("listen on port " + std::to_string(port) + " failed: " + std::strerror(err));
+    }
+    return fd;
+}
+
+int OpenUnixListener(const std::string& path)
+{
+    sockaddr_un addr;
+    socklen_t addr_len = 0;
+    if (!MakeUnixAddr(path, &addr, &addr_len)) {
+        throw std::runtime_error("invalid unix socket path: " + path);
+    }
+    struct stat st;
+    if (::lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno));
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_len) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::runtime_error("listen on " + path + " failed: " + std::strerror(err));
+    }
+    return fd;
+}
+
+void CloseUnixListener(int fd, const std::string& path)
+{
+    if (fd < 0) return;
+    ::close(fd);
+    ::unlink(path.c_str());
+}
+
+int ConnectUnix(const std::string& path)
+{
+    sockaddr_un addr;
+    socklen_t addr_len = 0;
+    if (!MakeUnixAddr(path, &addr, &addr_len)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    // Unix 域 socket 的 connect 不经过握手，backlog 未满时立即完成；
+    // backlog 满时阻塞 connect 会一直等到服务端 accept（可能卡住调用方的事件循环），非阻塞则立即返回 EAGAIN
+    int ret;
+    do {
+        ret = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), addr_len);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        int err = errno;
+        ::close(fd);
+        errno = err;
+        return -1;
+    }
+    return fd;
+}
+
+std::shared_ptr<int> MakeOwnedFd(int fd)
+{
+    return std::shared_ptr<int>(new int(fd), [](int* p) {
+        if (*p >= 0) ::close(*p);
+        delete p;
+    });
+}
+
+int LocalPort(int fd)
+{
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) return 0;
+    if (addr.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&addr)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<const sockaddr_in*>(&addr)->sin_port);
+}
+
+std::string ToIpPort(const sockaddr_storage& addr)
+{
+    if (addr.ss_family == AF_UNIX) {
+        return std::string("unix:") + reinterpret_cast<const sockaddr_un*>(&addr)->sun_path;
+    }
+    char ip[INET6_ADDRSTRLEN] = {0};
+    int port = 0;
+    if (addr.ss_family == AF_INET6) {
+        const auto* a = reinterpret_cast<const sockaddr_in6*>(&addr);
+        ::inet_ntop(AF_INET6, &a->sin6_addr, ip, sizeof(ip));
+        port = ntohs(a->sin6_port);
+    } else {
+        const auto* a = reinterpret_cast<const sockaddr_in*>(&addr);
+        ::inet_ntop(AF_INET, &a->sin_addr, ip, sizeof(ip));
+        port = ntohs(a->sin_port);
+    }
+    return std::string(ip) + ":" + std::to_string(port);
+}
+
+std::string PeerIpPort(int fd)
+{
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    if (::getpeername(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) return "unknown";
+    return ToIpPort(addr);
+}
+
+} // namespace sockets
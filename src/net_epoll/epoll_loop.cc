@@ -0,0 +1,134 @@
+#include "net_epoll/epoll_loop.h"
+#include "log/logging.h"
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr size_t kInitEvents = 256;
+}
+
+EpollLoop::EpollLoop()
+    : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)),
+      wakeup_fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      events_(kInitEvents)
+{
+    if (epoll_fd_ < 0 || wakeup_fd_ < 0) {
+        throw std::runtime_error(std::string("EpollLoop init failed: ") + std::strerror(errno));
+    }
+    // wakeup fd 的 data.ptr 为空，与连接区分
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.ptr = nullptr;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev);
+}
+
+EpollLoop::~EpollLoop()
+{
+    ::close(wakeup_fd_);
+    ::close(epoll_fd_);
+}
+
+void EpollLoop::Loop()
+{
+    thread_id_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    while (!quit_.load(std::memory_order_acquire)) {
+        int n = ::epoll_wait(epoll_fd_, events_.data(), static_cast<int>(events_.size()), -1);
+        if (n < 0) {
+            if (errno != EINTR) {
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "epoll_wait failed: {}", std::strerror(errno));
+            }
+            continue;
+        }
+        for (int i = 0; i < n; ++i) {
+            auto* handler = static_cast<EpollHandler*>(events_[i].data.ptr);
+            if (handler) {
+                handler->HandleEvents(events_[i].events);
+            } else {
+                DrainWakeup();
+            }
+        }
+        if (static_cast<size_t>(n) == events_.size()) {
+            events_.resize(events_.size() * 2);   // 一轮就绪的 fd 填满了数组：扩容
+        }
+        DoPendingFunctors();
+    }
+    DoPendingFunctors();
+}
+
+void EpollLoop::Quit()
+{
+    quit_.store(true, std::memory_order_release);
+    if (!IsInLoopThread()) {
+        Wakeup();
+    }
+}
+
+void EpollLoop::RunInLoop(Functor cb)
+{
+    if (IsInLoopThread()) {
+        cb();
+    } else {
+        QueueInLoop(std::move(cb));
+    }
+}
+
+void EpollLoop::QueueInLoop(Functor cb)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(cb));
+    }
+    // 本线程处理事件期间投递的任务在本轮末尾执行，无需唤醒；
+    // 正在执行任务时投递的新任务要到下一轮才执行，必须唤醒，否则会卡在 epoll_wait
+    if (!IsInLoopThread() || calling_functors_) {
+        Wakeup();
+    }
+}
+
+bool EpollLoop::Add(int fd, uint32_t events, EpollHandler* handler)
+{
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.ptr = handler;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "epoll_ctl ADD fd={} failed: {}", fd, std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void EpollLoop::Remove(int fd)
+{
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void EpollLoop::Wakeup()
+{
+    uint64_t one = 1;
+    ssize_t n = ::write(wakeup_fd_, &one, sizeof(one));
+    (void)n;   // 计数器溢出前读端一定已经读走，EAGAIN 也意味着已有未处理的唤醒
+}
+
+void EpollLoop::DrainWakeup()
+{
+    uint64_t value = 0;
+    ssize_t n = ::read(wakeup_fd_, &value, sizeof(value));
+    (void)n;
+}
+
+void EpollLoop::DoPendingFunctors()
+{
+    std::vector<Functor> functors;
+    calling_functors_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        functors.swap(pending_);
+    }
+    for (const Functor& f : functors) {
+        f();
+    }
+    calling_functors_ = false;
+}
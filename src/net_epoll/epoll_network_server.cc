@@ -0,0 +1,202 @@
+#include "net_epoll/epoll_network_server.h"
+#include "net_epoll/epoll_loop.h"
+#include "net_epoll/epoll_rpc_connection.h"
+#include "net/socket_util.h"
+#include "log/logging.h"
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// 一个 IO 线程：自己的事件循环 + 自己的 SO_REUSEPORT 监听 socket + 自己接受的连接
+struct EpollNetworkServer::IoThread : public EpollHandler {
+    // Unix 域监听 socket 的事件入口（只注册在第 0 个 IO 线程）
+    struct UnixAcceptor : public EpollHandler {
+        IoThread* owner = nullptr;
+        void HandleEvents(uint32_t) override { owner->AcceptAll(owner->server->unix_listen_fd_, false); }
+    };
+
+    EpollNetworkServer* server = nullptr;
+    EpollLoop loop;
+    int listen_fd = -1;
+    int idle_fd = -1;   // 预留的 fd：fd 耗尽（EMFILE）时先关掉它，把待接受的连接 accept 后立即关闭
+    UnixAcceptor unix_acceptor;
+    std::unordered_map<int, std::shared_ptr<EpollRpcConnection>> conns;
+    std::thread thread;
+
+    IoThread() { unix_acceptor.owner = this; }
+
+    ~IoThread() override {
+        if (listen_fd >= 0) ::close(listen_fd);
+        if (idle_fd >= 0) ::close(idle_fd);
+    }
+
+    void HandleEvents(uint32_t) override { AcceptAll(listen_fd, true); }
+
+    // 监听 socket 可读：边沿触发，必须一次 accept 到 EAGAIN
+    void AcceptAll(int fd_to_accept, bool tcp) {
+        while (true) {
+            sockaddr_storage addr{};
+            socklen_t addr_len = sizeof(addr);
+            int fd = ::accept4(fd_to_accept, reinterpret_cast<sockaddr*>(&addr), &addr_len,
+                               SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd >= 0) {
+                if (tcp) {
+                    NewConnection(fd, addr, true);
+                } else {
+                    DispatchUnixConnection(fd, addr);
+                }
+                continue;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+            if ((errno == EMFILE || errno == ENFILE) && idle_fd >= 0) {
+                // 不处理的话这个连接会一直留在 backlog 里，而边沿触发不会再通知
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}, rejecting connection", std::strerror(errno));
+                ::close(idle_fd);
+                int rejected = ::accept(fd_to_accept, nullptr, nullptr);
+                if (rejected >= 0) ::close(rejected);
+                idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if (rejected >= 0) continue;
+                break;
+            }
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}", std::strerror(errno));
+            break;
+        }
+    }
+
+    // 轮流交给各 IO 线程（包括自己）
+    void DispatchUnixConnection(int fd, const sockaddr_storage& addr) {
+        auto& threads = server->threads_;
+        IoThread* target = threads[server->next_unix_thread_++ % threads.size()].get();
+        if (target == this) {
+            NewConnection(fd, addr, false);
+            return;
+        }
+        std::shared_ptr<int> owned = sockets::MakeOwnedFd(fd);
+        target->loop.QueueInLoop([target, owned, addr]() {
+            int conn_fd = *owned;
+            *owned = -1;
+            target->NewConnection(conn_fd, addr, false);
+        });
+    }
+
+    void NewConnection(int fd, const sockaddr_storage& addr, bool tcp) {
+        if (tcp) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // RPC 请求/响应都很小，不能等 Nagle
+        }
+
+        std::string peer = sockets::ToIpPort(addr);
+        RPC_LOG_INFO("New connection from {}", peer);
+        auto conn = std::make_shared<EpollRpcConnection>(&loop, fd, std::move(peer),
+                                                         server->handler_.get(),
+                                                         server->coalesce_max_bytes_,
+                                                         server->framing_);
+        conn->SetCloseCallback([this](int closed_fd) { conns.erase(closed_fd); });
+        if (!conn->Start()) {
+            return;   // 析构时关闭 fd
+        }
+        conns.emplace(fd, std::move(conn));
+    }
+};
+
+EpollNetworkServer::EpollNetworkServer(int port, int io_threads)
+    : port_(port), io_threads_(io_threads > 0 ? io_threads : 1)
+{
+}
+
+EpollNetworkServer::~EpollNetworkServer() = default;
+
+void EpollNetworkServer::SetMessageHandler(std::shared_ptr<MessageHandler> handler){
+    handler_=handler;
+}
+
+void EpollNetworkServer::SetWriteCoalescing(size_t max_pending_bytes){
+    coalesce_max_bytes_=max_pending_bytes;
+}
+
+void EpollNetworkServer::SetFraming(FramingType framing){
+    framing_=framing;
+}
+
+void EpollNetworkServer::SetUnixSocket(const std::string& path){
+    unix_path_=path;
+}
+
+void EpollNetworkServer::Run()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+
+        // 端口为 0 时第一个监听 socket 由内核分配端口，其余的绑定到同一端口
+        int port = port_;
+        for (int i = 0; i < io_threads_; ++i) {
+            auto t = std::make_unique<IoThread>();
+            t->server = this;
+            t->listen_fd = sockets::OpenReusePortListener(port);
+            t->idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (port == 0) port = sockets::LocalPort(t->listen_fd);
+            threads_.push_back(std::move(t));
+        }
+        bound_port_.store(port, std::memory_order_release);
+        RPC_LOG_INFO("EpollNetworkServer listening on port {} with {} io threads", port, io_threads_);
+
+        if (!unix_path_.empty()) {
+            unix_listen_fd_ = sockets::OpenUnixListener(unix_path_);
+            RPC_LOG_INFO("EpollNetworkServer listening on unix:{}", unix_path_);
+        }
+    }
+
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        IoThread* t = threads_[i].get();
+        t->thread = std::thread([this, t]() { RunIoThread(t); });
+    }
+    RunIoThread(threads_[0].get());
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        threads_[i]->thread.join();
+    }
+
+    sockets::CloseUnixListener(unix_listen_fd_, unix_path_);
+    unix_listen_fd_ = -1;
+}
+
+void EpollNetworkServer::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (auto& t : threads_) {
+        t->loop.Quit();
+    }
+}
+
+void EpollNetworkServer::RunIoThread(IoThread* t)
+{
+    bool unix_acceptor = unix_listen_fd_ >= 0 && t == threads_[0].get();
+    bool ok = t->loop.Add(t->listen_fd, EPOLLIN | EPOLLET, t);
+    if (ok && unix_acceptor) {
+        ok = t->loop.Add(unix_listen_fd_, EPOLLIN | EPOLLET, &t->unix_acceptor);
+    }
+    if (ok) {
+        t->loop.Loop();
+    }
+
+    // 退出循环后在同一线程内清理：停止监听、关闭本线程的所有连接
+    if (unix_acceptor) t->loop.Remove(unix_listen_fd_);
+    t->loop.Remove(t->listen_fd);
+    ::close(t->listen_fd);
+    t->listen_fd = -1;
+
+    auto conns = t->conns;   // ForceClose 会通过回调修改 conns
+    for (auto& kv : conns) {
+        kv.second->ForceClose();
+    }
+}
@@ -0,0 +1,292 @@
+#include "net_epoll/epoll_rpc_connection.h"
+#include "net/frame_codec.h"
+#include "log/logging.h"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+constexpr size_t kExtraReadBytes = 64 * 1024;   // readv 的第二段（栈上），避免为偶发大包预先撑大 input_
+constexpr size_t kMaxIdleBuffer = 64 * 1024;    // 空闲时缓冲区超过这个容量就归还内存
+constexpr size_t kMaxIov = 64;                  // SendV 一次 sendmsg 的最大片段数，超过则拷贝进 output_
+}
+
+EpollRpcConnection::EpollRpcConnection(EpollLoop* loop, int fd, std::string peer,
+                                       MessageHandler* handler,
+                                       size_t coalesce_max_bytes,
+                                       FramingType framing)
+    : loop_(loop),
+      fd_(fd),
+      peer_(std::move(peer)),
+      handler_(handler),
+      coalesce_max_bytes_(coalesce_max_bytes),
+      framing_(framing)
+{
+}
+
+EpollRpcConnection::~EpollRpcConnection()
+{
+    if (!closed_.load(std::memory_order_relaxed)) {
+        ::close(fd_);
+    }
+}
+
+bool EpollRpcConnection::Start()
+{
+    return loop_->Add(fd_, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, this);
+}
+
+void EpollRpcConnection::ForceClose()
+{
+    HandleClose();
+}
+
+void EpollRpcConnection::HandleEvents(uint32_t events)
+{
+    // 处理过程中可能关闭连接并从连接表移除，先持有自己
+    auto guard = shared_from_this();
+    if (events & (EPOLLIN | EPOLLPRI | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        // 先把对端关闭前发来的数据读完，再由 read 返回 0/错误 触发关闭；
+        // 已经带着挂断标志时不能靠短读提前返回，否则 EOF 没读到，边沿触发也不会再通知
+        HandleRead((events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0);
+    }
+    if ((events & EPOLLOUT) && !closed_.load(std::memory_order_relaxed)) {
+        Flush();
+    }
+}
+
+void EpollRpcConnection::HandleRead(bool hangup)
+{
+    char extra[kExtraReadBytes];
+    while (!closed_.load(std::memory_order_relaxed)) {
+        size_t writable = input_.Writable();
+        iovec vec[2];
+        vec[0].iov_base = input_.BeginWrite();
+        vec[0].iov_len = writable;
+        vec[1].iov_base = extra;
+        vec[1].iov_len = sizeof(extra);
+        ssize_t n = ::readv(fd_, vec, 2);
+
+        if (n > 0) {
+            ++reads_;
+            size_t got = static_cast<size_t>(n);
+            if (got <= writable) {
+                input_.HasWritten(got);
+            } else {
+                input_.HasWritten(writable);
+                input_.Append(extra, got - writable);
+            }
+            ProcessInput();
+            if (!hangup && got < writable + sizeof(extra)) {
+                break;   // 短读：内核接收缓冲区已读空
+            }
+            continue;
+        }
+        if (n == 0) {
+            HandleClose();
+            return;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Connection {} read error: {}", peer_, std::strerror(errno));
+        HandleClose();
+        return;
+    }
+    if (!closed_.load(std::memory_order_relaxed)) {
+        input_.ShrinkIfIdle(kMaxIdleBuffer);
+    }
+}
+
+void EpollRpcConnection::ProcessInput()
+{
+    // 格式在每次读取上只判断一次，具体格式的拆帧循环在 SplitFrames<Framing> 中展开
+    bool corrupt = false;
+    size_t consumed = 0;
+    switch (framing_) {
+    case FramingType::Varint:
+        consumed = SplitFrames<VarintFraming>(&corrupt);
+        break;
+    case FramingType::Checksum:
+        consumed = SplitFrames<ChecksumFraming>(&corrupt);
+        break;
+    case FramingType::Fixed32:
+    default:
+        consumed = SplitFrames<Fixed32Framing>(&corrupt);
+        break;
+    }
+    bytes_consumed_ += consumed;
+    input_.Retrieve(consumed);
+
+    if (corrupt) {
+        // 前缀非法或校验失败：之后的字节流已无法对齐，只能断开
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} sent a corrupt frame, closing", peer_);
+        HandleClose();
+    }
+}
+
+template <typename Framing>
+size_t EpollRpcConnection::SplitFrames(bool* corrupt)
+{
+    std::shared_ptr<RpcConnection> self = shared_from_this();
+    return BasicFrameCodec<Framing>::OnData(input_.Peek(), input_.Readable(), self,
+        [this](const std::shared_ptr<RpcConnection>& conn, std::string_view frame) {
+        if (closed_.load(std::memory_order_relaxed)) return;   // 上一帧的处理关闭了连接
+        ++frames_;
+        handler_->HandleMessage(conn, frame);
+    }, corrupt);
+}
+
+void EpollRpcConnection::Send(const std::string& data)
+{
+    if (closed_.load(std::memory_order_acquire)) {
+        // 对端断开后，积压的响应会逐条走到这里
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcConnection disconnected, drop response");
+        return;
+    }
+    if (loop_->IsInLoopThread()) {
+        SendInLoop(data.data(), data.size());
+        return;
+    }
+    auto self = shared_from_this();
+    loop_->QueueInLoop([self, data]() { self->SendInLoop(data.data(), data.size()); });
+}
+
+void EpollRpcConnection::SendV(const IoSlice* slices, size_t count)
+{
+    if (closed_.load(std::memory_order_acquire)) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcConnection disconnected, drop response");
+        return;
+    }
+    if (!loop_->IsInLoopThread()) {
+        RpcConnection::SendV(slices, count);   // 拼接成一段后经 Send 投递回 IO 线程
+        return;
+    }
+    SendVInLoop(slices, count);
+}
+
+void EpollRpcConnection::SendInLoop(const char* data, size_t len)
+{
+    if (closed_.load(std::memory_order_relaxed)) return;
+
+    bool coalesce = coalesce_max_bytes_ > 0 && len < coalesce_max_bytes_;
+    if (coalesce || output_.Readable() > 0) {
+        // 合并；或已有积压（合并中 / 上次没写完），追加在后面保证顺序
+        output_.Append(data, len);
+        if (coalesce || flush_scheduled_) AfterAppend();
+        return;   // 上次没写完的积压等可写事件，不必再试一次 write
+    }
+    ssize_t n = WriteDirect(data, len);
+    if (n >= 0 && static_cast<size_t>(n) < len) {
+        output_.Append(data + n, len - n);   // 内核写不下的部分等可写事件
+    }
+}
+
+void EpollRpcConnection::SendVInLoop(const IoSlice* slices, size_t count)
+{
+    if (closed_.load(std::memory_order_relaxed)) return;
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += slices[i].len;
+
+    bool coalesce = coalesce_max_bytes_ > 0 && total < coalesce_max_bytes_;
+    if (coalesce || output_.Readable() > 0 || count > kMaxIov) {
+        for (size_t i = 0; i < count; ++i) {
+            output_.Append(static_cast<const char*>(slices[i].data), slices[i].len);
+        }
+        if (coalesce || flush_scheduled_ || count > kMaxIov) AfterAppend();
+        return;
+    }
+
+    // 输出缓冲区为空：一次 sendmsg 直接从调用方内存写出所有片段
+    iovec iov[kMaxIov];
+    for (size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = const_cast<void*>(slices[i].data);
+        iov[i].iov_len = slices[i].len;
+    }
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    ssize_t n;
+    do {
+        n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Connection {} write error: {}", peer_, std::strerror(errno));
+            HandleClose();
+            return;
+        }
+        n = 0;
+    }
+
+    // 没写完的片段（及某个片段的剩余部分）拷贝进 output_
+    size_t written = static_cast<size_t>(n);
+    for (size_t i = 0; i < count; ++i) {
+        if (written >= slices[i].len) {
+            written -= slices[i].len;
+            continue;
+        }
+        output_.Append(static_cast<const char*>(slices[i].data) + written, slices[i].len - written);
+        written = 0;
+    }
+}
+
+void EpollRpcConnection::AfterAppend()
+{
+    if (coalesce_max_bytes_ == 0 || output_.Readable() >= coalesce_max_bytes_) {
+        Flush();
+        return;
+    }
+    if (!flush_scheduled_) {
+        flush_scheduled_ = true;
+        // IO 线程内 QueueInLoop 不唤醒 epoll，Flush 在本轮事件处理完之后执行
+        auto self = shared_from_this();
+        loop_->QueueInLoop([self]() {
+            self->flush_scheduled_ = false;
+            self->Flush();
+        });
+    }
+}
+
+void EpollRpcConnection::Flush()
+{
+    while (output_.Readable() > 0 && !closed_.load(std::memory_order_relaxed)) {
+        ssize_t n = WriteDirect(output_.Peek(), output_.Readable());
+        if (n <= 0) return;   // 写不下（等可写事件）或已关闭
+        output_.Retrieve(static_cast<size_t>(n));
+    }
+    output_.ShrinkIfIdle(kMaxIdleBuffer);
+}
+
+ssize_t EpollRpcConnection::WriteDirect(const char* data, size_t len)
+{
+    while (true) {
+        // MSG_NOSIGNAL：对端已关闭时返回 EPIPE 而不是触发 SIGPIPE
+        ssize_t n = ::send(fd_, data, len, MSG_NOSIGNAL);
+        if (n >= 0) return n;
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Connection {} write error: {}", peer_, std::strerror(errno));
+        HandleClose();
+        return -1;
+    }
+}
+
+void EpollRpcConnection::HandleClose()
+{
+    if (closed_.exchange(true, std::memory_order_acq_rel)) return;
+
+    auto guard = shared_from_this();   // close_cb_ 会把自己从连接表中移除
+    loop_->Remove(fd_);
+    ::close(fd_);
+    RPC_LOG_INFO("Connection down from {} reads={} frames={} bytes={}",
+                 peer_, reads_, frames_, bytes_consumed_);
+    if (close_cb_) {
+        close_cb_(fd_);
+    }
+}
@@ -1,12 +1,30 @@
 #include "net_muduo/muduo_network_server.h"
 #include <rpc/rpc_meta.pb.h>
 #include <rpc/rpc_codec.h>
+#include "net/socket_util.h"
+#include <muduo/net/Channel.h>
+#include <muduo/net/EventLoopThreadPool.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 using namespace muduo;
 using namespace muduo::net;
 using namespace std::placeholders;
 
+namespace {
+
+// Unix 域连接的名字带 "unix:" 前缀，它们的 InetAddress 只是占位（见 onUnixAccept），日志里用名字
+std::string PeerName(const TcpConnectionPtr& conn) {
+    if (conn->name().compare(0, 5, "unix:") == 0) return conn->name();
+    return conn->peerAddress().toIpPort();
+}
+
+} // namespace
+
 MuduoNetworkServer::MuduoNetworkServer(int port, int io_threads)
 : loop_(),
   server_(&loop_,
@@ -33,11 +51,22 @@ MuduoNetworkServer::MuduoNetworkServer(int port, int io_threads)
     // 4) 这里不要调用 server_.start()，把“启动监听”留给 Run()
 }
 
+MuduoNetworkServer::~MuduoNetworkServer() {
+    // 与 TcpServer 析构相同：连接交还给各自的 IO loop 销毁（server_ 此时还没析构，IO 线程仍在运行）
+    for (auto& kv : unix_conns_) {
+        TcpConnectionPtr conn = kv.second;
+        conn->getLoop()->runInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    }
+    unix_conns_.clear();
+}
+
 void MuduoNetworkServer::Run() {
     //监听端口
     server_.start();
+    if (!unix_path_.empty()) startUnixListener();
     //启动事件循环
     loop_.loop();
+    stopUnixListener();
 }
 
 void MuduoNetworkServer::Stop() {
@@ -48,12 +77,94 @@ void MuduoNetworkServer::SetMessageHandler(std::shared_ptr<MessageHandler> handl
     handler_=handler;
 }
 
+void MuduoNetworkServer::SetWriteCoalescing(size_t max_pending_bytes){
+    coalesce_max_bytes_=max_pending_bytes;
+}
+
+void MuduoNetworkServer::SetFraming(FramingType framing){
+    framing_=framing;
+}
+
+void MuduoNetworkServer::SetUnixSocket(const std::string& path){
+    unix_path_=path;
+}
+
+void MuduoNetworkServer::startUnixListener() {
+    unix_listen_fd_ = sockets::OpenUnixListener(unix_path_);
+    unix_idle_fd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    unix_channel_ = std::make_unique<Channel>(&loop_, unix_listen_fd_);
+    unix_channel_->setReadCallback([this](Timestamp) { onUnixAccept(); });
+    unix_channel_->enableReading();
+    RPC_LOG_INFO("MuduoNetworkServer listening on unix:{}", unix_path_);
+}
+
+void MuduoNetworkServer::stopUnixListener() {
+    if (unix_channel_) {
+        unix_channel_->disableAll();
+        unix_channel_->remove();
+        unix_channel_.reset();
+    }
+    sockets::CloseUnixListener(unix_listen_fd_, unix_path_);
+    unix_listen_fd_ = -1;
+    if (unix_idle_fd_ >= 0) ::close(unix_idle_fd_);
+    unix_idle_fd_ = -1;
+}
+
+void MuduoNetworkServer::onUnixAccept() {
+    // 水平触发：一次最多接受一批，剩下的下一轮再来，避免一直占着主 loop
+    for (int i = 0; i < 64; ++i) {
+        int fd = ::accept4(unix_listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if ((errno == EMFILE || errno == ENFILE) && unix_idle_fd_ >= 0) {
+                // 不处理的话 backlog 里的连接会让主 loop 一直被唤醒
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}, rejecting connection", std::strerror(errno));
+                ::close(unix_idle_fd_);
+                int rejected = ::accept(unix_listen_fd_, nullptr, nullptr);
+                if (rejected >= 0) ::close(rejected);
+                unix_idle_fd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                continue;
+            }
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}", std::strerror(errno));
+            return;
+        }
+
+        EventLoop* io_loop = server_.threadPool()->getNextLoop();
+        std::string name = "unix:" + unix_path_ + "#" + std::to_string(next_unix_conn_id_++);
+        InetAddress placeholder;   // muduo 的地址类型只能表示 IP 地址
+        auto conn = std::make_shared<TcpConnection>(io_loop, name, fd, placeholder, placeholder);
+        unix_conns_[name] = conn;
+        conn->setConnectionCallback([this](const TcpConnectionPtr& c) { onConnection(c); });
+        conn->setMessageCallback([this](const TcpConnectionPtr& c, Buffer* buf, Timestamp ts) {
+            onMessage(c, buf, ts);
+        });
+        conn->setCloseCallback([this](const TcpConnectionPtr& c) { removeUnixConnection(c); });
+        io_loop->runInLoop(std::bind(&TcpConnection::connectEstablished, conn));
+    }
+}
+
+void MuduoNetworkServer::removeUnixConnection(const TcpConnectionPtr& conn) {
+    // 在 IO loop 中被调用：回到主 loop 修改连接表，再回到 IO loop 销毁（同 TcpServer::removeConnection）
+    loop_.runInLoop([this, conn]() {
+        unix_conns_.erase(conn->name());
+        conn->getLoop()->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+    });
+}
+
 void MuduoNetworkServer::onConnection(const TcpConnectionPtr& conn) {
     if (conn->connected()) {
-        LOG_INFO << "New connection from " << conn->peerAddress().toIpPort();
-        conn->setContext(std::string()); // 每个连接一个缓冲区
+        RPC_LOG_INFO("New connection from {}", PeerName(conn));
+        ConnContext ctx;
+        ctx.rpc_conn = std::make_shared<MuduoRpcConnection>(conn, coalesce_max_bytes_, framing_); // 每个连接只创建一次
+        conn->setContext(ctx);
     } else {
-        LOG_INFO << "Connection down from " << conn->peerAddress().toIpPort();
+        const ConnContext* ctx = boost::any_cast<ConnContext>(&conn->getContext());
+        if (ctx) {
+            RPC_LOG_INFO("Connection down from {} reads={} frames={} bytes={}",
+                         PeerName(conn), ctx->reads, ctx->frames, ctx->bytes_consumed);
+        }
+        conn->setContext(boost::any()); // 打破 rpc_conn <-> TcpConnection 的循环引用
         conn->shutdown();
     }
 }
@@ -62,14 +173,52 @@ void MuduoNetworkServer::onMessage(const TcpConnectionPtr& conn,
                                    Buffer* buffer,
                                    Timestamp)
 {
-    std::string& inbuf = *boost::any_cast<std::string>(conn->getMutableContext());
-    inbuf.append(buffer->peek(), buffer->readableBytes());
-    buffer->retrieveAll();
-
     /*OnData会解析出frame（因为要出里半包/粘包问题，所以OnData中是while循环解析，在这里注入“回调函数”，每次解析
         出完整一帧frame，就调用一次“回调函数”进行处理）*/
-    frame_codec_.OnData(inbuf,std::make_shared<MuduoRpcConnection>(conn),
-        [this](const std::shared_ptr<RpcConnection>& conn, const std::string& frame) {
+    /*直接在 muduo 的接收缓冲区上拆帧：frame 是 buffer 内部的视图，不再拷贝到连接上下文中；
+        拆帧结束后只 retrieve 已消费的部分，半包留在 buffer 里等待下一次可读事件*/
+    ConnContext* ctx = boost::any_cast<ConnContext>(conn->getMutableContext());
+    if (!ctx) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} has no context, drop data", conn->name());
+        buffer->retrieveAll();
+        return;
+    }
+    ++ctx->reads;
+
+    // 格式在每次可读事件上只判断一次，具体格式的拆帧循环在 SplitFrames<Framing> 中展开
+    bool corrupt = false;
+    size_t consumed = 0;
+    switch (framing_) {
+    case FramingType::Varint:
+        consumed = SplitFrames<VarintFraming>(ctx, buffer, &corrupt);
+        break;
+    case FramingType::Checksum:
+        consumed = SplitFrames<ChecksumFraming>(ctx, buffer, &corrupt);
+        break;
+    case FramingType::Fixed32:
+    default:
+        consumed = SplitFrames<Fixed32Framing>(ctx, buffer, &corrupt);
+        break;
+    }
+    ctx->bytes_consumed += consumed;
+    buffer->retrieve(consumed);
+
+    if (corrupt) {
+        // 前缀非法或校验失败：之后的字节流已无法对齐，只能断开
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} sent a corrupt frame, closing", conn->name());
+        buffer->retrieveAll();
+        conn->forceClose();
+    }
+}
+
+template <typename Framing>
+size_t MuduoNetworkServer::SplitFrames(ConnContext* ctx, Buffer* buffer, bool* corrupt)
+{
+    // 回调里直接引用上下文中长期存活的 rpc_conn，不产生额外的分配和引用计数
+    return BasicFrameCodec<Framing>::OnData(buffer->peek(), buffer->readableBytes(),
+        ctx->rpc_conn,
+        [this, ctx](const std::shared_ptr<RpcConnection>& conn, std::string_view frame) {
+        ++ctx->frames;
         handler_->HandleMessage(conn, frame);
-    });
+    }, corrupt);
 }
@@ -0,0 +1,102 @@
+#include "net_muduo/muduo_unix_client.h"
+#include "net/socket_util.h"
+#include "log/logging.h"
+#include <muduo/net/InetAddress.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+using namespace muduo;
+using namespace muduo::net;
+
+MuduoUnixClient::MuduoUnixClient(EventLoop* loop, std::string path, std::string name)
+    : loop_(loop), path_(std::move(path)), name_(std::move(name))
+{
+}
+
+MuduoUnixClient::~MuduoUnixClient()
+{
+    if (retry_pending_) loop_->cancel(retry_timer_);
+
+    TcpConnectionPtr conn;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        conn.swap(connection_);
+    }
+    if (conn) {
+        // 同 TcpClient 析构：连接可能比 client 活得久，关闭回调不能再引用 this
+        EventLoop* loop = loop_;
+        loop_->runInLoop([conn, loop]() {
+            conn->setCloseCallback([loop](const TcpConnectionPtr& c) {
+                loop->queueInLoop(std::bind(&TcpConnection::connectDestroyed, c));
+            });
+            conn->forceClose();
+        });
+    }
+}
+
+void MuduoUnixClient::connect()
+{
+    loop_->runInLoop([this]() {
+        connect_ = true;
+        if (!retry_pending_ && !connection()) connectInLoop();
+    });
+}
+
+void MuduoUnixClient::disconnect()
+{
+    loop_->runInLoop([this]() {
+        connect_ = false;
+        if (retry_pending_) {
+            loop_->cancel(retry_timer_);
+            retry_pending_ = false;
+        }
+        TcpConnectionPtr conn = connection();
+        if (conn) conn->shutdown();
+    });
+}
+
+void MuduoUnixClient::connectInLoop()
+{
+    int fd = sockets::ConnectUnix(path_);
+    if (fd < 0) {
+        // EAGAIN（服务端 backlog 已满）也走退避重试，不在事件循环里等待
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "{} connect unix:{} failed: {}, retry in {}s",
+                         name_, path_, std::strerror(errno), retry_delay_s_);
+        retry();
+        return;
+    }
+    retry_delay_s_ = kInitRetryDelaySeconds;
+
+    std::string conn_name = name_ + "-unix:" + path_ + "#" + std::to_string(next_conn_id_++);
+    InetAddress placeholder;   // muduo 的地址类型只能表示 IP 地址
+    auto conn = std::make_shared<TcpConnection>(loop_, conn_name, fd, placeholder, placeholder);
+    conn->setConnectionCallback(connection_callback_);
+    conn->setMessageCallback(message_callback_);
+    conn->setCloseCallback([this](const TcpConnectionPtr& c) { removeConnection(c); });
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connection_ = conn;
+    }
+    conn->connectEstablished();
+}
+
+void MuduoUnixClient::retry()
+{
+    retry_pending_ = true;
+    retry_timer_ = loop_->runAfter(retry_delay_s_, [this]() {
+        retry_pending_ = false;
+        if (connect_) connectInLoop();
+    });
+    retry_delay_s_ = std::min(retry_delay_s_ * 2, kMaxRetryDelaySeconds);
+}
+
+void MuduoUnixClient::removeConnection(const TcpConnectionPtr& conn)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection_ == conn) connection_.reset();
+    }
+    loop_->queueInLoop(std::bind(&TcpConnection::connectDestroyed, conn));
+}
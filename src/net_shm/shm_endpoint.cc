@@ -0,0 +1,195 @@
+#include "net_shm/shm_endpoint.h"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+ShmEndpoint::ShmEndpoint(ShmSegment* segment, ShmSide side, int peer_efd)
+    : in_(&segment->control()->rings[side == kShmServer ? kShmClient : kShmServer]),
+      out_(&segment->control()->rings[side]),
+      in_data_(segment->data(side == kShmServer ? kShmClient : kShmServer)),
+      out_data_(segment->data(side)),
+      capacity_(segment->capacity()),
+      mask_(segment->capacity() - 1),
+      my_waiting_(&segment->control()->waiting[side]),
+      peer_waiting_(&segment->control()->waiting[side == kShmServer ? kShmClient : kShmServer]),
+      peer_efd_(peer_efd)
+{
+}
+
+size_t ShmEndpoint::FreeSpaceLocked()
+{
+    uint64_t tail = out_->tail.load(std::memory_order_relaxed);   // 只有持锁的本端写 tail
+    uint64_t head = out_->head.load(std::memory_order_acquire);   // 对端写，不可信
+    if (tail - head > capacity_) {
+        MarkBroken();
+        return 0;
+    }
+    return capacity_ - static_cast<size_t>(tail - head);
+}
+
+void ShmEndpoint::MarkBroken()
+{
+    if (!broken_.exchange(true, std::memory_order_acq_rel)) {
+        overflow_.clear();   // 持有 send_mutex_ 时才会走到这里
+    }
+}
+
+void ShmEndpoint::WriteLocked(const char* data, size_t len)
+{
+    uint64_t tail = out_->tail.load(std::memory_order_relaxed);
+    std::memcpy(out_data_ + (tail & mask_), data, len);   // 镜像映射：跨过环尾的部分自动落到环头
+}
+
+void ShmEndpoint::PublishLocked(size_t n)
+{
+    uint64_t tail = out_->tail.load(std::memory_order_relaxed);
+    out_->tail.store(tail + n, std::memory_order_release);
+    WakePeer();
+}
+
+void ShmEndpoint::WakePeer()
+{
+    // 与对端 PrepareWait 的“置标志 -> 屏障 -> 检查”配对：两边至少有一边能看到对方的写入
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (peer_waiting_->load(std::memory_order_relaxed) &&
+        peer_waiting_->exchange(0, std::memory_order_relaxed)) {
+        uint64_t one = 1;
+        ssize_t n = ::write(peer_efd_, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+void ShmEndpoint::Send(const IoSlice* slices, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += slices[i].len;
+
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    if (broken()) return;
+    if (overflow_.empty() && FreeSpaceLocked() >= total) {
+        uint64_t tail = out_->tail.load(std::memory_order_relaxed);
+        size_t off = 0;
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(out_data_ + ((tail + off) & mask_), slices[i].data, slices[i].len);
+            off += slices[i].len;
+        }
+        PublishLocked(total);
+        return;
+    }
+    if (broken()) return;   // FreeSpaceLocked 刚发现环已损坏
+    for (size_t i = 0; i < count; ++i) {
+        overflow_.append(static_cast<const char*>(slices[i].data), slices[i].len);
+    }
+    // 先写进能放下的部分，剩下的等对端腾出空间
+    size_t n = std::min(overflow_.size(), FreeSpaceLocked());
+    if (n > 0) {
+        WriteLocked(overflow_.data(), n);
+        PublishLocked(n);
+        overflow_.erase(0, n);
+    }
+}
+
+char* ShmEndpoint::BeginFrame(size_t len)
+{
+    send_mutex_.lock();
+    if (broken() || !overflow_.empty() || FreeSpaceLocked() < len) {
+        send_mutex_.unlock();
+        return nullptr;
+    }
+    reserved_ = len;
+    return out_data_ + (out_->tail.load(std::memory_order_relaxed) & mask_);
+}
+
+void ShmEndpoint::CommitFrame()
+{
+    PublishLocked(reserved_);
+    reserved_ = 0;
+    send_mutex_.unlock();
+}
+
+bool ShmEndpoint::FlushOverflow()
+{
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    if (overflow_.empty()) return true;
+    size_t n = std::min(overflow_.size(), FreeSpaceLocked());
+    if (n > 0) {
+        WriteLocked(overflow_.data(), n);
+        PublishLocked(n);
+        overflow_.erase(0, n);
+        if (overflow_.empty() && overflow_.capacity() > capacity_) {
+            std::string().swap(overflow_);   // 偶发的大突发不长期占内存
+        }
+    }
+    return overflow_.empty();
+}
+
+bool ShmEndpoint::Readable(std::string_view* data)
+{
+    uint64_t head = in_->head.load(std::memory_order_relaxed);    // 只有本端写 head
+    uint64_t tail = in_->tail.load(std::memory_order_acquire);    // 对端写，不可信
+    if (tail - head > capacity_) {
+        broken_.store(true, std::memory_order_release);
+        return false;
+    }
+    *data = std::string_view(in_data_ + (head & mask_), static_cast<size_t>(tail - head));
+    return true;
+}
+
+void ShmEndpoint::Consume(size_t n)
+{
+    if (n == 0) return;
+    uint64_t head = in_->head.load(std::memory_order_relaxed);
+    in_->head.store(head + n, std::memory_order_release);
+    WakePeer();   // 对端可能正因为环满、带着 overflow 在睡
+}
+
+bool ShmEndpoint::HasWork()
+{
+    if (broken()) return true;   // 让所属线程去发现并关闭连接
+    if (in_->tail.load(std::memory_order_acquire) != in_->head.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    return !overflow_.empty() && FreeSpaceLocked() > 0;
+}
+
+bool ShmEndpoint::SpinForWork(int micros)
+{
+    if (micros <= 0) return false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(micros);
+    for (unsigned i = 1;; ++i) {
+        if (HasWork()) return true;
+        if ((i & 63) == 0 && std::chrono::steady_clock::now() >= deadline) return false;   // 读时钟比轮询贵，隔一阵看一次
+        CpuRelax();
+    }
+}
+
+int ShmEndpoint::DefaultBusyPollMicros()
+{
+    return std::thread::hardware_concurrency() > 1 ? 50 : 0;
+}
+
+bool ShmEndpoint::PrepareWait()
+{
+    my_waiting_->store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasWork()) {
+        my_waiting_->store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
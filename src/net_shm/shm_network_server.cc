@@ -0,0 +1,337 @@
+#include "net_shm/shm_network_server.h"
+#include "net_shm/shm_endpoint.h"
+#include "net_shm/shm_segment.h"
+#include "net_epoll/epoll_loop.h"
+#include "net/socket_util.h"
+#include "rpc/rpc_connection.h"
+#include "log/logging.h"
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+constexpr int kMaxBatches = 64;   // 一次处理最多拆这么多批，超过就让出 IO 线程给同线程的其他连接
+}
+
+/*一个共享内存连接：持有 segment、两个 eventfd 和握手 socket
+    - my_efd（服务端 eventfd）注册 EPOLLIN | EPOLLET：客户端看到服务端在睡时写它
+    - 握手 socket 注册 EPOLLIN | EPOLLRDHUP | EPOLLET：客户端不会再写任何数据，有事件即说明对端关闭
+  eventfd 与 segment 在析构时才释放：worker 线程可能还握着 shared_ptr 在发送（发送会写对端 eventfd）
+*/
+class ShmNetworkServer::Connection : public RpcConnection,
+                                     public EpollHandler,
+                                     public std::enable_shared_from_this<Connection> {
+public:
+    using CloseCallback = std::function<void(int sock)>;
+
+    Connection(EpollLoop* loop, int sock, std::unique_ptr<ShmSegment> segment,
+               int my_efd, int peer_efd, MessageHandler* handler,
+               FramingType framing, int busy_poll_us)
+        : loop_(loop),
+          sock_(sock),
+          segment_(std::move(segment)),
+          endpoint_(segment_.get(), kShmServer, peer_efd),
+          my_efd_(my_efd),
+          peer_efd_(peer_efd),
+          handler_(handler),
+          framing_(framing),
+          busy_poll_us_(busy_poll_us)
+    {
+        sock_watcher_.owner = this;
+    }
+
+    ~Connection() override {
+        if (!closed_.load(std::memory_order_relaxed)) ::close(sock_);
+        ::close(my_efd_);
+        ::close(peer_efd_);
+    }
+
+    bool Start() {
+        if (!loop_->Add(my_efd_, EPOLLIN | EPOLLET, this)) return false;
+        if (!loop_->Add(sock_, EPOLLIN | EPOLLRDHUP | EPOLLET, &sock_watcher_)) {
+            loop_->Remove(my_efd_);
+            return false;
+        }
+        Process();   // 交接期间客户端可能已经写了请求
+        return true;
+    }
+
+    void SetCloseCallback(CloseCallback cb) { close_cb_ = std::move(cb); }
+
+    void ForceClose() { HandleClose(); }
+
+    void Send(const std::string& data) override {
+        IoSlice slice{data.data(), data.size()};
+        SendV(&slice, 1);
+    }
+
+    void SendV(const IoSlice* slices, size_t count) override {
+        if (closed_.load(std::memory_order_acquire)) {
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcConnection disconnected, drop response");
+            return;
+        }
+        endpoint_.Send(slices, count);
+    }
+
+    char* BeginFrame(size_t len) override {
+        if (closed_.load(std::memory_order_acquire)) return nullptr;
+        return endpoint_.BeginFrame(len);
+    }
+
+    void CommitFrame() override { endpoint_.CommitFrame(); }
+
+    FramingType GetFraming() const override { return framing_; }
+
+    int sock() const { return sock_; }
+
+    // my_efd 可读：客户端在我们睡眠期间有了进展
+    void HandleEvents(uint32_t) override {
+        uint64_t value;
+        ssize_t n = ::read(my_efd_, &value, sizeof(value));
+        (void)n;
+        endpoint_.ClearWaiting();
+        Process();
+    }
+
+private:
+    struct SockWatcher : public EpollHandler {
+        Connection* owner = nullptr;
+        void HandleEvents(uint32_t) override {
+            auto guard = owner->shared_from_this();
+            owner->HandleClose();
+        }
+    };
+
+    // 处理到无事可做（或用完预算）为止；返回前要么已置睡眠标志，要么已把自己重新排进循环
+    void Process() {
+        auto guard = shared_from_this();
+        for (int batch = 0; batch < kMaxBatches; ++batch) {
+            if (closed_.load(std::memory_order_relaxed)) return;
+            endpoint_.FlushOverflow();
+            if (endpoint_.broken() || !ReadFrames()) {
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000,
+                                 "Shared-memory connection sent a corrupt frame or ring state, closing");
+                HandleClose();
+                return;
+            }
+            if (endpoint_.HasWork() || endpoint_.SpinForWork(busy_poll_us_)) continue;
+            if (endpoint_.PrepareWait()) return;
+        }
+        loop_->QueueInLoop([guard]() { guard->Process(); });
+    }
+
+    bool ReadFrames() {
+        std::shared_ptr<RpcConnection> self = shared_from_this();
+        auto on_frame = [this, &self](std::string_view frame) {
+            if (closed_.load(std::memory_order_relaxed)) return;   // 上一帧的处理关闭了连接
+            ++frames_;
+            handler_->HandleMessage(self, frame);
+        };
+        switch (framing_) {
+        case FramingType::Varint:
+            return endpoint_.ReadFrames<VarintFraming>(on_frame);
+        case FramingType::Checksum:
+            return endpoint_.ReadFrames<ChecksumFraming>(on_frame);
+        case FramingType::Fixed32:
+        default:
+            return endpoint_.ReadFrames<Fixed32Framing>(on_frame);
+        }
+    }
+
+    void HandleClose() {
+        if (closed_.exchange(true, std::memory_order_acq_rel)) return;
+
+        auto guard = shared_from_this();   // close_cb_ 会把自己从连接表中移除
+        loop_->Remove(my_efd_);
+        loop_->Remove(sock_);
+        ::close(sock_);
+        RPC_LOG_INFO("Shared-memory connection down frames={}", frames_);
+        if (close_cb_) {
+            close_cb_(sock_);
+        }
+    }
+
+    EpollLoop* loop_;
+    const int sock_;
+    std::unique_ptr<ShmSegment> segment_;
+    ShmEndpoint endpoint_;
+    const int my_efd_;
+    const int peer_efd_;
+    MessageHandler* handler_;
+    FramingType framing_;
+    int busy_poll_us_;
+
+    SockWatcher sock_watcher_;
+    std::atomic<bool> closed_{false};
+    CloseCallback close_cb_;
+    uint64_t frames_ = 0;
+};
+
+// 一个 IO 线程：自己的事件循环 + 交给它的连接；第 0 个 IO 线程额外负责握手
+struct ShmNetworkServer::IoThread : public EpollHandler {
+    ShmNetworkServer* server = nullptr;
+    EpollLoop loop;
+    int idle_fd = -1;   // 预留的 fd：fd 耗尽（EMFILE）时先关掉它，把待接受的连接 accept 后立即关闭
+    std::unordered_map<int, std::shared_ptr<Connection>> conns;
+    std::thread thread;
+
+    ~IoThread() override {
+        if (idle_fd >= 0) ::close(idle_fd);
+    }
+
+    // 握手监听 socket 可读：边沿触发，必须一次 accept 到 EAGAIN
+    void HandleEvents(uint32_t) override {
+        int listen_fd = server->listen_fd_;
+        while (true) {
+            int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd >= 0) {
+                Handshake(fd);
+                continue;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+            if ((errno == EMFILE || errno == ENFILE) && idle_fd >= 0) {
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}, rejecting connection", std::strerror(errno));
+                ::close(idle_fd);
+                int rejected = ::accept(listen_fd, nullptr, nullptr);
+                if (rejected >= 0) ::close(rejected);
+                idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if (rejected >= 0) continue;
+                break;
+            }
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept4 failed: {}", std::strerror(errno));
+            break;
+        }
+    }
+
+    // 建 segment 和 eventfd，把 fd 发给客户端，再把连接交给下一个 IO 线程
+    void Handshake(int sock) {
+        std::string error;
+        std::unique_ptr<ShmSegment> segment = ShmSegment::Create(server->capacity_, &error);
+        int server_efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        int client_efd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        bool ok = segment && server_efd >= 0 && client_efd >= 0;
+        if (!ok && error.empty()) error = std::string("eventfd: ") + std::strerror(errno);
+        if (ok) {
+            ShmHello hello{};
+            hello.magic = ShmSegment::kMagic;
+            hello.version = ShmSegment::kVersion;
+            hello.framing = static_cast<uint32_t>(server->framing_);
+            hello.capacity = segment->capacity();
+            int fds[3] = {segment->fd(), server_efd, client_efd};
+            ok = shm::SendHello(sock, hello, fds, 3);
+            if (!ok) error = std::string("sendmsg: ") + std::strerror(errno);
+        }
+        if (!ok) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Shared-memory handshake failed: {}", error);
+            if (server_efd >= 0) ::close(server_efd);
+            if (client_efd >= 0) ::close(client_efd);
+            ::close(sock);
+            return;
+        }
+
+        auto& threads = server->threads_;
+        IoThread* target = threads[server->next_thread_++ % threads.size()].get();
+        auto conn = std::make_shared<Connection>(&target->loop, sock, std::move(segment),
+                                                 server_efd, client_efd, server->handler_.get(),
+                                                 server->framing_, server->busy_poll_us_);
+        RPC_LOG_INFO("New shared-memory connection, ring capacity {}", server->capacity_);
+        // 连接对象拥有全部 fd：任务没来得及执行（目标循环已退出）就被丢弃时随之释放
+        target->loop.RunInLoop([target, conn]() { target->AddConnection(conn); });
+    }
+
+    void AddConnection(const std::shared_ptr<Connection>& conn) {
+        conn->SetCloseCallback([this](int sock) { conns.erase(sock); });
+        // 先登记再 Start：Start 里处理交接期间到达的请求时，连接就可能因为对端关闭而被移除
+        conns.emplace(conn->sock(), conn);
+        if (!conn->Start()) {
+            conns.erase(conn->sock());   // 析构时关闭全部 fd
+        }
+    }
+};
+
+ShmNetworkServer::ShmNetworkServer(const std::string& path, int io_threads)
+    : path_(path),
+      io_threads_(io_threads > 0 ? io_threads : 1),
+      capacity_(ShmSegment::kDefaultCapacity),
+      busy_poll_us_(ShmEndpoint::DefaultBusyPollMicros())
+{
+}
+
+ShmNetworkServer::~ShmNetworkServer() = default;
+
+void ShmNetworkServer::SetMessageHandler(std::shared_ptr<MessageHandler> handler){
+    handler_=handler;
+}
+
+void ShmNetworkServer::SetFraming(FramingType framing){
+    framing_=framing;
+}
+
+void ShmNetworkServer::SetCapacity(size_t capacity){
+    capacity_=capacity;
+}
+
+void ShmNetworkServer::SetBusyPollMicros(int micros){
+    busy_poll_us_=micros;
+}
+
+void ShmNetworkServer::Run()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+
+        for (int i = 0; i < io_threads_; ++i) {
+            auto t = std::make_unique<IoThread>();
+            t->server = this;
+            threads_.push_back(std::move(t));
+        }
+        threads_[0]->idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        listen_fd_ = sockets::OpenUnixListener(path_);
+        RPC_LOG_INFO("ShmNetworkServer handshaking on unix:{} with {} io threads", path_, io_threads_);
+    }
+
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        IoThread* t = threads_[i].get();
+        t->thread = std::thread([this, t]() { RunIoThread(t); });
+    }
+    RunIoThread(threads_[0].get());
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        threads_[i]->thread.join();
+    }
+
+    sockets::CloseUnixListener(listen_fd_, path_);
+    listen_fd_ = -1;
+}
+
+void ShmNetworkServer::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (auto& t : threads_) {
+        t->loop.Quit();
+    }
+}
+
+void ShmNetworkServer::RunIoThread(IoThread* t)
+{
+    bool acceptor = t == threads_[0].get();
+    if (!acceptor || t->loop.Add(listen_fd_, EPOLLIN | EPOLLET, t)) {
+        t->loop.Loop();
+    }
+
+    // 退出循环后在同一线程内清理：停止握手、关闭本线程的所有连接
+    if (acceptor) t->loop.Remove(listen_fd_);
+    auto conns = t->conns;   // ForceClose 会通过回调修改 conns
+    for (auto& kv : conns) {
+        kv.second->ForceClose();
+    }
+}
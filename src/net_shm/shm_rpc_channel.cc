@@ -0,0 +1,154 @@
+#include "net_shm/shm_rpc_channel.h"
+#include "net_shm/shm_endpoint.h"
+#include "net_shm/shm_segment.h"
+#include "net/socket_util.h"
+#include "log/logging.h"
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+ShmRpcChannel::ShmRpcChannel(size_t max_pending)
+    : channel_([this](const std::string& data) { Write(data); }, max_pending),
+      busy_poll_us_(ShmEndpoint::DefaultBusyPollMicros())
+{
+}
+
+ShmRpcChannel::~ShmRpcChannel()
+{
+    Close();
+    // 收包线程已退出，调用方也不应再发起调用：此时才释放共享内存和 fd
+    endpoint_.reset();
+    segment_.reset();
+    for (int fd : {sock_, my_efd_, peer_efd_}) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+bool ShmRpcChannel::Connect(const std::string& path, std::string* error)
+{
+    sock_ = sockets::ConnectUnix(path);
+    if (sock_ < 0) {
+        *error = std::string("connect ") + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    ShmHello hello{};
+    int fds[3];
+    if (!shm::RecvHello(sock_, &hello, fds, 3, kHandshakeTimeoutMs)) {
+        *error = "shared-memory handshake failed";
+        return false;
+    }
+    my_efd_ = fds[2];
+    peer_efd_ = fds[1];
+    if (hello.magic != ShmSegment::kMagic || hello.version != ShmSegment::kVersion) {
+        ::close(fds[0]);
+        *error = "shared-memory handshake: version mismatch";
+        return false;
+    }
+    segment_ = ShmSegment::Attach(fds[0], error);
+    if (!segment_) return false;
+    endpoint_ = std::make_unique<ShmEndpoint>(segment_.get(), kShmClient, peer_efd_);
+
+    framing_ = static_cast<FramingType>(hello.framing);
+    channel_.SetFraming(framing_);
+    connected_.store(true, std::memory_order_release);
+
+    reader_ = std::thread([this]() { ReadLoop(); });
+    channel_.StartHandshake();
+    return true;
+}
+
+void ShmRpcChannel::Close()
+{
+    if (!reader_.joinable()) return;
+    stop_.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    ssize_t n = ::write(my_efd_, &one, sizeof(one));
+    (void)n;
+    reader_.join();
+}
+
+void ShmRpcChannel::CallMethod(const google::protobuf::MethodDescriptor* method,
+                               google::protobuf::RpcController* controller,
+                               const google::protobuf::Message* request,
+                               google::protobuf::Message* response,
+                               google::protobuf::Closure* done)
+{
+    channel_.CallMethod(method, controller, request, response, done);
+}
+
+void ShmRpcChannel::Write(const std::string& data)
+{
+    if (!connected_.load(std::memory_order_acquire)) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Shared-memory channel disconnected, drop request");
+        return;
+    }
+    IoSlice slice{data.data(), data.size()};
+    endpoint_->Send(&slice, 1);
+}
+
+bool ShmRpcChannel::ReadFrames()
+{
+    auto on_frame = [this](std::string_view frame) { channel_.OnMessage(frame); };
+    switch (framing_) {
+    case FramingType::Varint:
+        return endpoint_->ReadFrames<VarintFraming>(on_frame);
+    case FramingType::Checksum:
+        return endpoint_->ReadFrames<ChecksumFraming>(on_frame);
+    case FramingType::Fixed32:
+    default:
+        return endpoint_->ReadFrames<Fixed32Framing>(on_frame);
+    }
+}
+
+void ShmRpcChannel::ReadLoop()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::milliseconds(SimpleRpcChannel::kTimerTickMs);
+    auto next_tick = Clock::now() + tick;
+
+    while (!stop_.load(std::memory_order_acquire)) {
+        bool connected = connected_.load(std::memory_order_relaxed);
+        bool busy = false;
+        if (connected) {
+            endpoint_->FlushOverflow();
+            if (endpoint_->broken() || !ReadFrames()) {
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000,
+                                 "Shared-memory server sent a corrupt frame or ring state, disconnecting");
+                connected_.store(false, std::memory_order_release);
+                continue;
+            }
+            busy = endpoint_->HasWork() || endpoint_->SpinForWork(busy_poll_us_);
+        }
+
+        auto now = Clock::now();
+        if (now >= next_tick) {
+            channel_.ExpireTimeouts();
+            next_tick = now + tick;
+        }
+        if (busy) continue;
+        if (connected && !endpoint_->PrepareWait()) continue;
+
+        pollfd fds[2];
+        fds[0] = {my_efd_, POLLIN, 0};
+        fds[1] = {sock_, static_cast<short>(connected ? POLLIN | POLLRDHUP : 0), 0};
+        int ready = ::poll(fds, 2, static_cast<int>(SimpleRpcChannel::kTimerTickMs));
+        if (ready <= 0) continue;   // 超时（检查定时器）或 EINTR
+        if (fds[0].revents & POLLIN) {
+            uint64_t value;
+            ssize_t n = ::read(my_efd_, &value, sizeof(value));
+            (void)n;
+        }
+        if (connected) {
+            endpoint_->ClearWaiting();
+            if (fds[1].revents) {
+                // 服务端关闭前写进环的响应仍然有效，先处理完再断开
+                ReadFrames();
+                RPC_LOG_WARN("Shared-memory server hung up");
+                connected_.store(false, std::memory_order_release);
+            }
+        }
+    }
+}
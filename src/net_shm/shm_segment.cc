@@ -0,0 +1,196 @@
+#include "net_shm/shm_segment.h"
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace {
+
+size_t RoundUpPow2(size_t n) {
+    size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t cap = page;
+    while (cap < n) cap <<= 1;
+    return cap;
+}
+
+std::string ErrnoText(const char* what) {
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+} // namespace
+
+ShmSegment::~ShmSegment()
+{
+    for (char* d : data_) {
+        if (d) ::munmap(d, 2 * capacity_);
+    }
+    if (control_) ::munmap(control_, kControlSize);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::Create(size_t capacity, std::string* error)
+{
+    std::unique_ptr<ShmSegment> seg(new ShmSegment);
+    capacity = RoundUpPow2(capacity);
+    seg->fd_ = ::memfd_create("tiny_rpc_shm", MFD_CLOEXEC);
+    if (seg->fd_ < 0) {
+        *error = ErrnoText("memfd_create");
+        return nullptr;
+    }
+    if (::ftruncate(seg->fd_, static_cast<off_t>(kControlSize + 2 * capacity)) < 0) {
+        *error = ErrnoText("ftruncate");
+        return nullptr;
+    }
+    if (!seg->Map(capacity, error)) return nullptr;
+
+    // memfd 初始全零：原子变量已经是 0，只需写入描述字段
+    ShmControl* c = new (seg->control_) ShmControl;
+    c->magic = kMagic;
+    c->version = kVersion;
+    c->capacity = capacity;
+    for (auto& r : c->rings) {
+        r.tail.store(0, std::memory_order_relaxed);
+        r.head.store(0, std::memory_order_relaxed);
+    }
+    for (auto& w : c->waiting) w.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return seg;
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::Attach(int fd, std::string* error)
+{
+    std::unique_ptr<ShmSegment> seg(new ShmSegment);
+    seg->fd_ = fd;
+
+    void* ctl = ::mmap(nullptr, kControlSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (ctl == MAP_FAILED) {
+        *error = ErrnoText("mmap control");
+        return nullptr;
+    }
+    const auto* c = static_cast<const ShmControl*>(ctl);
+    uint32_t magic = c->magic, version = c->version;
+    size_t capacity = c->capacity;
+    ::munmap(ctl, kControlSize);
+
+    struct stat st;
+    if (magic != kMagic || version != kVersion || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        ::fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) != kControlSize + 2 * capacity) {
+        *error = "invalid shared memory segment";
+        return nullptr;
+    }
+    if (!seg->Map(capacity, error)) return nullptr;
+    return seg;
+}
+
+bool ShmSegment::Map(size_t capacity, std::string* error)
+{
+    capacity_ = capacity;
+    void* ctl = ::mmap(nullptr, kControlSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+    if (ctl == MAP_FAILED) {
+        *error = ErrnoText("mmap control");
+        return false;
+    }
+    control_ = static_cast<ShmControl*>(ctl);
+
+    for (int i = 0; i < 2; ++i) {
+        // 先占住 2 * capacity 的地址空间，再把同一段文件内容 MAP_FIXED 映射到前后两半
+        void* base = ::mmap(nullptr, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            *error = ErrnoText("mmap reserve");
+            return false;
+        }
+        data_[i] = static_cast<char*>(base);
+        off_t offset = static_cast<off_t>(kControlSize + i * capacity);
+        for (int half = 0; half < 2; ++half) {
+            void* p = ::mmap(data_[i] + half * capacity, capacity, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_FIXED | MAP_POPULATE, fd_, offset);
+            if (p == MAP_FAILED) {
+                *error = ErrnoText("mmap ring");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+namespace shm {
+
+bool SendHello(int sock, const ShmHello& hello, const int* fds, int nfds)
+{
+    iovec iov;
+    iov.iov_base = const_cast<ShmHello*>(&hello);
+    iov.iov_len = sizeof(hello);
+
+    alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(int) * 4)] = {};
+    std::memset(ctrl, 0, sizeof(ctrl));
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+    cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type = SCM_RIGHTS;
+    cm->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    std::memcpy(CMSG_DATA(cm), fds, sizeof(int) * nfds);
+
+    ssize_t n;
+    do {
+        n = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    return n == static_cast<ssize_t>(sizeof(hello));
+}
+
+bool RecvHello(int sock, ShmHello* hello, int* fds, int nfds, int timeout_ms)
+{
+    pollfd pfd{sock, POLLIN, 0};
+    int ready;
+    do {
+        ready = ::poll(&pfd, 1, timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) return false;
+
+    iovec iov;
+    iov.iov_base = hello;
+    iov.iov_len = sizeof(*hello);
+    alignas(cmsghdr) char ctrl[CMSG_SPACE(sizeof(int) * 4)] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+
+    ssize_t n;
+    do {
+        n = ::recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return false;   // 出错或对端关闭：msg_control 没有被内核填写，不能遍历
+
+    int received = 0;
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+        if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_RIGHTS) continue;
+        int count = static_cast<int>((cm->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        const char* p = reinterpret_cast<const char*>(CMSG_DATA(cm));
+        for (int i = 0; i < count; ++i) {
+            int fd;
+            std::memcpy(&fd, p + i * sizeof(int), sizeof(int));
+            if (received < nfds) {
+                fds[received] = fd;
+            } else {
+                ::close(fd);
+            }
+            ++received;
+        }
+    }
+    if (n != static_cast<ssize_t>(sizeof(*hello)) || received != nfds || (msg.msg_flags & MSG_CTRUNC)) {
+        for (int i = 0; i < received && i < nfds; ++i) ::close(fds[i]);
+        return false;
+    }
+    return true;
+}
+
+} // namespace shm
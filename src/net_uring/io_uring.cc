@@ -0,0 +1,249 @@
+#include "net_uring/io_uring.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int SysSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int SysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int SysRegister(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// 不能用 br->bufs[i]：较老的内核头文件里 __DECLARE_FLEX_ARRAY 在 C++ 下多出一个空结构体成员，
+// bufs 的偏移变成 8 而不是内核认为的 0，内核永远看不到填进去的缓冲区（recv 一直返回 ENOBUFS）
+io_uring_buf* BufEntry(io_uring_buf_ring* br, unsigned index) {
+    return reinterpret_cast<io_uring_buf*>(br) + index;
+}
+
+} // namespace
+
+IoUring::~IoUring()
+{
+    Close();
+}
+
+int IoUring::Init(unsigned entries)
+{
+    // 依次尝试：单一提交者 + 延迟 task work（6.1+）-> 协作式 task work（5.19+）。
+    // 更老的内核没有 multishot recv（6.0+），即使 ring 建得起来后端也用不了，不再退化
+    const unsigned kFlagSets[] = {
+        IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+        IORING_SETUP_COOP_TASKRUN,
+    };
+    io_uring_params p;
+    int fd = -1;
+    for (unsigned extra : kFlagSets) {
+        std::memset(&p, 0, sizeof(p));
+        p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | extra;
+        p.cq_entries = entries * 4;
+        fd = SysSetup(entries, &p);
+        if (fd >= 0 || errno != EINVAL) break;
+    }
+    if (fd < 0) return -errno;
+    fd_ = fd;
+    setup_flags_ = p.flags;
+
+    sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && cq_ring_size_ > sq_ring_size_) sq_ring_size_ = cq_ring_size_;
+
+    sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        int err = errno;
+        Close();
+        return -err;
+    }
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            cq_ring_ = nullptr;
+            int err = errno;
+            Close();
+            return -err;
+        }
+    }
+    sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        int err = errno;
+        Close();
+        return -err;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_entries_ = p.sq_entries;
+    // SQ 下标数组固定为恒等映射，之后只推进尾指针
+    unsigned* array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    for (unsigned i = 0; i < sq_entries_; ++i) array[i] = i;
+    sqe_tail_ = *sq_tail_;
+
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return 0;
+}
+
+void IoUring::Close()
+{
+    if (sqes_) ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+    if (fd_ >= 0) ::close(fd_);
+    sqes_ = nullptr;
+    cq_ring_ = sq_ring_ = nullptr;
+    fd_ = -1;
+}
+
+io_uring_sqe* IoUring::GetSqe()
+{
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_) {
+        SubmitAndWait(0);   // SQ 满：先让内核取走
+        head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sqe_tail_ - head >= sq_entries_) return nullptr;
+    }
+    io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+    ++sqe_tail_;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int IoUring::SubmitAndWait(unsigned wait_nr)
+{
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    // 按内核还没取走的个数提交（不是本次新发布的个数）：上次提交失败（-EBUSY 等）留下的 SQE 也一起提交
+    unsigned to_submit = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (to_submit == 0 && wait_nr == 0 && !(setup_flags_ & IORING_SETUP_DEFER_TASKRUN)) {
+        return 0;
+    }
+    // DEFER_TASKRUN 下完成事件只在带 GETEVENTS 进入内核时才会产生
+    unsigned flags = (wait_nr > 0 || (setup_flags_ & IORING_SETUP_DEFER_TASKRUN)) ? IORING_ENTER_GETEVENTS : 0;
+    return Enter(to_submit, wait_nr, flags);
+}
+
+bool IoUring::SupportsOp(uint8_t opcode) const
+{
+    constexpr unsigned kProbeOps = 256;
+    std::vector<char> storage(sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op));
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+    if (SysRegister(fd_, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) return false;
+    if (opcode > probe->last_op) return false;
+    const io_uring_probe_op* ops = reinterpret_cast<const io_uring_probe_op*>(probe + 1);
+    return (ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+bool IoUring::KernelAtLeast(int major, int minor)
+{
+    utsname u;
+    int kmajor = 0;
+    int kminor = 0;
+    if (::uname(&u) != 0 || std::sscanf(u.release, "%d.%d", &kmajor, &kminor) != 2) return false;
+    return kmajor > major || (kmajor == major && kminor >= minor);
+}
+
+int IoUring::Enter(unsigned to_submit, unsigned wait_nr, unsigned flags)
+{
+    ++enter_calls_;
+    int ret = SysEnter(fd_, to_submit, wait_nr, flags);
+    return ret < 0 ? -errno : ret;
+}
+
+int IoUring::RegisterBufRing(io_uring_buf_ring* ring, unsigned entries, uint16_t bgid)
+{
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = entries;
+    reg.bgid = bgid;
+    return SysRegister(fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0 ? -errno : 0;
+}
+
+int IoUring::UnregisterBufRing(uint16_t bgid)
+{
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.bgid = bgid;
+    return SysRegister(fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1) < 0 ? -errno : 0;
+}
+
+ProvidedBuffers::~ProvidedBuffers()
+{
+    Unregister();
+    if (br_) ::munmap(br_, br_size_);
+    std::free(data_);
+}
+
+int ProvidedBuffers::Init(IoUring* ring, unsigned count, unsigned buffer_size, uint16_t bgid)
+{
+    ring_ = ring;
+    count_ = count;
+    buffer_size_ = buffer_size;
+    bgid_ = bgid;
+
+    // 环本身必须页对齐
+    br_size_ = count * sizeof(io_uring_buf);
+    void* br = ::mmap(nullptr, br_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (br == MAP_FAILED) return -errno;
+    br_ = static_cast<io_uring_buf_ring*>(br);
+    data_ = static_cast<char*>(std::aligned_alloc(64, static_cast<size_t>(count) * buffer_size));
+    if (!data_) return -ENOMEM;
+
+    int ret = ring_->RegisterBufRing(br_, count, bgid);
+    if (ret < 0) return ret;
+    registered_ = true;
+
+    for (unsigned i = 0; i < count; ++i) {
+        io_uring_buf* buf = BufEntry(br_, (tail_ + i) & (count - 1));
+        buf->addr = reinterpret_cast<uint64_t>(Buffer(static_cast<uint16_t>(i)));
+        buf->len = buffer_size;
+        buf->bid = static_cast<uint16_t>(i);
+    }
+    tail_ = static_cast<uint16_t>(tail_ + count);
+    __atomic_store_n(&br_->tail, tail_, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void ProvidedBuffers::Unregister()
+{
+    if (registered_) {
+        ring_->UnregisterBufRing(bgid_);
+        registered_ = false;
+    }
+}
+
+void ProvidedBuffers::Recycle(uint16_t bid)
+{
+    io_uring_buf* buf = BufEntry(br_, tail_ & (count_ - 1));
+    buf->addr = reinterpret_cast<uint64_t>(Buffer(bid));
+    buf->len = buffer_size_;
+    buf->bid = bid;
+    ++tail_;
+    __atomic_store_n(&br_->tail, tail_, __ATOMIC_RELEASE);
+}
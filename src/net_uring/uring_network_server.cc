@@ -0,0 +1,759 @@
+#include "net_uring/uring_network_server.h"
+#include "net_uring/io_uring.h"
+#include "net/frame_codec.h"
+#include "net/io_buffer.h"
+#include "net/socket_util.h"
+#include "rpc/rpc_connection.h"
+#include "log/logging.h"
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+constexpr unsigned kRingEntries = 1024;
+constexpr unsigned kBufferCount = 1024;        // 每个 IO 线程的接收缓冲区个数（2 的幂）
+constexpr unsigned kBufferSize = 16 * 1024;
+constexpr uint16_t kBufferGroup = 0;
+constexpr int kMaxSubmitRetries = 16;             // MakeRoom 遇到 -EBUSY/-EAGAIN 时最多重试的次数
+constexpr size_t kMaxSendChain = 64;           // 一条 IOSQE_IO_LINK send 链最多几个 send
+constexpr size_t kMaxIdleBuffer = 64 * 1024;   // 空闲时连接输入缓冲区超过这个容量就归还内存
+
+/*user_data 编码：[63..16] 连接编号 | [15..4] send 在链中的下标（accept 为监听 socket 种类） | [3..0] 操作类型*/
+enum OpType : uint64_t {
+    kOpAccept = 1,
+    kOpRecv,
+    kOpSend,
+    kOpWakeup,
+    kOpCancel,
+};
+
+// accept 的监听 socket
+enum ListenerKind : uint64_t {
+    kListenTcp = 0,
+    kListenUnix = 1,
+};
+
+uint64_t MakeUserData(uint64_t conn_id, uint64_t index, OpType op) {
+    return (conn_id << 16) | (index << 4) | op;
+}
+
+} // namespace
+
+/*io_uring 后端的一个连接：只在所属 IO 线程内操作（Send/SendV 除外，它们可以在任意线程调用）
+    - pending_: 还没提交的待发数据块；inflight_: 已作为一条 send 链提交、等待完成的数据块
+      （send 是异步的，数据必须保留到对应 CQE 到达）
+    - 关闭：先取消该 fd 上所有挂起的请求，等 recv 和 send 的 CQE 全部回来后才 close(fd) 并从连接表移除
+*/
+class UringNetworkServer::Connection : public RpcConnection,
+                                       public std::enable_shared_from_this<UringNetworkServer::Connection> {
+public:
+    Connection(IoThread* t, int fd, uint64_t id, std::string peer);
+    ~Connection() override;
+
+    void Send(const std::string& data) override;
+    void SendV(const IoSlice* slices, size_t count) override;
+    FramingType GetFraming() const override;
+
+    void OnRecv(const io_uring_cqe* cqe);
+    void OnSend(const io_uring_cqe* cqe, unsigned index);
+    // 把 pending_ 提交为一条 send 链（上一条链还没完成时什么也不做，完成后会再次调度）
+    void SubmitSends();
+    void StartClose();
+
+    uint64_t id() const { return id_; }
+    const std::string& peer() const { return peer_; }
+    bool dirty_ = false;       // 已在 IoThread::dirty 中等待本轮末尾提交
+    bool recv_armed_ = false;  // multishot recv 仍在内核中
+
+private:
+    void AppendOutput(const IoSlice* slices, size_t count);
+    void OnData(const char* data, size_t len);
+    // 按 Framing 格式拆出 [data, data+len) 中的所有完整帧，返回已消费的字节数
+    template <typename Framing>
+    size_t SplitFrames(const char* data, size_t len, bool* corrupt);
+    size_t Split(const char* data, size_t len, bool* corrupt);
+    void MaybeFinishClose();
+
+    IoThread* t_;
+    const int fd_;
+    const uint64_t id_;
+    const std::string peer_;
+
+    std::atomic<bool> closed_{false};   // 其他线程的 Send 据此直接丢弃
+    bool closing_ = false;
+    bool finished_ = false;
+
+    IoBuffer input_;                    // 只存放跨 recv 的半包
+    std::deque<std::string> pending_;
+    std::vector<std::string> inflight_;
+    std::vector<size_t> sent_;          // inflight_ 中每块已发送的字节数
+    size_t inflight_left_ = 0;          // 还没收到 CQE 的 send 个数
+    int send_error_ = 0;
+
+    uint64_t reads_ = 0;          // 收到数据的 recv 完成次数
+    uint64_t frames_ = 0;         // 拆出的完整帧数
+    uint64_t bytes_consumed_ = 0; // 已被拆帧消费的字节数（含帧前缀）
+};
+
+// 一个 IO 线程：自己的 ring + provided buffer ring + SO_REUSEPORT 监听 socket + 自己接受的连接
+struct UringNetworkServer::IoThread {
+    UringNetworkServer* server = nullptr;
+    IoUring ring;                 // 必须先于 buffers 声明：buffers 析构时要用 ring 注销
+    ProvidedBuffers buffers;
+    int listen_fd = -1;
+    int idle_fd = -1;             // 预留的 fd：fd 耗尽（EMFILE）时先关掉它，把待接受的连接 accept 后立即关闭
+    int wakeup_fd = -1;
+    uint64_t wakeup_value = 0;    // 常驻的 eventfd 读请求的目标
+    std::atomic<bool> quit{false};
+    std::atomic<bool> wakeup_pending{false};
+    std::atomic<std::thread::id> thread_id{};
+
+    std::mutex mutex;
+    std::vector<std::function<void()>> pending;
+
+    std::unordered_map<uint64_t, std::shared_ptr<Connection>> conns;
+    uint64_t next_id = 1;
+    std::vector<std::shared_ptr<Connection>> dirty;   // 本轮有新数据要发的连接
+    std::vector<io_uring_cqe> deferred_cqes;          // MakeRoom 为腾出 CQ 收割到、回到事件循环再处理的 CQE
+    uint64_t cqes = 0;
+    std::thread thread;
+
+    IoThread() : wakeup_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (wakeup_fd < 0) {
+            throw std::runtime_error(std::string("eventfd failed: ") + std::strerror(errno));
+        }
+    }
+    ~IoThread() {
+        if (listen_fd >= 0) ::close(listen_fd);
+        if (idle_fd >= 0) ::close(idle_fd);
+        ::close(wakeup_fd);
+    }
+
+    bool IsInLoopThread() const {
+        return thread_id.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    // 其他线程投递任务；同一轮里多次投递只写一次 eventfd
+    void QueueInLoop(std::function<void()> cb) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(cb));
+        }
+        if (!wakeup_pending.exchange(true, std::memory_order_acq_rel)) {
+            Wakeup();
+        }
+    }
+
+    void Wakeup() {
+        uint64_t one = 1;
+        ssize_t n = ::write(wakeup_fd, &one, sizeof(one));
+        (void)n;
+    }
+
+    void Quit() {
+        quit.store(true, std::memory_order_release);
+        Wakeup();
+    }
+
+    void RunPending() {
+        // 先清标志再取任务：之后投递的任务一定会再次唤醒
+        wakeup_pending.store(false, std::memory_order_release);
+        std::vector<std::function<void()>> functors;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            functors.swap(pending);
+        }
+        for (const auto& f : functors) {
+            f();
+        }
+    }
+
+    /*让 SQ 至少有 n 个空位：先把已准备的提交给内核。
+        CQ 溢出时内核拒绝提交（-EBUSY），-EAGAIN 是暂时的资源不足：收割 CQE 腾出空间后重试，有限次数；
+        收割到的 CQE 只暂存进 deferred_cqes，不在这里处理（调用方可能正处在某个连接的处理中途）。
+        其他错误说明 ring 已不可用，返回 false，由调用方放弃这次操作*/
+    bool MakeRoom(unsigned n) {
+        for (int attempt = 0; ring.SqSpaceLeft() < n; ++attempt) {
+            int ret = ring.SubmitAndWait(0);
+            if (ret >= 0 || ret == -EINTR) continue;
+            if ((ret != -EBUSY && ret != -EAGAIN) || attempt >= kMaxSubmitRetries) {
+                RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "io_uring submit failed: {}", std::strerror(-ret));
+                return false;
+            }
+            ring.ForEachCqe([this](const io_uring_cqe* cqe) { deferred_cqes.push_back(*cqe); });
+        }
+        return true;
+    }
+
+    // 取一个 SQE；SQ 满且提交失败时返回 nullptr
+    io_uring_sqe* GetSqe() {
+        return MakeRoom(1) ? ring.GetSqe() : nullptr;
+    }
+
+    void HandleDeferredCqes() {
+        while (!deferred_cqes.empty()) {
+            std::vector<io_uring_cqe> batch;
+            batch.swap(deferred_cqes);   // 处理过程中可能再次暂存
+            for (const io_uring_cqe& cqe : batch) HandleCqe(&cqe);
+            cqes += batch.size();
+        }
+    }
+
+    int ListenFd(ListenerKind kind) const {
+        return kind == kListenUnix ? server->unix_listen_fd_ : listen_fd;
+    }
+
+    void ArmAccept(ListenerKind kind) {
+        io_uring_sqe* sqe = GetSqe();
+        if (!sqe) {
+            RPC_LOG_ERROR("io_uring: cannot arm accept, no longer accepting on this thread");
+            return;
+        }
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = ListenFd(kind);
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        sqe->user_data = MakeUserData(0, kind, kOpAccept);
+    }
+
+    void ArmWakeup() {
+        io_uring_sqe* sqe = GetSqe();
+        if (!sqe) {
+            RPC_LOG_ERROR("io_uring: cannot arm wakeup eventfd");
+            return;
+        }
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wakeup_fd;
+        sqe->addr = reinterpret_cast<uint64_t>(&wakeup_value);
+        sqe->len = sizeof(wakeup_value);
+        sqe->user_data = MakeUserData(0, 0, kOpWakeup);
+    }
+
+    // 失败时返回 false，调用方关闭连接
+    bool ArmRecv(Connection* conn, int fd) {
+        io_uring_sqe* sqe = GetSqe();
+        if (!sqe) return false;
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = buffers.group();
+        sqe->user_data = MakeUserData(conn->id(), 0, kOpRecv);
+        conn->recv_armed_ = true;
+        return true;
+    }
+
+    // 取消 fd 上所有挂起的请求；拿不到 SQE 时 shutdown 该 socket，挂起的 recv/send 同样会尽快完成
+    void CancelFd(int fd) {
+        io_uring_sqe* sqe = GetSqe();
+        if (!sqe) {
+            ::shutdown(fd, SHUT_RDWR);
+            return;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = fd;
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+        sqe->user_data = MakeUserData(0, 0, kOpCancel);
+    }
+
+    void MarkDirty(const std::shared_ptr<Connection>& conn) {
+        if (!conn->dirty_) {
+            conn->dirty_ = true;
+            dirty.push_back(conn);
+        }
+    }
+
+    void FlushDirty() {
+        if (dirty.empty()) return;
+        std::vector<std::shared_ptr<Connection>> conns_to_flush;
+        conns_to_flush.swap(dirty);
+        for (const auto& conn : conns_to_flush) {
+            conn->dirty_ = false;
+            conn->SubmitSends();
+        }
+    }
+
+    void HandleCqe(const io_uring_cqe* cqe) {
+        OpType op = static_cast<OpType>(cqe->user_data & 0xF);
+        switch (op) {
+        case kOpAccept:
+            OnAccept(cqe);
+            return;
+        case kOpWakeup:
+            if (!quit.load(std::memory_order_relaxed)) ArmWakeup();
+            return;
+        case kOpCancel:
+            return;
+        case kOpRecv:
+        case kOpSend: {
+            auto it = conns.find(cqe->user_data >> 16);
+            if (it == conns.end()) {
+                if (cqe->flags & IORING_CQE_F_BUFFER) {
+                    buffers.Recycle(static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT));
+                }
+                return;
+            }
+            std::shared_ptr<Connection> conn = it->second;   // 处理过程中可能从连接表移除
+            if (op == kOpRecv) {
+                conn->OnRecv(cqe);
+            } else {
+                conn->OnSend(cqe, static_cast<unsigned>((cqe->user_data >> 4) & 0xFFF));
+            }
+            return;
+        }
+        }
+    }
+
+    void OnAccept(const io_uring_cqe* cqe) {
+        ListenerKind kind = static_cast<ListenerKind>((cqe->user_data >> 4) & 0xFFF);
+        bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+        bool quitting = quit.load(std::memory_order_relaxed);
+        if (cqe->res >= 0) {
+            if (quitting) {
+                ::close(cqe->res);
+            } else {
+                if (kind == kListenTcp) {
+                    NewConnection(cqe->res, true);
+                } else {
+                    DispatchUnixConnection(cqe->res);
+                }
+            }
+        } else if ((cqe->res == -EMFILE || cqe->res == -ENFILE) && idle_fd >= 0) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept failed: {}, rejecting connection", std::strerror(-cqe->res));
+            ::close(idle_fd);
+            int rejected = ::accept(ListenFd(kind), nullptr, nullptr);
+            if (rejected >= 0) ::close(rejected);
+            idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        } else if (cqe->res != -ECANCELED) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "accept failed: {}", std::strerror(-cqe->res));
+        }
+        if (!more && !quitting) {
+            ArmAccept(kind);   // multishot 被内核终止（出错、溢出）：重新挂上
+        }
+    }
+
+    // 轮流交给各 IO 线程（包括自己）
+    void DispatchUnixConnection(int fd) {
+        auto& threads = server->threads_;
+        IoThread* target = threads[server->next_unix_thread_++ % threads.size()].get();
+        if (target == this) {
+            NewConnection(fd, false);
+            return;
+        }
+        std::shared_ptr<int> owned = sockets::MakeOwnedFd(fd);
+        target->QueueInLoop([target, owned]() {
+            int conn_fd = *owned;
+            *owned = -1;
+            target->NewConnection(conn_fd, false);
+        });
+    }
+
+    void NewConnection(int fd, bool tcp) {
+        if (tcp) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // RPC 请求/响应都很小，不能等 Nagle
+        }
+
+        std::string peer = sockets::PeerIpPort(fd);
+        RPC_LOG_INFO("New connection from {}", peer);
+        uint64_t id = next_id++;
+        auto conn = std::make_shared<Connection>(this, fd, id, std::move(peer));
+        conns.emplace(id, conn);
+        if (!ArmRecv(conn.get(), fd)) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} cannot arm recv, closing", conn->peer());
+            conn->StartClose();
+        }
+    }
+
+    // 退出循环后：停止接受连接，取消所有连接上挂起的请求，等它们的 CQE 全部回来再销毁 ring
+    void Shutdown() {
+        CancelFd(listen_fd);
+        if (server->unix_listen_fd_ >= 0 && this == server->threads_[0].get()) CancelFd(server->unix_listen_fd_);
+        auto all = conns;
+        for (auto& kv : all) {
+            kv.second->StartClose();
+        }
+        HandleDeferredCqes();
+        while (!conns.empty()) {
+            int ret = ring.SubmitAndWait(1);
+            if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY) break;
+            ring.ForEachCqe([this](const io_uring_cqe* cqe) { HandleCqe(cqe); });
+            HandleDeferredCqes();
+        }
+        buffers.Unregister();
+        ring.Close();
+        ::close(listen_fd);
+        listen_fd = -1;
+    }
+};
+
+UringNetworkServer::Connection::Connection(IoThread* t, int fd, uint64_t id, std::string peer)
+    : t_(t), fd_(fd), id_(id), peer_(std::move(peer))
+{
+}
+
+UringNetworkServer::Connection::~Connection()
+{
+    if (!finished_) ::close(fd_);
+}
+
+FramingType UringNetworkServer::Connection::GetFraming() const
+{
+    return t_->server->framing_;
+}
+
+void UringNetworkServer::Connection::OnRecv(const io_uring_cqe* cqe)
+{
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        recv_armed_ = false;
+    }
+    int res = cqe->res;
+    if (res > 0) {
+        uint16_t bid = static_cast<uint16_t>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        if (!closing_) {
+            OnData(t_->buffers.Buffer(bid), static_cast<size_t>(res));
+        }
+        t_->buffers.Recycle(bid);   // 帧只在 HandleMessage 期间有效，处理完立即归还
+    } else if (res == 0) {
+        StartClose();               // 对端关闭
+    } else if (res == -ENOBUFS) {
+        // 本轮接收缓冲区被用光：已处理的缓冲区都已归还，重新挂上 recv 即可
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "io_uring recv buffers exhausted");
+    } else if (res != -ECANCELED) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Connection {} recv error: {}", peer_, std::strerror(-res));
+        StartClose();
+    }
+
+    if (!recv_armed_ && !closing_ && !t_->ArmRecv(this, fd_)) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} cannot re-arm recv, closing", peer_);
+        StartClose();
+    }
+    MaybeFinishClose();
+}
+
+void UringNetworkServer::Connection::OnData(const char* data, size_t len)
+{
+    ++reads_;
+    bool corrupt = false;
+    if (input_.Readable() == 0) {
+        // 常见情况：没有遗留半包，直接在内核填好的缓冲区上拆帧，只拷贝末尾的半包
+        size_t consumed = Split(data, len, &corrupt);
+        if (!corrupt && consumed < len) {
+            input_.Append(data + consumed, len - consumed);
+        }
+    } else {
+        input_.Append(data, len);
+        size_t consumed = Split(input_.Peek(), input_.Readable(), &corrupt);
+        input_.Retrieve(consumed);
+        input_.ShrinkIfIdle(kMaxIdleBuffer);
+    }
+
+    if (corrupt) {
+        // 前缀非法或校验失败：之后的字节流已无法对齐，只能断开
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} sent a corrupt frame, closing", peer_);
+        StartClose();
+    }
+}
+
+size_t UringNetworkServer::Connection::Split(const char* data, size_t len, bool* corrupt)
+{
+    // 格式在每次接收上只判断一次，具体格式的拆帧循环在 SplitFrames<Framing> 中展开
+    size_t consumed = 0;
+    switch (GetFraming()) {
+    case FramingType::Varint:
+        consumed = SplitFrames<VarintFraming>(data, len, corrupt);
+        break;
+    case FramingType::Checksum:
+        consumed = SplitFrames<ChecksumFraming>(data, len, corrupt);
+        break;
+    case FramingType::Fixed32:
+    default:
+        consumed = SplitFrames<Fixed32Framing>(data, len, corrupt);
+        break;
+    }
+    bytes_consumed_ += consumed;
+    return consumed;
+}
+
+template <typename Framing>
+size_t UringNetworkServer::Connection::SplitFrames(const char* data, size_t len, bool* corrupt)
+{
+    std::shared_ptr<RpcConnection> self = shared_from_this();
+    MessageHandler* handler = t_->server->handler_.get();
+    return BasicFrameCodec<Framing>::OnData(data, len, self,
+        [this, handler](const std::shared_ptr<RpcConnection>& conn, std::string_view frame) {
+        if (closing_) return;   // 上一帧的处理关闭了连接
+        ++frames_;
+        handler->HandleMessage(conn, frame);
+    }, corrupt);
+}
+
+void UringNetworkServer::Connection::Send(const std::string& data)
+{
+    IoSlice slice{data.data(), data.size()};
+    SendV(&slice, 1);
+}
+
+void UringNetworkServer::Connection::SendV(const IoSlice* slices, size_t count)
+{
+    if (closed_.load(std::memory_order_acquire)) {
+        // 对端断开后，积压的响应会逐条走到这里
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcConnection disconnected, drop response");
+        return;
+    }
+    if (t_->IsInLoopThread()) {
+        AppendOutput(slices, count);
+        return;
+    }
+    // 其他线程：拼成一块投递回 IO 线程
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += slices[i].len;
+    std::string data;
+    data.reserve(total);
+    for (size_t i = 0; i < count; ++i) {
+        data.append(static_cast<const char*>(slices[i].data), slices[i].len);
+    }
+    auto self = shared_from_this();
+    t_->QueueInLoop([self, data]() {
+        IoSlice slice{data.data(), data.size()};
+        self->AppendOutput(&slice, 1);
+    });
+}
+
+void UringNetworkServer::Connection::AppendOutput(const IoSlice* slices, size_t count)
+{
+    if (closing_) return;
+
+    // send 是异步的，调用方内存在返回后就失效，这里必须拷贝一份
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += slices[i].len;
+    size_t coalesce = t_->server->coalesce_max_bytes_;
+    std::string* chunk;
+    if (coalesce > 0 && !pending_.empty() && pending_.back().size() + total <= coalesce) {
+        chunk = &pending_.back();   // 写合并：小响应拼进上一块，少一个 send
+    } else {
+        pending_.emplace_back();
+        chunk = &pending_.back();
+        chunk->reserve(total);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        chunk->append(static_cast<const char*>(slices[i].data), slices[i].len);
+    }
+    t_->MarkDirty(shared_from_this());   // 本轮事件处理完后统一提交
+}
+
+void UringNetworkServer::Connection::SubmitSends()
+{
+    if (closing_ || inflight_left_ > 0 || pending_.empty()) return;
+
+    size_t n = std::min(pending_.size(), kMaxSendChain);
+    // 一条链必须在同一次提交里：SQ 剩余空间不够时先把已准备的提交掉，否则 GetSqe 会从链中间截断
+    if (!t_->MakeRoom(static_cast<unsigned>(n))) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Connection {} cannot submit sends, closing", peer_);
+        StartClose();
+        return;
+    }
+    inflight_.clear();
+    for (size_t i = 0; i < n; ++i) {
+        inflight_.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+    }
+    sent_.assign(n, 0);
+    send_error_ = 0;
+    for (size_t i = 0; i < n; ++i) {
+        io_uring_sqe* sqe = t_->GetSqe();
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(inflight_[i].data());
+        sqe->len = static_cast<uint32_t>(inflight_[i].size());
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;   // WAITALL：内核对流式 socket 自动重试短写
+        if (i + 1 < n) sqe->flags = IOSQE_IO_LINK;     // 按顺序执行，前一个失败后面的都被取消
+        sqe->user_data = MakeUserData(id_, i, kOpSend);
+    }
+    inflight_left_ = n;
+}
+
+void UringNetworkServer::Connection::OnSend(const io_uring_cqe* cqe, unsigned index)
+{
+    if (index < sent_.size()) {
+        if (cqe->res > 0) {
+            sent_[index] = static_cast<size_t>(cqe->res);
+        } else if (cqe->res < 0 && cqe->res != -ECANCELED) {
+            send_error_ = cqe->res;
+        }
+    }
+    if (--inflight_left_ > 0) return;
+
+    // 整条链都已完成
+    if (send_error_ != 0 && !closing_) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Connection {} send error: {}", peer_, std::strerror(-send_error_));
+        StartClose();
+    }
+    if (!closing_) {
+        // 没发完的部分（短写，或链上前一个短写导致后面被取消）按原顺序放回 pending_ 头部
+        for (size_t i = inflight_.size(); i-- > 0;) {
+            if (sent_[i] < inflight_[i].size()) {
+                pending_.push_front(inflight_[i].substr(sent_[i]));
+            }
+        }
+        if (!pending_.empty()) {
+            t_->MarkDirty(shared_from_this());
+        }
+    }
+    inflight_.clear();
+    sent_.clear();
+    MaybeFinishClose();
+}
+
+void UringNetworkServer::Connection::StartClose()
+{
+    if (closing_) return;
+    closing_ = true;
+    closed_.store(true, std::memory_order_release);
+    pending_.clear();
+    if (recv_armed_ || inflight_left_ > 0) {
+        t_->CancelFd(fd_);
+    }
+    MaybeFinishClose();
+}
+
+void UringNetworkServer::Connection::MaybeFinishClose()
+{
+    if (!closing_ || finished_ || recv_armed_ || inflight_left_ > 0) return;
+    finished_ = true;
+    ::close(fd_);
+    RPC_LOG_INFO("Connection down from {} reads={} frames={} bytes={}",
+                 peer_, reads_, frames_, bytes_consumed_);
+    t_->conns.erase(id_);
+}
+
+UringNetworkServer::UringNetworkServer(int port, int io_threads)
+    : port_(port), io_threads_(io_threads > 0 ? io_threads : 1)
+{
+}
+
+UringNetworkServer::~UringNetworkServer() = default;
+
+void UringNetworkServer::SetMessageHandler(std::shared_ptr<MessageHandler> handler){
+    handler_=handler;
+}
+
+void UringNetworkServer::SetWriteCoalescing(size_t max_pending_bytes){
+    coalesce_max_bytes_=max_pending_bytes;
+}
+
+void UringNetworkServer::SetFraming(FramingType framing){
+    framing_=framing;
+}
+
+void UringNetworkServer::SetUnixSocket(const std::string& path){
+    unix_path_=path;
+}
+
+void UringNetworkServer::Run()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) return;
+
+        // 端口为 0 时第一个监听 socket 由内核分配端口，其余的绑定到同一端口
+        int port = port_;
+        for (int i = 0; i < io_threads_; ++i) {
+            auto t = std::make_unique<IoThread>();
+            t->server = this;
+            t->listen_fd = sockets::OpenReusePortListener(port);
+            t->idle_fd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (port == 0) port = sockets::LocalPort(t->listen_fd);
+            threads_.push_back(std::move(t));
+        }
+        bound_port_.store(port, std::memory_order_release);
+        RPC_LOG_INFO("UringNetworkServer listening on port {} with {} io threads", port, io_threads_);
+
+        if (!unix_path_.empty()) {
+            unix_listen_fd_ = sockets::OpenUnixListener(unix_path_);
+            RPC_LOG_INFO("UringNetworkServer listening on unix:{}", unix_path_);
+        }
+    }
+
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        IoThread* t = threads_[i].get();
+        t->thread = std::thread([this, t]() { RunIoThread(t); });
+    }
+    RunIoThread(threads_[0].get());
+    for (size_t i = 1; i < threads_.size(); ++i) {
+        threads_[i]->thread.join();
+    }
+    sockets::CloseUnixListener(unix_listen_fd_, unix_path_);
+    unix_listen_fd_ = -1;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!init_error_.empty()) {
+        throw std::runtime_error("io_uring backend unavailable: " + init_error_);
+    }
+}
+
+void UringNetworkServer::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    for (auto& t : threads_) {
+        t->Quit();
+    }
+}
+
+void UringNetworkServer::RunIoThread(IoThread* t)
+{
+    // ring 在使用它的线程里创建（SINGLE_ISSUER 要求提交者就是创建者）
+    t->thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    std::string error;
+    int ret = t->ring.Init(kRingEntries);
+    if (ret < 0) {
+        error = std::string("io_uring_setup: ") + std::strerror(-ret);
+    } else if (!t->ring.SupportsOp(IORING_OP_RECV) || !t->ring.SupportsOp(IORING_OP_ACCEPT) ||
+               !t->ring.SupportsOp(IORING_OP_SEND) || !t->ring.SupportsOp(IORING_OP_ASYNC_CANCEL) ||
+               !IoUring::KernelAtLeast(6, 0)) {
+        // ring 和 buffer ring 在 5.19 上都建得起来，但 multishot recv 每次都以 -EINVAL 完成：必须在这里拒绝
+        error = "multishot recv requires Linux 6.0+";
+    } else if ((ret = t->buffers.Init(&t->ring, kBufferCount, kBufferSize, kBufferGroup)) < 0) {
+        error = std::string("provided buffer ring: ") + std::strerror(-ret);
+    }
+    if (!error.empty()) {
+        RPC_LOG_ERROR("io_uring init failed: {}", error);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            init_error_ = error;
+        }
+        Stop();
+        return;
+    }
+
+    t->ArmAccept(kListenTcp);
+    if (unix_listen_fd_ >= 0 && t == threads_[0].get()) t->ArmAccept(kListenUnix);
+    t->ArmWakeup();
+    while (!t->quit.load(std::memory_order_acquire)) {
+        t->FlushDirty();
+        // 本轮准备的所有 SQE 一次提交，同时等待完成事件
+        ret = t->ring.SubmitAndWait(1);
+        if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "io_uring_enter failed: {}", std::strerror(-ret));
+        }
+        t->HandleDeferredCqes();   // 比 ring 里剩下的更早完成，先处理
+        t->cqes += t->ring.ForEachCqe([t](const io_uring_cqe* cqe) { t->HandleCqe(cqe); });
+        t->RunPending();
+    }
+
+    RPC_LOG_INFO("io_uring loop exit: io_uring_enter={} cqes={}", t->ring.enter_calls(), t->cqes);
+    t->Shutdown();
+}
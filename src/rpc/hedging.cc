@@ -0,0 +1,73 @@
+#include "rpc/hedging.h"
+#include <algorithm>
+#include <cmath>
+
+int LatencyHistogram::BucketOf(int64_t latency_us)
+{
+    uint64_t x = static_cast<uint64_t>(std::max<int64_t>(latency_us, 1));
+    int e = 63 - __builtin_clzll(x);
+    if (e < 2) return static_cast<int>(x);              // 1..3 各占一档
+    if (e > kMaxExponent) return kBuckets - 1;
+    int sub = static_cast<int>((x >> (e - 2)) & (kSubBuckets - 1));
+    return (e - 1) * kSubBuckets + sub;
+}
+
+int64_t LatencyHistogram::UpperBound(int bucket)
+{
+    if (bucket < kSubBuckets) return bucket;
+    int e = bucket / kSubBuckets + 1;
+    int sub = bucket % kSubBuckets;
+    return (static_cast<int64_t>(kSubBuckets + sub + 1) << (e - 2)) - 1;
+}
+
+void LatencyHistogram::Record(int64_t latency_us)
+{
+    counts_[BucketOf(latency_us)].fetch_add(1, std::memory_order_relaxed);
+    if ((records_.fetch_add(1, std::memory_order_relaxed) + 1) % kDecayEvery == 0) {
+        for (auto& c : counts_) {
+            c.store(c.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+        }
+    }
+}
+
+int64_t LatencyHistogram::Quantile(double q) const
+{
+    uint64_t snapshot[kBuckets];
+    uint64_t total = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        snapshot[i] = counts_[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total < kMinSamples) return -1;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total));
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += snapshot[i];
+        if (seen >= target && snapshot[i] != 0) return UpperBound(i);
+    }
+    return UpperBound(kBuckets - 1);
+}
+
+RetryBudget::RetryBudget(double ratio, double max_tokens)
+    : deposit_(static_cast<int64_t>(std::max(ratio, 0.0) * kScale)),
+      max_(static_cast<int64_t>(std::max(max_tokens, 1.0) * kScale))
+{}
+
+void RetryBudget::Deposit()
+{
+    if (deposit_ == 0) return;
+    int64_t cur = tokens_.load(std::memory_order_relaxed);
+    while (cur < max_ &&
+           !tokens_.compare_exchange_weak(cur, std::min(cur + deposit_, max_), std::memory_order_relaxed)) {
+    }
+}
+
+bool RetryBudget::TryWithdraw()
+{
+    int64_t cur = tokens_.load(std::memory_order_relaxed);
+    while (cur >= kScale) {
+        if (tokens_.compare_exchange_weak(cur, cur - kScale, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,278 @@
+#include "rpc/load_balancer.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+void EndpointStats::OnCallFinish(int64_t latency_us, bool failed, int64_t now_us)
+{
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(ewma_mutex_);
+    double ewma = ewma_us_.load(std::memory_order_relaxed);
+    double sample = static_cast<double>(std::max<int64_t>(latency_us, 1));
+    if (failed) sample = std::max(sample, 2 * ewma);
+
+    if (ewma == 0 || sample > ewma) {
+        ewma = sample;   // peak：变慢立即生效
+    } else {
+        double w = std::exp(-static_cast<double>(now_us - ewma_stamp_us_) / kDefaultDecayUs);
+        ewma = ewma * w + sample * (1 - w);
+    }
+    ewma_stamp_us_ = now_us;
+    ewma_us_.store(ewma, std::memory_order_relaxed);
+}
+
+void EndpointStats::OnConnectionUp(int64_t now_us)
+{
+    // 第一条连接建立才算上线；同一后端的其它连接陆续建立不重置 slow-start
+    if (up_connections_.load(std::memory_order_acquire) == 0) {
+        up_since_us_.store(now_us, std::memory_order_relaxed);
+    }
+    up_connections_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void EndpointStats::OnConnectionDown()
+{
+    up_connections_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void EndpointStats::OnLoadReport(uint32_t queue_depth, uint32_t in_flight, uint32_t cpu_permille, int64_t now_us)
+{
+    // 排队的请求已经算在 in_flight 里，再加一次：排队意味着服务端已经饱和，比正在执行的更该避开
+    report_load_.store(in_flight + queue_depth, std::memory_order_relaxed);
+    report_cpu_permille_.store(std::min<uint32_t>(cpu_permille, 1000), std::memory_order_relaxed);
+    report_us_.store(now_us, std::memory_order_release);
+}
+
+double EndpointStats::Concurrency(int64_t now_us) const
+{
+    double local = static_cast<double>(in_flight());
+    int64_t reported_at = report_us_.load(std::memory_order_acquire);
+    if (reported_at == 0 || now_us - reported_at > kLoadReportTtlUs) return local;
+    return std::max(local, static_cast<double>(report_load_.load(std::memory_order_relaxed)));
+}
+
+double EndpointStats::Weight(int64_t now_us, int64_t slow_start_us) const
+{
+    double weight = 1.0;
+    if (slow_start_us > 0) {
+        int64_t elapsed = now_us - up_since_us_.load(std::memory_order_relaxed);
+        if (elapsed < slow_start_us) {
+            double ramp = static_cast<double>(std::max<int64_t>(elapsed, 0)) / slow_start_us;
+            weight = kMinSlowStartWeight + (1 - kMinSlowStartWeight) * ramp;
+        }
+    }
+    int64_t reported_at = report_us_.load(std::memory_order_acquire);
+    if (reported_at != 0 && now_us - reported_at <= kLoadReportTtlUs) {
+        double cpu = report_cpu_permille_.load(std::memory_order_relaxed) / 1000.0;
+        weight *= std::max(1 - cpu, kMinCpuHeadroom);
+    }
+    return weight;
+}
+
+double EndpointStats::Cost(int64_t now_us, int64_t slow_start_us) const
+{
+    double ewma = latency_ewma_us();
+    double n = Concurrency(now_us);
+    double cost = ewma > 0 ? ewma * (n + 1) : kUnknownLatencyUs * n;
+    return cost / Weight(now_us, slow_start_us);
+}
+
+namespace {
+
+// splitmix64 的终结混合：输入相近的值输出也充分打散
+uint64_t Mix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// 每个调用线程一个随机数发生器，种子里混入线程 id，避免各线程选出同样的序列
+uint64_t ThreadRandom()
+{
+    thread_local std::mt19937_64 rng(std::random_device{}() ^
+                                     std::hash<std::thread::id>()(std::this_thread::get_id()));
+    return rng();
+}
+
+/*power-of-two-choices：随机取两个不同的后端，比较 Cost（延迟 EWMA × (在途 + 1) / slow-start 权重）
+  只看两个样本而不是全体最优：各调用线程看到的状态有延迟，全体最优会让它们同时扑向同一个后端（羊群效应），
+  随机两选一既能避开慢后端，又把流量摊开
+*/
+class P2CBalancer : public LoadBalancer {
+public:
+    explicit P2CBalancer(int64_t slow_start_us) : slow_start_us_(slow_start_us) {}
+
+    size_t Pick(const std::vector<EndpointStats*>& candidates, int64_t now_us) override {
+        size_t n = candidates.size();
+        if (n == 1) return 0;
+        uint64_t r = ThreadRandom();
+        size_t a = r % n;
+        size_t b = (r >> 32) % (n - 1);
+        if (b >= a) ++b;
+        double cost_a = candidates[a]->Cost(now_us, slow_start_us_);
+        double cost_b = candidates[b]->Cost(now_us, slow_start_us_);
+        return cost_b < cost_a ? b : a;
+    }
+
+private:
+    int64_t slow_start_us_;
+};
+
+// 在途最少（有新鲜的负载报告时用报告里的并发数）；按权重放大
+class LeastOutstandingBalancer : public LoadBalancer {
+public:
+    explicit LeastOutstandingBalancer(int64_t slow_start_us) : slow_start_us_(slow_start_us) {}
+
+    size_t Pick(const std::vector<EndpointStats*>& candidates, int64_t now_us) override {
+        // 从轮转起点开始扫，负载相同时不会总挑第一个
+        size_t n = candidates.size();
+        size_t start = next_.fetch_add(1, std::memory_order_relaxed);
+        size_t best = start % n;
+        double best_load = 0;
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = (start + i) % n;
+            double load = (candidates[k]->Concurrency(now_us) + 1) / candidates[k]->Weight(now_us, slow_start_us_);
+            if (i == 0 || load < best_load) {
+                best = k;
+                best_load = load;
+            }
+        }
+        return best;
+    }
+
+private:
+    int64_t slow_start_us_;
+    std::atomic<size_t> next_{0};
+};
+
+class RoundRobinBalancer : public LoadBalancer {
+public:
+    size_t Pick(const std::vector<EndpointStats*>& candidates, int64_t) override {
+        return next_.fetch_add(1, std::memory_order_relaxed) % candidates.size();
+    }
+
+private:
+    std::atomic<size_t> next_{0};
+};
+
+} // namespace
+
+std::unique_ptr<LoadBalancer> NewLoadBalancer(LoadBalancePolicy policy, int64_t slow_start_us)
+{
+    switch (policy) {
+    case LoadBalancePolicy::LeastOutstanding:
+        return std::make_unique<LeastOutstandingBalancer>(slow_start_us);
+    case LoadBalancePolicy::RoundRobin:
+        return std::make_unique<RoundRobinBalancer>();
+    case LoadBalancePolicy::ConsistentHash:    // 没有路由键的调用
+    case LoadBalancePolicy::PowerOfTwoChoices:
+    default:
+        return std::make_unique<P2CBalancer>(slow_start_us);
+    }
+}
+
+uint64_t HashRoutingKey(std::string_view key)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return Mix64(h);
+}
+
+ConsistentHashRouter::ConsistentHashRouter(std::vector<EndpointStats*> endpoints, double load_factor)
+    : endpoints_(std::move(endpoints)), load_factor_(load_factor)
+{
+    const size_t n = endpoints_.size();
+    const uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+    table_.assign(n == 0 ? 0 : kTableSize, kEmpty);
+    if (n == 0) return;
+
+    // Maglev 填表：每个后端按自己的排列 (offset + j * skip) % M 轮流认领第一个空表项。
+    // 按地址排序后轮流：endpoint 添加顺序不同的客户端得到同一张表
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return endpoints_[a]->address() < endpoints_[b]->address();
+    });
+    std::vector<uint64_t> offset(n), skip(n), next(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t h = HashRoutingKey(endpoints_[i]->address());
+        offset[i] = h % kTableSize;
+        skip[i] = Mix64(h) % (kTableSize - 1) + 1;
+    }
+    size_t filled = 0;
+    while (filled < kTableSize) {
+        for (size_t i : order) {
+            size_t slot;
+            do {
+                slot = (offset[i] + next[i] * skip[i]) % kTableSize;
+                ++next[i];
+            } while (table_[slot] != kEmpty);
+            table_[slot] = static_cast<uint32_t>(i);
+            if (++filled == kTableSize) break;
+        }
+    }
+}
+
+size_t ConsistentHashRouter::Pick(uint64_t key_hash) const
+{
+    size_t up = 0;
+    size_t total = 0;
+    for (EndpointStats* e : endpoints_) {
+        if (e->available()) {
+            ++up;
+            total += e->in_flight();
+        }
+    }
+    if (up == 0) return kNone;
+    double bound = load_factor_ > 0 ? std::ceil(load_factor_ * (total + 1) / up)
+                                    : std::numeric_limits<double>::infinity();
+
+    // 探测序列上的后端都超出上限时，取其中在途最少的（仍然是这个键的“熟”后端之一）
+    size_t fallback = kNone;
+    uint64_t h = key_hash;
+    for (int probe = 0; probe < kMaxProbes; ++probe) {
+        size_t i = table_[h % table_.size()];
+        EndpointStats* e = endpoints_[i];
+        if (e->available()) {
+            if (e->in_flight() + 1 <= bound) return i;
+            if (fallback == kNone || e->in_flight() < endpoints_[fallback]->in_flight()) fallback = i;
+        }
+        h = Mix64(h);
+    }
+    if (fallback != kNone) return fallback;
+
+    // 探测全落在下线的后端上（大部分后端不可用）：沿表往后找第一个可用的，结果仍由键决定
+    for (size_t k = 1; k < table_.size(); ++k) {
+        size_t i = table_[(key_hash + k) % table_.size()];
+        if (endpoints_[i]->available()) return i;
+    }
+    return kNone;
+}
+
+std::vector<std::string> ReadEndpointsFile(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open endpoints file " + path);
+
+    std::vector<std::string> endpoints;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') continue;
+        size_t end = line.find_last_not_of(" \t\r");
+        endpoints.push_back(line.substr(begin, end - begin + 1));
+    }
+    return endpoints;
+}
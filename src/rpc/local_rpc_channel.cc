@@ -0,0 +1,130 @@
+#include "rpc/local_rpc_channel.h"
+#include "rpc/rpc_server.h"
+#include "rpc/rpc_controller.h"
+#include "net/frame_codec.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+using namespace google::protobuf;
+
+/*Codec 模式下 dispatcher 看到的“连接”：响应帧直接交回 codec_channel_ 解码
+  Send 收到的往往是发送线程复用的编码缓冲区（RpcCodec::ScratchBuffer），而调用方的 done 里可能立刻发起下一次调用、
+  覆盖同一个缓冲区，所以先拷贝一份再拆帧——Codec 模式用于校验和对照，这次拷贝不影响它的用途
+*/
+class LocalRpcChannel::LoopbackConnection : public RpcConnection {
+public:
+    explicit LoopbackConnection(SimpleRpcChannel* channel) : channel_(channel) {}
+
+    void Send(const std::string& data) override {
+        std::string frames(data);
+        FrameCodec::OnData(frames.data(), frames.size(), nullptr,
+            [this](const std::shared_ptr<RpcConnection>&, std::string_view frame) {
+                channel_->OnMessage(frame);
+            });
+    }
+
+private:
+    SimpleRpcChannel* channel_;
+};
+
+// Copy 模式的一次调用：服务端自己的 request / response / controller，完成时拷回调用方
+struct LocalRpcChannel::CopyCall {
+    std::unique_ptr<Message> request;
+    std::unique_ptr<Message> response;
+    SimpleRpcController controller;
+    RpcController* caller_controller = nullptr;
+    Message* caller_response = nullptr;
+    Closure* caller_done = nullptr;
+};
+
+LocalRpcChannel::LocalRpcChannel(std::shared_ptr<RpcDispatcher> dispatcher, Mode mode)
+    : dispatcher_(std::move(dispatcher)), mode_(mode)
+{
+    if (mode_ == Mode::Codec) {
+        codec_channel_ = std::make_unique<SimpleRpcChannel>(
+            [this](const std::string& data) { SendToDispatcher(data); });
+        codec_channel_->SetDefaultTimeout(0);   // 没有驱动 ExpireTimeouts 的事件循环
+        loopback_ = std::make_shared<LoopbackConnection>(codec_channel_.get());
+    }
+}
+
+LocalRpcChannel::LocalRpcChannel(RpcServer* server, Mode mode)
+    : LocalRpcChannel(server->dispatcher(), mode)
+{
+}
+
+LocalRpcChannel::~LocalRpcChannel() = default;
+
+void LocalRpcChannel::CallMethod(const MethodDescriptor* method,
+                                 RpcController* controller,
+                                 const Message* request,
+                                 Message* response,
+                                 Closure* done)
+{
+    if (mode_ == Mode::Codec) {
+        // 第一次调用时才握手：构造 channel 时服务可能还没注册完
+        std::call_once(handshake_once_, [this]() { codec_channel_->StartHandshake(); });
+        codec_channel_->CallMethod(method, controller, request, response, done);
+        return;
+    }
+
+    const MethodEntry* entry = dispatcher_->FindMethod(method);
+    if (!entry) {
+        if (controller) {
+            controller->SetFailed("Unknown method: " + method->full_name());
+        }
+        if (done) done->Run();
+        return;
+    }
+
+    // 业务方法会直接使用 controller：调用方没有提供时走 Copy，由服务端自带一个
+    if (mode_ == Mode::Copy || !controller) {
+        CallCopy(entry, controller, request, response, done);
+        return;
+    }
+
+    // Direct：业务方法必须调用 done；调用方不关心完成时给它一个空闭包
+    entry->service->CallMethod(entry->method, controller, request, response,
+                               done ? done : NewCallback(&DoNothing));
+}
+
+void LocalRpcChannel::CallCopy(const MethodEntry* entry,
+                               RpcController* controller,
+                               const Message* request,
+                               Message* response,
+                               Closure* done)
+{
+    CopyCall* call = new CopyCall;
+    call->request.reset(entry->request_prototype->New());
+    call->request->CopyFrom(*request);
+    call->response.reset(entry->response_prototype->New());
+    call->caller_controller = controller;
+    call->caller_response = response;
+    call->caller_done = done;
+    entry->service->CallMethod(entry->method, &call->controller, call->request.get(), call->response.get(),
+                               NewCallback(&LocalRpcChannel::OnCopyDone, call));
+}
+
+void LocalRpcChannel::OnCopyDone(CopyCall* call)
+{
+    std::unique_ptr<CopyCall> guard(call);
+    if (call->controller.Failed()) {
+        if (call->caller_controller) {
+            call->caller_controller->SetFailed(call->controller.ErrorText());
+        }
+    } else {
+        call->caller_response->CopyFrom(*call->response);
+    }
+    if (call->caller_done) call->caller_done->Run();
+}
+
+void LocalRpcChannel::SendToDispatcher(const std::string& data)
+{
+    // data 是调用线程的编码缓冲区，业务方法同步完成时编码响应会复用它：先拷贝（见 LoopbackConnection）
+    std::string frames(data);
+    std::shared_ptr<RpcConnection> conn = loopback_;
+    FrameCodec::OnData(frames.data(), frames.size(), conn,
+        [this](const std::shared_ptr<RpcConnection>& c, std::string_view frame) {
+            dispatcher_->HandleMessage(c, frame);
+        });
+}
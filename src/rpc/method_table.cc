@@ -0,0 +1,85 @@
+#include "rpc/method_table.h"
+
+using namespace google::protobuf;
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+inline uint64_t FnvAppend(uint64_t h, std::string_view s) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+} // namespace
+
+uint64_t MethodTable::HashName(std::string_view service_name, std::string_view method_name) {
+    uint64_t h = FnvAppend(kFnvOffset, service_name);
+    h = FnvAppend(h, ".");
+    return FnvAppend(h, method_name);
+}
+
+bool MethodTable::AddService(Service* service) {
+    const ServiceDescriptor* desc = service->GetDescriptor();
+    if (HasService(desc->full_name())) {
+        return false;
+    }
+
+    MessageFactory* factory = MessageFactory::generated_factory();
+    for (int i = 0; i < desc->method_count(); ++i) {
+        const MethodDescriptor* method = desc->method(i);
+        MethodEntry entry;
+        entry.service = service;
+        entry.method = method;
+        entry.request_prototype = factory->GetPrototype(method->input_type());
+        entry.response_prototype = factory->GetPrototype(method->output_type());
+        entry.service_name = desc->full_name();
+        entry.method_name = method->name();
+        entry.hash = HashName(entry.service_name, entry.method_name);
+        entry.method_id = static_cast<uint32_t>(entries_.size() + 1);
+        entries_.push_back(std::move(entry));
+    }
+    RebuildIndex();
+    return true;
+}
+
+void MethodTable::RebuildIndex() {
+    size_t bucket_count = 4;
+    while (bucket_count < entries_.size() * 2) bucket_count <<= 1;
+
+    buckets_.assign(bucket_count, -1);
+    bucket_mask_ = bucket_count - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        size_t pos = entries_[i].hash & bucket_mask_;
+        while (buckets_[pos] >= 0) {
+            pos = (pos + 1) & bucket_mask_;
+        }
+        buckets_[pos] = static_cast<int32_t>(i);
+    }
+}
+
+const MethodEntry* MethodTable::Find(std::string_view service_name,
+                                     std::string_view method_name) const {
+    if (entries_.empty()) return nullptr;
+
+    uint64_t h = HashName(service_name, method_name);
+    for (size_t pos = h & bucket_mask_; ; pos = (pos + 1) & bucket_mask_) {
+        int32_t idx = buckets_[pos];
+        if (idx < 0) return nullptr;   // 空桶：不存在
+        const MethodEntry& e = entries_[idx];
+        if (e.hash == h && e.method_name == method_name && e.service_name == service_name) {
+            return &e;
+        }
+    }
+}
+
+bool MethodTable::HasService(std::string_view service_name) const {
+    for (const MethodEntry& e : entries_) {
+        if (e.service_name == service_name) return true;
+    }
+    return false;
+}
@@ -0,0 +1,64 @@
+#include "rpc/pending_call_table.h"
+
+namespace {
+
+size_t RoundUpPowerOfTwo(size_t n) {
+    size_t cap = 2;
+    while (cap < n) cap <<= 1;
+    return cap;
+}
+
+} // namespace
+
+PendingCallTable::PendingCallTable(size_t capacity)
+    : slots_(new Slot[RoundUpPowerOfTwo(capacity)]),
+      mask_(RoundUpPowerOfTwo(capacity) - 1),
+      next_seq_(mask_ + 1)   // 代数从 1 开始，保证 request_id 不会等于 kFree / kBusy
+{}
+
+bool PendingCallTable::Insert(const PendingCall& call, uint64_t* request_id) {
+    // 最多试一圈：每次失败说明该槽仍被更早的调用占用
+    for (size_t attempt = 0; attempt <= mask_; ++attempt) {
+        uint64_t id = next_seq_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[id & mask_];
+
+        uint64_t expected = kFree;
+        if (!slot.state.compare_exchange_strong(expected, kBusy,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+            continue;
+        }
+        slot.call = call;
+        size_.fetch_add(1, std::memory_order_relaxed);
+        slot.state.store(id, std::memory_order_release);   // 发布：此后 Take(id) 才能成功
+        *request_id = id;
+        return true;
+    }
+    return false;
+}
+
+bool PendingCallTable::Take(uint64_t request_id, PendingCall* call) {
+    if (request_id <= kBusy) return false;
+    Slot& slot = slots_[request_id & mask_];
+
+    uint64_t expected = request_id;
+    if (!slot.state.compare_exchange_strong(expected, kBusy,
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        return false;
+    }
+    *call = slot.call;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    slot.state.store(kFree, std::memory_order_release);
+    return true;
+}
+
+void PendingCallTable::TakeAll(std::vector<PendingCall>* calls) {
+    for (size_t i = 0; i <= mask_; ++i) {
+        uint64_t id = slots_[i].state.load(std::memory_order_acquire);
+        if (id > kBusy) {
+            PendingCall call;
+            if (Take(id, &call)) calls->push_back(call);   // 与响应 / 超时并发时只有一方能取走
+        }
+    }
+}
@@ -1,18 +1,59 @@
 #include "rpc/rpc_channel.h"
 #include "rpc/rpc_codec.h"
+#include "rpc/rpc_controller.h"
+#include "log/logging.h"
 
 #include <google/protobuf/descriptor.h>
-#include <iostream>
+#include <algorithm>
+#include <chrono>
 
 using namespace google::protobuf;
 
-SimpleRpcChannel::SimpleRpcChannel(SendFunction send)
-    :send_(std::move(send))
+namespace {
+// 时间轮一圈 512 * 10ms ≈ 5s，覆盖常见超时；更长的超时留在槽里等下一圈
+constexpr size_t kTimerSlots = 512;
+}
+
+SimpleRpcChannel::SimpleRpcChannel(SendFunction send, size_t max_pending)
+    :pending_calls_(max_pending),
+     timer_queue_(pending_calls_.capacity()),
+     timer_wheel_(kTimerSlots, kTimerTickMs, NowMs()),
+     send_(std::move(send))
 {}
 
-uint64_t SimpleRpcChannel::NextRequestId() {
-    // 简单递增，不考虑溢出（生产中可以做更严谨处理）
-    return next_id_++;
+int64_t SimpleRpcChannel::NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SimpleRpcChannel::SetFraming(FramingType framing) {
+    framing_ = framing;
+}
+
+void SimpleRpcChannel::SetLoadReportCallback(LoadReportCallback cb) {
+    load_callback_ = std::move(cb);
+}
+
+void SimpleRpcChannel::SetDefaultTimeout(int64_t timeout_ms) {
+    default_timeout_ms_.store(timeout_ms, std::memory_order_relaxed);
+}
+
+int64_t SimpleRpcChannel::TimeoutFor(RpcController* controller) const {
+    auto* simple = dynamic_cast<SimpleRpcController*>(controller);
+    if (simple && simple->TimeoutMs() != 0) {
+        return simple->TimeoutMs();
+    }
+    return default_timeout_ms_.load(std::memory_order_relaxed);
+}
+
+void SimpleRpcChannel::AddTimer(uint64_t request_id, int64_t deadline_ms) {
+    TimerEntry entry{ request_id, deadline_ms };
+    if (timer_queue_.TryPush(entry)) {
+        return;
+    }
+    // 队列满（ExpireTimeouts 长时间没有被驱动）：退化为直接加锁写时间轮
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    timer_wheel_.Add(request_id, deadline_ms);
 }
 
 void SimpleRpcChannel::CallMethod(const MethodDescriptor* method,
@@ -20,82 +61,305 @@ void SimpleRpcChannel::CallMethod(const MethodDescriptor* method,
                             const Message* request,
                             Message* response,
                             Closure* done)
+{
+    StartCall(method, controller, request, response, done);
+}
+
+uint64_t SimpleRpcChannel::StartCall(const MethodDescriptor* method,
+                                     RpcController* controller,
+                                     const Message* request,
+                                     Message* response,
+                                     Closure* done)
 {
     if (!send_) {
         if (controller) {
             controller->SetFailed("No send function set in RpcChannel");
         }
         if (done) done->Run();
-        return;
+        return 0;
+    }
+
+    // 1. 登记 pending call，同时分配 request_id（无锁）
+    PendingCall call;
+    call.response = response;
+    call.done = done;
+    call.controller = controller;
+    uint64_t req_id = 0;
+    if (!pending_calls_.Insert(call, &req_id)) {
+        if (controller) {
+            controller->SetFailed("Too many pending calls");
+        }
+        if (done) done->Run();
+        return 0;
+    }
+
+    // 2. 编码完整线上帧（单次序列化，复用本线程缓冲区）
+    //    握手协商过编号的方法只带 method_id，否则带服务名/方法名；
+    //    对端支持定长头格式时用定长头，已协商编号的请求不再经过 RpcMeta
+    std::string& out = RpcCodec::ScratchBuffer();
+    if (!EncodeRequest(method, req_id, *request, &out)) {
+        if (pending_calls_.Take(req_id, &call)) {
+            if (controller) {
+                controller->SetFailed("Encode request failed");
+            }
+            if (done) done->Run();
+        }
+        return 0;
+    }
+
+    // 3. 登记超时（超时后由 ExpireTimeouts 完成并移除）
+    int64_t timeout_ms = TimeoutFor(controller);
+    if (timeout_ms > 0) {
+        AddTimer(req_id, NowMs() + timeout_ms);
+    }
+
+    // 4. 发送
+    send_(out);
+    return req_id;
+}
+
+bool SimpleRpcChannel::Cancel(uint64_t request_id)
+{
+    PendingCall call;
+    // 与响应、超时并发时只有一方能取走；时间轮里的条目惰性删除
+    if (!pending_calls_.Take(request_id, &call)) {
+        return false;
+    }
+    if (call.controller) {
+        call.controller->SetFailed("RPC canceled");
+    }
+    if (call.done) {
+        call.done->Run();
+    }
+    return true;
+}
+
+bool SimpleRpcChannel::EncodeRequest(const MethodDescriptor* method,
+                                     uint64_t request_id,
+                                     const Message& request,
+                                     std::string* out) const
+{
+    const MethodIdMap* ids = method_ids_.load(std::memory_order_acquire);
+    MethodIdMap::const_iterator id_it;
+    uint32_t method_id = 0;
+    if (ids && (id_it = ids->find(method)) != ids->end()) {
+        method_id = id_it->second;
+    }
+
+    if (binary_.load(std::memory_order_acquire)) {
+        RpcHeader header;
+        header.request_id = request_id;
+        header.method_id = method_id;
+        header.is_request = true;
+        if (method_id != 0) {
+            return RpcCodec::EncodeBinary(header, nullptr, &request, out, framing_);
+        }
+        rpc::RpcMeta ext;
+        ext.set_service_name(method->service()->full_name());
+        ext.set_method_name(method->name());
+        return RpcCodec::EncodeBinary(header, &ext, &request, out, framing_);
     }
 
-    // 1. 准备 RpcMeta
-    const ServiceDescriptor* svc_desc = method->service();
     rpc::RpcMeta meta;
-    meta.set_service_name(svc_desc->full_name());
-    meta.set_method_name(method->name());
+    if (method_id != 0) {
+        meta.set_method_id(method_id);
+    } else {
+        meta.set_service_name(method->service()->full_name());
+        meta.set_method_name(method->name());
+    }
     meta.set_is_request(true);
+    meta.set_request_id(request_id);
+    return RpcCodec::EncodeMessage(meta, request, out, framing_);
+}
 
-    uint64_t req_id = NextRequestId();
-    meta.set_request_id(static_cast<uint64_t>(req_id));
+void SimpleRpcChannel::StartHandshake()
+{
+    if (!send_ || handshake_in_flight_.exchange(true)) {
+        return;
+    }
 
-    // 2. 编码 frame (meta + body)
-    std::string frame;
-    if (!RpcCodec::EncodeFrame(meta, *request, &frame)) {
-        if (controller) {
-            controller->SetFailed("RpcCodec::EncodeFrame failed");
+    handshake_controller_.Reset();
+    handshake_response_.Clear();
+
+    PendingCall call;
+    call.response = &handshake_response_;
+    call.done = NewCallback(this, &SimpleRpcChannel::OnHandshakeDone,
+                            handshake_generation_.load(std::memory_order_acquire));
+    call.controller = &handshake_controller_;
+    uint64_t req_id = 0;
+    if (!pending_calls_.Insert(call, &req_id)) {
+        delete call.done;
+        handshake_in_flight_.store(false);
+        return;
+    }
+    handshake_request_id_.store(req_id, std::memory_order_release);
+
+    // 握手请求：保留服务名 + 空 body；对端格式未知，总是用旧格式发送
+    rpc::RpcMeta meta;
+    meta.set_service_name(RpcCodec::kHandshakeService);
+    meta.set_is_request(true);
+    meta.set_request_id(req_id);
+
+    std::string& out = RpcCodec::ScratchBuffer();
+    if (!RpcCodec::EncodeHeader(meta, 0, &out, framing_)) {
+        if (pending_calls_.Take(req_id, &call)) {
+            delete call.done;
+            handshake_in_flight_.store(false);
         }
-        if (done) done->Run();
         return;
     }
 
-    // 3. 保存 pending call
+    // 旧服务端不回复握手，不能等到默认超时；默认超时 <= 0 表示使用方不驱动 ExpireTimeouts，不登记
+    int64_t timeout_ms = default_timeout_ms_.load(std::memory_order_relaxed);
+    if (timeout_ms > 0) {
+        AddTimer(req_id, NowMs() + std::min(timeout_ms, kHandshakeTimeoutMs));
+    }
+    send_(out);
+}
+
+void SimpleRpcChannel::ResetHandshake()
+{
+    binary_.store(false, std::memory_order_release);
+    method_ids_.store(nullptr, std::memory_order_release);
+
+    // 还在等的旧握手作废：取走它的调用（不再回调），已经开始执行的回调看到代数变了也不会发布结果。
+    // 之后的 StartHandshake 可以立即发起新的握手，不依赖调用方再 FailPending
+    handshake_generation_.fetch_add(1, std::memory_order_acq_rel);
+    uint64_t req_id = handshake_request_id_.exchange(0, std::memory_order_acq_rel);
+    PendingCall call;
+    if (req_id != 0 && pending_calls_.Take(req_id, &call)) {
+        delete call.done;
+    }
+    handshake_in_flight_.store(false);
+}
+
+void SimpleRpcChannel::OnHandshakeDone(uint64_t generation)
+{
+    if (generation != handshake_generation_.load(std::memory_order_acquire)) {
+        return;   // ResetHandshake 之后才完成的旧握手：对端可能已经换了，结果作废
+    }
+    handshake_in_flight_.store(false);
+    if (handshake_controller_.Failed()) {
+        // 对端不支持握手（新服务端返回 Unknown service，旧服务端不回复而超时）：继续按名字发送
+        RPC_LOG_WARN("RpcChannel: method id handshake failed ({}), fall back to names",
+                     handshake_controller_.ErrorText());
+        return;
+    }
+
+    // 只保留本进程也认识的方法
+    auto ids = std::make_unique<MethodIdMap>();
+    const DescriptorPool* pool = DescriptorPool::generated_pool();
+    for (const rpc::MethodIdEntry& e : handshake_response_.methods()) {
+        const ServiceDescriptor* svc = pool->FindServiceByName(e.service_name());
+        const MethodDescriptor* method = svc ? svc->FindMethodByName(e.method_name()) : nullptr;
+        if (method && e.method_id() != 0) {
+            (*ids)[method] = e.method_id();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(handshake_mutex_);
+    const MethodIdMap* published = nullptr;
+    for (const auto& m : method_id_maps_) {
+        if (*m == *ids) {
+            published = m.get();
+            break;
+        }
+    }
+    if (!published) {
+        published = ids.get();
+        method_id_maps_.push_back(std::move(ids));
+    }
+    method_ids_.store(published, std::memory_order_release);
+    // 对端声明支持的定长头版本不低于本端时才切换，否则继续用旧格式
+    binary_.store(handshake_response_.binary_version() >= RpcCodec::kBinaryVersion,
+                  std::memory_order_release);
+}
+
+// 由事件循环定期调用：把到期的调用以超时失败完成
+void SimpleRpcChannel::ExpireTimeouts()
+{
+    std::vector<PendingCall> timed_out;
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        pending_calls_[req_id] = PendingCall{ response, done, controller };
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        TimerEntry entry;
+        while (timer_queue_.TryPop(&entry)) {
+            timer_wheel_.Add(entry.request_id, entry.deadline_ms);
+        }
+
+        expired_.clear();
+        timer_wheel_.Advance(NowMs(), &expired_);
+        for (uint64_t req_id : expired_) {
+            PendingCall call;
+            // 响应已经到达时 Take 失败（时间轮惰性删除）；与响应并发时只有一方能取走
+            if (pending_calls_.Take(req_id, &call)) {
+                timed_out.push_back(call);
+            }
+        }
     }
 
-    // 4. 加长度前缀并发送
-    std::string out = RpcCodec::AddLengthPrefix(frame);
-    send_(out);
+    // 在锁外回调，done 中可以再次发起调用
+    for (const PendingCall& call : timed_out) {
+        if (call.controller) {
+            call.controller->SetFailed("RPC timeout");
+        }
+        if (call.done) {
+            call.done->Run();
+        }
+    }
+}
+
+void SimpleRpcChannel::FailPending(const std::string& reason)
+{
+    std::vector<PendingCall> calls;
+    pending_calls_.TakeAll(&calls);
+    // 时间轮里残留的 request_id 到期时 Take 失败，惰性清除
+    for (const PendingCall& call : calls) {
+        if (call.controller) {
+            call.controller->SetFailed(reason);
+        }
+        if (call.done) {
+            call.done->Run();
+        }
+    }
 }
 
 // 网络层收到一帧数据后调用
-void SimpleRpcChannel::OnMessage(const std::string& frame)
+void SimpleRpcChannel::OnMessage(std::string_view frame)
 {
-    
-    rpc::RpcMeta meta;
-    std::string payload;
-    if (!RpcCodec::DecodeFrame(frame, &meta, &payload)) {
-        std::cerr << "RpcChannel::OnMessage: DecodeFrame failed" << std::endl;
+    RpcCodec::DecodedFrame decoded;
+    thread_local rpc::RpcMeta meta;     // 复用，只在 decoded.has_meta 时读取
+    if (!RpcCodec::Decode(frame, &decoded, &meta)) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcChannel::OnMessage: Decode failed, frame.size={}",
+                         frame.size());
         return;
     }
 
-    if (meta.is_request()) {
+    if (decoded.header.is_request) {
         // Channel 只处理“响应”，请求是发给服务端的
-        std::cerr << "RpcChannel::OnMessage: got request frame in client channel" << std::endl;
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcChannel::OnMessage: got request frame in client channel");
         return;
     }
 
-    uint64_t req_id = meta.request_id();
+    if (decoded.has_meta && meta.has_load() && load_callback_) {
+        load_callback_(meta.load());
+    }
+
+    uint64_t req_id = decoded.header.request_id;
 
     PendingCall call;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = pending_calls_.find(req_id);
-        if (it == pending_calls_.end()) {
-            std::cerr << "RpcChannel::OnMessage: unknown request_id = "
-                      << req_id << std::endl;
-            return;
-        }
-        call = it->second;
-        pending_calls_.erase(it);
+    if (!pending_calls_.Take(req_id, &call)) {
+        // 超时之后才到达的响应也会走到这里
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "RpcChannel::OnMessage: unknown request_id = {}", req_id);
+        return;
     }
 
     // 检查是否有错误码
-    if (meta.error_code() != 0) {
+    if (decoded.header.status != 0) {
         if (call.controller) {
-            call.controller->SetFailed(meta.error_msg());
+            // 错误文本在 meta / 扩展段里；定长头格式的对端也可能只给状态码
+            call.controller->SetFailed(decoded.has_meta && !meta.error_msg().empty()
+                ? meta.error_msg()
+                : "RPC failed with status " + std::to_string(decoded.header.status));
         }
         if (call.done) {
             call.done->Run();
@@ -104,7 +368,8 @@ void SimpleRpcChannel::OnMessage(const std::string& frame)
     }
 
     // 解析响应体
-    if (!call.response->ParseFromString(payload)) {
+    if (!call.response->ParseFromArray(decoded.payload.data(),
+                                       static_cast<int>(decoded.payload.size()))) {
         if (call.controller) {
             call.controller->SetFailed("Parse response message failed");
         }
@@ -0,0 +1,877 @@
+#include "rpc/rpc_client.h"
+#include "rpc/rpc_channel.h"
+#include "rpc/rpc_controller.h"
+#include "net/frame_codec.h"
+#include "net_muduo/muduo_unix_client.h"
+#include "log/logging.h"
+#include <muduo/net/Buffer.h>
+#include <muduo/net/EventLoop.h>
+#include <muduo/net/EventLoopThread.h>
+#include <muduo/net/InetAddress.h>
+#include <muduo/net/TcpClient.h>
+#include <muduo/net/TimerId.h>
+#include <google/protobuf/descriptor.h>
+#include <netdb.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+using namespace muduo;
+using namespace muduo::net;
+
+namespace {
+
+// "unix:/path" 或 "host:port"（host 可以是域名，解析为第一个 IPv4 地址）
+struct ParsedEndpoint {
+    bool unix_socket = false;
+    std::string path;
+    sockaddr_in addr{};
+};
+
+ParsedEndpoint ParseEndpoint(const std::string& endpoint) {
+    ParsedEndpoint parsed;
+    if (endpoint.compare(0, 5, "unix:") == 0) {
+        parsed.unix_socket = true;
+        parsed.path = endpoint.substr(5);
+        if (parsed.path.empty()) throw std::runtime_error("RpcClient: empty unix socket path");
+        return parsed;
+    }
+
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == endpoint.size()) {
+        throw std::runtime_error("RpcClient: bad endpoint '" + endpoint + "', expect host:port or unix:/path");
+    }
+    std::string host = endpoint.substr(0, colon);
+    std::string port = endpoint.substr(colon + 1);
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    int rc = ::getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0 || !result) {
+        throw std::runtime_error("RpcClient: cannot resolve '" + endpoint + "': " + ::gai_strerror(rc));
+    }
+    std::memcpy(&parsed.addr, result->ai_addr, sizeof(parsed.addr));
+    ::freeaddrinfo(result);
+    return parsed;
+}
+
+// 连接层的失败原因：请求没有得到服务端的响应，换一个 endpoint 重试是安全的（对开启了对冲 / 重试的幂等方法）
+const char kConnectionLost[] = "Connection lost";
+const char kNoConnection[] = "No available connection";
+
+bool IsRetryable(const std::string& error) {
+    return error == kConnectionLost || error == kNoConnection;
+}
+
+int64_t NowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 包在调用方的 done 外面：完成时把耗时和成败计入所选 endpoint 的统计
+class TrackedCall : public google::protobuf::Closure {
+public:
+    TrackedCall(EndpointStats* stats, google::protobuf::RpcController* controller, google::protobuf::Closure* done)
+        : stats_(stats), controller_(controller), done_(done), start_us_(NowUs()) {}
+
+    void Run() override {
+        int64_t now = NowUs();
+        stats_->OnCallFinish(now - start_us_, controller_ && controller_->Failed(), now);
+        google::protobuf::Closure* done = done_;
+        delete this;
+        if (done) done->Run();
+    }
+
+private:
+    EndpointStats* stats_;
+    google::protobuf::RpcController* controller_;
+    google::protobuf::Closure* done_;
+    int64_t start_us_;
+};
+
+/*一个事件循环线程上所有待发的对冲：按到期时间的最小堆 + 一个只对准最早到期项的 muduo 定时器
+    每次调用一个 muduo 定时器的开销（分配、定时器集合、timerfd 重设、每个都要到期一次）在小请求上能吃掉两成吞吐；
+    各调用的对冲等待时间相近、到期顺序接近入队顺序，新项通常晚于已对准的定时器，入队只是加锁 push 一下
+  Schedule 可在任意线程调用，回调在 loop 线程里执行；未到期的项随 HedgeScheduler 一起销毁（事件循环停止之后）
+*/
+class HedgeScheduler {
+public:
+    explicit HedgeScheduler(EventLoop* loop) : loop_(loop) {}
+
+    void Schedule(int64_t when_us, std::function<void()> cb) {
+        bool arm = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            heap_.push_back(Entry{when_us, std::move(cb)});
+            std::push_heap(heap_.begin(), heap_.end(), Later());
+            if (armed_us_ == 0 || when_us < armed_us_) {
+                armed_us_ = when_us;
+                arm = true;
+            }
+        }
+        if (arm) Arm(when_us);
+    }
+
+private:
+    struct Entry {
+        int64_t when_us;
+        std::function<void()> cb;
+    };
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const { return a.when_us > b.when_us; }
+    };
+
+    void Arm(int64_t when_us) {
+        double delay = static_cast<double>(std::max<int64_t>(when_us - NowUs(), 0)) / 1e6;
+        loop_->runAfter(delay, [this, when_us]() { OnTimer(when_us); });
+    }
+
+    // armed_for：触发的是对准哪个时间的定时器；被更早的项替换掉的旧定时器到期时只处理到期项，不改动 armed_us_
+    void OnTimer(int64_t armed_for) {
+        std::vector<std::function<void()>> due;
+        int64_t rearm = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (armed_for == armed_us_) armed_us_ = 0;
+            int64_t now = NowUs();
+            while (!heap_.empty() && heap_.front().when_us <= now) {
+                std::pop_heap(heap_.begin(), heap_.end(), Later());
+                due.push_back(std::move(heap_.back().cb));
+                heap_.pop_back();
+            }
+            if (!heap_.empty() && (armed_us_ == 0 || heap_.front().when_us < armed_us_)) {
+                armed_us_ = rearm = heap_.front().when_us;
+            }
+        }
+        for (auto& cb : due) cb();
+        if (rearm != 0) Arm(rearm);
+    }
+
+    EventLoop* loop_;
+    std::mutex mutex_;
+    std::vector<Entry> heap_;
+    int64_t armed_us_ = 0;      // 当前对准的到期时间，0 表示没有定时器
+};
+
+} // namespace
+
+/*一条到某个 endpoint 的连接：muduo TcpClient（或 MuduoUnixClient）+ 一个 SimpleRpcChannel
+  连接状态只在所属事件循环线程里改变；调用线程只读 connected_ / outstanding()，发送时在锁内取出 TcpConnectionPtr
+  （muduo 的 TcpConnection::send 线程安全，跨线程时拷贝后投递回 IO 线程）
+*/
+class RpcClient::Connection {
+public:
+    Connection(EventLoop* loop, HedgeScheduler* hedges, EndpointStats* stats, const ParsedEndpoint& parsed,
+               const std::string& name, FramingType framing, int64_t timeout_ms)
+        : loop_(loop),
+          hedges_(hedges),
+          stats_(stats),
+          endpoint_(stats->address()),
+          framing_(framing),
+          channel_([this](const std::string& data) { Send(data); })
+    {
+        channel_.SetFraming(framing);
+        channel_.SetDefaultTimeout(timeout_ms);
+        // 服务端开启了负载报告时，报告直接更新该后端的统计，下一次选择就能看到
+        channel_.SetLoadReportCallback([stats](const rpc::LoadReport& report) {
+            stats->OnLoadReport(report.queue_depth(), report.in_flight(), report.cpu_permille(), NowUs());
+        });
+        if (parsed.unix_socket) {
+            unix_client_ = std::make_unique<MuduoUnixClient>(loop, parsed.path, name);
+            SetupCallbacks(unix_client_.get());
+        } else {
+            tcp_client_ = std::make_unique<TcpClient>(loop, InetAddress(parsed.addr), name);
+            tcp_client_->enableRetry();   // 断开后自动重连，连接失败时 Connector 按 0.5s 起翻倍退避
+            SetupCallbacks(tcp_client_.get());
+        }
+    }
+
+    // 所属事件循环线程内调用
+    void Connect() {
+        if (tcp_client_) {
+            tcp_client_->connect();
+        } else {
+            unix_client_->connect();
+        }
+    }
+
+    // 所属事件循环线程内调用：停止重连并断开（client 析构时关闭连接）
+    void Shutdown() {
+        stopping_ = true;
+        if (connected_.exchange(false, std::memory_order_acq_rel)) stats_->OnConnectionDown();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            conn_.reset();
+        }
+        tcp_client_.reset();
+        unix_client_.reset();
+    }
+
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+    size_t outstanding() const { return channel_.PendingCount(); }
+    SimpleRpcChannel& channel() { return channel_; }
+    HedgeScheduler* hedges() const { return hedges_; }
+
+private:
+    template <typename Client>
+    void SetupCallbacks(Client* client) {
+        client->setConnectionCallback([this](const TcpConnectionPtr& conn) { OnConnection(conn); });
+        client->setMessageCallback([this](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+            OnMessage(conn, buf);
+        });
+    }
+
+    void OnConnection(const TcpConnectionPtr& conn) {
+        if (conn->connected()) {
+            RPC_LOG_INFO("RpcClient connected to {}", endpoint_);
+            if (tcp_client_) conn->setTcpNoDelay(true);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                conn_ = conn;
+            }
+            channel_.StartHandshake();
+            stats_->OnConnectionUp(NowUs());
+            connected_.store(true, std::memory_order_release);
+            return;
+        }
+
+        RPC_LOG_WARN("RpcClient disconnected from {}", endpoint_);
+        // Shutdown() 里已经摘除过的不再重复计数
+        if (connected_.exchange(false, std::memory_order_acq_rel)) stats_->OnConnectionDown();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            conn_.reset();
+        }
+        // 重连的对端可能是另一个进程，方法编号要重新协商；已发出的调用不会再有响应
+        channel_.ResetHandshake();
+        channel_.FailPending(kConnectionLost);
+        if (unix_client_ && !stopping_) {
+            // MuduoUnixClient 不自动重连；本回调返回后它才移除旧连接，所以放到下一轮再连
+            loop_->queueInLoop([this]() {
+                if (!stopping_ && unix_client_) unix_client_->connect();
+            });
+        }
+    }
+
+    void OnMessage(const TcpConnectionPtr& conn, Buffer* buf) {
+        bool corrupt = false;
+        size_t consumed = 0;
+        switch (framing_) {
+        case FramingType::Varint:
+            consumed = SplitFrames<VarintFraming>(buf, &corrupt);
+            break;
+        case FramingType::Checksum:
+            consumed = SplitFrames<ChecksumFraming>(buf, &corrupt);
+            break;
+        case FramingType::Fixed32:
+        default:
+            consumed = SplitFrames<Fixed32Framing>(buf, &corrupt);
+            break;
+        }
+        buf->retrieve(consumed);
+        if (corrupt) {
+            RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "RpcClient: corrupt frame from {}, closing", endpoint_);
+            conn->forceClose();
+        }
+    }
+
+    template <typename Framing>
+    size_t SplitFrames(Buffer* buf, bool* corrupt) {
+        return BasicFrameCodec<Framing>::OnData(buf->peek(), buf->readableBytes(), nullptr,
+            [this](const std::shared_ptr<RpcConnection>&, std::string_view frame) {
+                channel_.OnMessage(frame);
+            }, corrupt);
+    }
+
+    void Send(const std::string& data) {
+        TcpConnectionPtr conn;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            conn = conn_;
+        }
+        // 选中后、发送前恰好断开：这次调用等到超时失败
+        if (conn) conn->send(data.data(), static_cast<int>(data.size()));
+    }
+
+    EventLoop* loop_;
+    HedgeScheduler* hedges_;
+    EndpointStats* stats_;
+    const std::string endpoint_;
+    const FramingType framing_;
+    std::unique_ptr<TcpClient> tcp_client_;
+    std::unique_ptr<MuduoUnixClient> unix_client_;
+    bool stopping_ = false;                 // 只在所属事件循环线程访问
+
+    std::mutex mutex_;                      // 保护 conn_
+    TcpConnectionPtr conn_;
+    std::atomic<bool> connected_{false};
+    SimpleRpcChannel channel_;
+};
+
+// 一个 endpoint：负载统计 + 到它的全部连接
+struct RpcClient::Endpoint {
+    explicit Endpoint(const std::string& address) : stats(address) {}
+
+    EndpointStats stats;
+    std::vector<Connection*> conns;
+};
+
+// 一个事件循环线程及分给它的连接；定时驱动这些连接的超时检查
+struct RpcClient::IoThread {
+    std::unique_ptr<EventLoopThread> thread;
+    EventLoop* loop = nullptr;
+    std::unique_ptr<HedgeScheduler> hedges;
+    std::vector<Connection*> conns;
+    TimerId timer;
+};
+
+// 开启了对冲 / 重试的方法：策略 + 延迟分布（估计对冲等待时间）
+struct RpcClient::MethodHedge {
+    static constexpr uint64_t kRefreshEvery = 64;   // 每 64 个样本重新估计一次分位数
+
+    explicit MethodHedge(const HedgePolicy& p) : policy(p) {}
+
+    void Record(int64_t latency_us) {
+        latency.Record(latency_us);
+        if (samples.fetch_add(1, std::memory_order_relaxed) % kRefreshEvery == 0) {
+            delay_us.store(latency.Quantile(policy.quantile), std::memory_order_relaxed);
+        }
+    }
+
+    HedgePolicy policy;
+    LatencyHistogram latency;
+    std::atomic<uint64_t> samples{0};
+    std::atomic<int64_t> delay_us{-1};   // 当前的对冲等待时间，-1 表示样本不足、不对冲
+};
+
+/*一次开启了对冲 / 重试的调用：可能在几个 endpoint 上各有一次发送（Attempt），
+    每次发送有自己的 controller 和 response，在各自连接的 SimpleRpcChannel 里占一个 request_id。
+    第一个成功的发送把 response 换给调用方并取消其余发送；全部失败且不能再重试时以最后一个错误失败。
+  生命周期由 shared_ptr 管理：每次发送的 done 和对冲定时器各持有一份。
+  调用方的 request 只在 Send 里读取；调用方的 done 执行前要等正在进行的 Send 返回（sending_），之后不再碰 request
+*/
+class RpcClient::HedgedCall : public std::enable_shared_from_this<RpcClient::HedgedCall> {
+public:
+    HedgedCall(RpcClient* client, MethodHedge* hedge, const google::protobuf::MethodDescriptor* method,
+               google::protobuf::RpcController* controller, const google::protobuf::Message* request,
+               google::protobuf::Message* response, google::protobuf::Closure* done,
+               const std::string* routing_key)
+        : client_(client), hedge_(hedge), method_(method), controller_(controller),
+          request_(request), response_(response), done_(done),
+          has_key_(routing_key != nullptr), routing_key_(routing_key ? *routing_key : std::string())
+    {
+        auto* simple = dynamic_cast<SimpleRpcController*>(controller);
+        int64_t timeout_ms = simple && simple->TimeoutMs() != 0 ? simple->TimeoutMs() : client->default_timeout_ms_;
+        deadline_us_ = timeout_ms > 0 ? NowUs() + timeout_ms * 1000 : 0;
+        attempts_.reserve(static_cast<size_t>(std::max(hedge->policy.max_attempts, 1)));
+    }
+
+    void Start() {
+        client_->hedge_budget_->Deposit();
+        client_->retry_budget_->Deposit();
+        Connection* conn = Send(SendKind::First);
+        if (!conn) {
+            if (controller_) controller_->SetFailed(kNoConnection);
+            if (done_) done_->Run();
+            return;
+        }
+        int64_t delay_us = hedge_->delay_us.load(std::memory_order_relaxed);
+        if (hedge_->policy.max_attempts > 1 && delay_us >= 0) {
+            ScheduleHedge(conn->hedges(), delay_us);
+        }
+    }
+
+private:
+    enum class SendKind { First, Hedge, Retry };
+
+    struct Attempt {
+        SimpleRpcController controller;
+        std::unique_ptr<google::protobuf::Message> response;
+        Endpoint* endpoint = nullptr;
+        Connection* conn = nullptr;
+        uint64_t request_id = 0;     // 0：还在 StartCall 里，或立即失败
+        int64_t start_us = 0;
+        bool done = false;
+        bool canceled = false;
+    };
+
+    class AttemptDone : public google::protobuf::Closure {
+    public:
+        AttemptDone(std::shared_ptr<HedgedCall> call, Attempt* attempt)
+            : call_(std::move(call)), attempt_(attempt) {}
+
+        void Run() override {
+            std::shared_ptr<HedgedCall> call = std::move(call_);
+            Attempt* attempt = attempt_;
+            delete this;
+            call->OnAttemptDone(attempt);
+        }
+
+    private:
+        std::shared_ptr<HedgedCall> call_;
+        Attempt* attempt_;
+    };
+
+    // 发出一份请求；返回所用的连接，没有发出（已结束、次数或预算用完、没有可用连接、已过截止时间）时返回 nullptr
+    Connection* Send(SendKind kind) {
+        Attempt* attempt = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            int64_t now = NowUs();
+            if (finished_ || attempts_.size() >= static_cast<size_t>(std::max(hedge_->policy.max_attempts, 1)) ||
+                (deadline_us_ != 0 && now >= deadline_us_)) {
+                return nullptr;
+            }
+            std::vector<Endpoint*> tried;
+            for (const auto& a : attempts_) tried.push_back(a->endpoint);
+            const std::string* key = has_key_ ? &routing_key_ : nullptr;
+            Endpoint* endpoint = nullptr;
+            Connection* conn = client_->PickConnection(key, &endpoint, &tried);
+            if (!conn && kind == SendKind::Retry) {
+                conn = client_->PickConnection(key, &endpoint);   // 只剩试过的 endpoint 时，重试可以回到它
+            }
+            if (!conn) return nullptr;
+            if ((kind == SendKind::Hedge && !client_->hedge_budget_->TryWithdraw()) ||
+                (kind == SendKind::Retry && !client_->retry_budget_->TryWithdraw())) {
+                return nullptr;
+            }
+
+            attempts_.push_back(std::make_unique<Attempt>());
+            attempt = attempts_.back().get();
+            attempt->endpoint = endpoint;
+            attempt->conn = conn;
+            attempt->response.reset(response_->New());
+            attempt->controller.SetTimeout(deadline_us_ == 0 ? -1
+                : std::max<int64_t>((deadline_us_ - now + 999) / 1000, 1));
+            attempt->start_us = now;
+            ++outstanding_;
+            ++sending_;
+        }
+
+        attempt->endpoint->stats.OnCallStart();
+        uint64_t request_id = attempt->conn->channel().StartCall(
+            method_, &attempt->controller, request_, attempt->response.get(),
+            new AttemptDone(shared_from_this(), attempt));
+
+        bool cancel = false;
+        bool complete = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            attempt->request_id = request_id;
+            --sending_;
+            // 发送期间别的发送已经胜出：这一份也取消
+            if (finished_ && !attempt->done && request_id != 0) {
+                attempt->canceled = true;
+                cancel = true;
+            }
+            complete = TryComplete();
+        }
+        if (cancel) attempt->conn->channel().Cancel(request_id);
+        if (complete) Complete();
+        return attempt->conn;
+    }
+
+    void ScheduleHedge(HedgeScheduler* hedges, int64_t delay_us) {
+        std::shared_ptr<HedgedCall> self = shared_from_this();
+        hedges->Schedule(NowUs() + delay_us, [self, hedges, delay_us]() {
+            {
+                std::lock_guard<std::mutex> lock(self->mutex_);
+                if (self->finished_) return;
+            }
+            if (self->Send(SendKind::Hedge)) {
+                self->ScheduleHedge(hedges, delay_us);   // max_attempts > 2 时继续对冲；次数用完时 Send 直接返回
+            }
+        });
+    }
+
+    void OnAttemptDone(Attempt* attempt) {
+        int64_t now = NowUs();
+        int64_t elapsed = now - attempt->start_us;
+        bool failed = attempt->controller.Failed();
+        bool canceled = false;
+        bool retry = false;
+        bool complete = false;
+        std::vector<std::pair<Connection*, uint64_t>> cancels;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            attempt->done = true;
+            canceled = failed && attempt->canceled;
+            --outstanding_;
+            if (!finished_ && !failed) {
+                finished_ = true;
+                response_->GetReflection()->Swap(response_, attempt->response.get());
+                for (const auto& a : attempts_) {
+                    if (!a->done && a->request_id != 0) {
+                        a->canceled = true;
+                        cancels.emplace_back(a->conn, a->request_id);
+                    }
+                }
+            } else if (!finished_) {
+                last_error_ = attempt->controller.ErrorText();
+                if (outstanding_ == 0) {
+                    // 还有别的发送在途时等它们；都结束了才决定重试还是失败
+                    if (IsRetryable(last_error_)) {
+                        retry = true;
+                    } else {
+                        finished_ = true;
+                        failed_ = true;
+                    }
+                }
+            }
+            complete = TryComplete();
+        }
+
+        // 取消的发送只有一个下界耗时：计入方法的延迟分布（否则对冲掉的慢尾巴会让 pN 越估越低），不计入 endpoint 的延迟
+        if (canceled) {
+            attempt->endpoint->stats.OnCallCanceled();
+        } else {
+            attempt->endpoint->stats.OnCallFinish(elapsed, failed, now);
+        }
+        if (!failed || canceled) hedge_->Record(elapsed);
+
+        for (const auto& c : cancels) c.first->channel().Cancel(c.second);
+
+        if (retry && !Send(SendKind::Retry)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!finished_ && outstanding_ == 0) {
+                finished_ = true;
+                failed_ = true;
+            }
+            complete = TryComplete();
+        }
+        if (complete) Complete();
+    }
+
+    // 调用已结束且没有进行中的 Send 时返回 true（只返回一次），由调用者在锁外执行 Complete；需持有 mutex_
+    bool TryComplete() {
+        if (!finished_ || sending_ != 0 || completed_) return false;
+        completed_ = true;
+        return true;
+    }
+
+    void Complete() {
+        if (failed_ && controller_) controller_->SetFailed(last_error_);
+        if (done_) done_->Run();
+    }
+
+    RpcClient* client_;
+    MethodHedge* hedge_;
+    const google::protobuf::MethodDescriptor* method_;
+    google::protobuf::RpcController* controller_;
+    const google::protobuf::Message* request_;
+    google::protobuf::Message* response_;
+    google::protobuf::Closure* done_;
+    const bool has_key_;
+    const std::string routing_key_;
+    int64_t deadline_us_ = 0;   // 0 表示不超时
+
+    std::mutex mutex_;          // 保护以下全部
+    std::vector<std::unique_ptr<Attempt>> attempts_;
+    int outstanding_ = 0;       // 已发出、还没完成的发送数
+    int sending_ = 0;           // 正在 StartCall 里的发送数
+    bool finished_ = false;     // 结果已确定（成功或最终失败）
+    bool failed_ = false;
+    bool completed_ = false;    // 调用方的 done 已经（或即将）执行
+    std::string last_error_;
+};
+
+RpcClient::RpcClient(int io_threads)
+    : io_threads_(io_threads > 0 ? io_threads : 1),
+      hedge_budget_(std::make_unique<RetryBudget>(kDefaultHedgeBudgetPercent / 100, kBudgetBurst)),
+      retry_budget_(std::make_unique<RetryBudget>(kDefaultRetryBudgetPercent / 100, kBudgetBurst))
+{
+}
+
+RpcClient::~RpcClient()
+{
+    Stop();
+}
+
+void RpcClient::AddEndpoint(const std::string& endpoint){
+    addresses_.push_back(endpoint);
+}
+
+void RpcClient::AddEndpointsFromFile(const std::string& path){
+    for (const std::string& e : ReadEndpointsFile(path)) {
+        AddEndpoint(e);
+    }
+}
+
+void RpcClient::SetConnectionsPerEndpoint(int n){
+    conns_per_endpoint_ = n > 0 ? n : 1;
+}
+
+void RpcClient::SetFraming(FramingType framing){
+    framing_=framing;
+}
+
+void RpcClient::SetDefaultTimeout(int64_t timeout_ms){
+    default_timeout_ms_=timeout_ms;
+}
+
+void RpcClient::SetLoadBalancePolicy(LoadBalancePolicy policy){
+    policy_=policy;
+}
+
+void RpcClient::SetSlowStart(int64_t ms){
+    slow_start_ms_=ms;
+}
+
+void RpcClient::SetRoutingKeyExtractor(RoutingKeyExtractor extractor){
+    key_extractor_=std::move(extractor);
+}
+
+void RpcClient::SetHashLoadFactor(double factor){
+    hash_load_factor_=factor;
+}
+
+// 对冲配置在 CallMethod 里无锁读取：Start 之后再改就是数据竞争，直接拒绝
+void RpcClient::CheckNotStarted(const char* setter){
+    if (started_ || !threads_.empty()) {
+        throw std::runtime_error(std::string("RpcClient::") + setter + " must be called before Start()");
+    }
+}
+
+void RpcClient::SetHedgePolicy(const std::string& method_full_name, const HedgePolicy& policy){
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckNotStarted("SetHedgePolicy");
+    hedged_methods_[method_full_name] = std::make_unique<MethodHedge>(policy);
+}
+
+void RpcClient::SetHedgeBudget(double percent){
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckNotStarted("SetHedgeBudget");
+    hedge_budget_ = std::make_unique<RetryBudget>(percent / 100, kBudgetBurst);
+}
+
+void RpcClient::SetRetryBudget(double percent){
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckNotStarted("SetRetryBudget");
+    retry_budget_ = std::make_unique<RetryBudget>(percent / 100, kBudgetBurst);
+}
+
+RpcClient::RoutingKeyExtractor RpcClient::RoutingKeyField(const std::string& field_name)
+{
+    using google::protobuf::FieldDescriptor;
+    return [field_name](const google::protobuf::MethodDescriptor*, const google::protobuf::Message& request,
+                        std::string* key) {
+        const FieldDescriptor* field = request.GetDescriptor()->FindFieldByName(field_name);
+        if (!field || field->is_repeated()) return false;
+        const google::protobuf::Reflection* reflection = request.GetReflection();
+        switch (field->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_STRING:
+            *key = reflection->GetString(request, field);
+            return !key->empty();
+        case FieldDescriptor::CPPTYPE_INT32:
+            *key = std::to_string(reflection->GetInt32(request, field));
+            return true;
+        case FieldDescriptor::CPPTYPE_INT64:
+            *key = std::to_string(reflection->GetInt64(request, field));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT32:
+            *key = std::to_string(reflection->GetUInt32(request, field));
+            return true;
+        case FieldDescriptor::CPPTYPE_UINT64:
+            *key = std::to_string(reflection->GetUInt64(request, field));
+            return true;
+        default:
+            return false;
+        }
+    };
+}
+
+void RpcClient::Start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_ || !threads_.empty()) return;   // 已启动，或已 Stop（不支持重新启动）
+    if (addresses_.empty()) throw std::runtime_error("RpcClient: no endpoint");
+
+    // 先解析全部地址：有错时还没有启动任何线程
+    std::vector<ParsedEndpoint> parsed;
+    for (const std::string& e : addresses_) parsed.push_back(ParseEndpoint(e));
+
+    balancer_ = NewLoadBalancer(policy_, slow_start_ms_ * 1000);
+    for (const std::string& e : addresses_) {
+        endpoints_.push_back(std::make_unique<Endpoint>(e));
+    }
+    if (policy_ == LoadBalancePolicy::ConsistentHash) {
+        std::vector<EndpointStats*> stats;
+        for (const auto& e : endpoints_) stats.push_back(&e->stats);
+        router_ = std::make_unique<ConsistentHashRouter>(std::move(stats), hash_load_factor_);
+    }
+
+    for (int i = 0; i < io_threads_; ++i) {
+        auto t = std::make_unique<IoThread>();
+        t->thread = std::make_unique<EventLoopThread>(EventLoopThread::ThreadInitCallback(),
+                                                      "RpcClient" + std::to_string(i));
+        t->loop = t->thread->startLoop();
+        t->hedges = std::make_unique<HedgeScheduler>(t->loop);
+        threads_.push_back(std::move(t));
+    }
+
+    // 同一 endpoint 的多条连接分散到不同线程
+    for (int k = 0; k < conns_per_endpoint_; ++k) {
+        for (size_t e = 0; e < endpoints_.size(); ++e) {
+            Endpoint* endpoint = endpoints_[e].get();
+            IoThread* t = threads_[conns_.size() % threads_.size()].get();
+            std::string name = "RpcClient-" + addresses_[e] + "#" + std::to_string(k);
+            conns_.push_back(std::make_unique<Connection>(t->loop, t->hedges.get(), &endpoint->stats, parsed[e],
+                                                          name, framing_, default_timeout_ms_));
+            t->conns.push_back(conns_.back().get());
+            endpoint->conns.push_back(conns_.back().get());
+        }
+    }
+
+    for (auto& t : threads_) {
+        IoThread* raw = t.get();
+        raw->loop->runInLoop([raw]() {
+            raw->timer = raw->loop->runEvery(SimpleRpcChannel::kTimerTickMs / 1000.0, [raw]() {
+                for (Connection* c : raw->conns) c->channel().ExpireTimeouts();
+            });
+            for (Connection* c : raw->conns) c->Connect();
+        });
+    }
+    started_ = true;
+}
+
+void RpcClient::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_) return;
+    started_ = false;
+
+    // 连接对象必须在所属事件循环线程里断开、析构 client
+    for (auto& t : threads_) {
+        IoThread* raw = t.get();
+        std::promise<void> finished;
+        raw->loop->runInLoop([raw, &finished]() {
+            raw->loop->cancel(raw->timer);
+            for (Connection* c : raw->conns) c->Shutdown();
+            finished.set_value();
+        });
+        finished.get_future().wait();
+    }
+    for (auto& t : threads_) {
+        t->thread.reset();   // quit + join
+    }
+    for (auto& c : conns_) {
+        c->channel().FailPending("Client stopped");
+    }
+}
+
+size_t RpcClient::ConnectedCount() const
+{
+    size_t n = 0;
+    for (const auto& c : conns_) {
+        if (c->connected()) ++n;
+    }
+    return n;
+}
+
+size_t RpcClient::WaitForConnections(size_t n, int timeout_ms) const
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    size_t connected = ConnectedCount();
+    while (connected < n && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        connected = ConnectedCount();
+    }
+    return connected;
+}
+
+RpcClient::Connection* RpcClient::PickConnection(const std::string* routing_key, Endpoint** endpoint,
+                                                 const std::vector<Endpoint*>* exclude)
+{
+    auto excluded = [exclude](Endpoint* e) {
+        return exclude && std::find(exclude->begin(), exclude->end(), e) != exclude->end();
+    };
+
+    Endpoint* chosen = nullptr;
+    if (routing_key && router_) {
+        size_t i = router_->Pick(HashRoutingKey(*routing_key));
+        if (i == ConsistentHashRouter::kNone) return nullptr;
+        chosen = endpoints_[i].get();
+        if (excluded(chosen)) chosen = nullptr;   // 对冲 / 重试：键的首选副本已经试过，其余副本按负载选
+    }
+    if (!chosen) {
+        // 调用线程各自复用的候选列表，避免每次调用分配
+        thread_local std::vector<EndpointStats*> candidates;
+        thread_local std::vector<Endpoint*> available;
+        candidates.clear();
+        available.clear();
+        for (const auto& e : endpoints_) {
+            if (e->stats.available() && !excluded(e.get())) {
+                candidates.push_back(&e->stats);
+                available.push_back(e.get());
+            }
+        }
+        if (available.empty()) return nullptr;
+        chosen = available[balancer_->Pick(candidates, NowUs())];
+    }
+
+    // 同一 endpoint 的连接等价，选未完成调用最少的
+    size_t n = chosen->conns.size();
+    size_t start = next_.fetch_add(1, std::memory_order_relaxed);
+    Connection* best = nullptr;
+    size_t best_load = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Connection* c = chosen->conns[(start + i) % n];
+        if (!c->connected()) continue;
+        size_t load = c->outstanding();
+        if (!best || load < best_load) {
+            best = c;
+            best_load = load;
+            if (load == 0) break;   // 空闲连接，不用再找
+        }
+    }
+    *endpoint = chosen;
+    return best;
+}
+
+void RpcClient::CallMethod(const google::protobuf::MethodDescriptor* method,
+                           google::protobuf::RpcController* controller,
+                           const google::protobuf::Message* request,
+                           google::protobuf::Message* response,
+                           google::protobuf::Closure* done)
+{
+    // 路由键：controller 上设置的优先，其次是 extractor 从请求里取的
+    const std::string* routing_key = nullptr;
+    if (router_) {
+        auto* simple = dynamic_cast<SimpleRpcController*>(controller);
+        thread_local std::string extracted;
+        if (simple && !simple->RoutingKey().empty()) {
+            routing_key = &simple->RoutingKey();
+        } else if (key_extractor_ && request) {
+            extracted.clear();
+            if (key_extractor_(method, *request, &extracted)) routing_key = &extracted;
+        }
+    }
+
+    if (!hedged_methods_.empty()) {
+        auto it = hedged_methods_.find(method->full_name());
+        if (it != hedged_methods_.end()) {
+            std::make_shared<HedgedCall>(this, it->second.get(), method, controller, request, response, done,
+                                         routing_key)->Start();
+            return;
+        }
+    }
+
+    Endpoint* endpoint = nullptr;
+    Connection* conn = PickConnection(routing_key, &endpoint);
+    if (!conn) {
+        if (controller) {
+            controller->SetFailed(kNoConnection);
+        }
+        if (done) done->Run();
+        return;
+    }
+    endpoint->stats.OnCallStart();
+    conn->channel().CallMethod(method, controller, request, response,
+                               new TrackedCall(&endpoint->stats, controller, done));
+}
@@ -1,49 +1,361 @@
 #include "rpc/rpc_codec.h"
+#include "rpc/rpc_connection.h"
 #include <arpa/inet.h>
+#include <endian.h>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+// ScratchBuffer 超过这个容量时不再保留，避免一次大响应让线程永久占用大块内存
+constexpr size_t kMaxScratchCapacity = 1 << 20;
+
+inline char* PutUint32(char* p, uint32_t v) {
+    uint32_t net = htonl(v);
+    std::memcpy(p, &net, 4);
+    return p + 4;
+}
+
+// 定长头在线上的布局（字段均为大端），见 rpc_codec.h
+struct WireHeader {
+    uint8_t  magic;
+    uint8_t  version;
+    uint16_t flags;
+    uint32_t method_id;
+    uint64_t request_id;
+    int32_t  status;
+    uint32_t ext_len;
+    uint32_t body_len;
+    uint32_t reserved;
+};
+static_assert(sizeof(WireHeader) == RpcCodec::kBinaryHeaderLen, "WireHeader must be 32 bytes");
+
+// 计算 meta/body 序列化长度（同时让 protobuf 缓存各字段大小，供 SerializeWithCachedSizesToArray 使用）
+bool ComputeSizes(const rpc::RpcMeta& meta,
+                  const google::protobuf::Message& msg,
+                  size_t* meta_len, size_t* body_len) {
+    *meta_len = meta.ByteSizeLong();
+    *body_len = msg.ByteSizeLong();
+    // protobuf 单条消息上限 2GB，同时保证 total_len 能放进 uint32
+    return *meta_len <= INT_MAX && *body_len <= INT_MAX
+        && 4 + *meta_len + *body_len <= UINT32_MAX;
+}
+
+// 把 [meta][body] 写到 p 处（meta/body 的大小必须已经由 ComputeSizes 缓存）
+void WriteMetaAndBody(const rpc::RpcMeta& meta,
+                      const google::protobuf::Message& msg,
+                      char* p) {
+    uint8_t* dst = reinterpret_cast<uint8_t*>(p);
+    dst = meta.SerializeWithCachedSizesToArray(dst);
+    msg.SerializeWithCachedSizesToArray(dst);
+}
+
+} // namespace
+
+namespace {
+
+// 输出到 std::string：按整帧长度 resize（复用已有容量）
+struct StringAlloc {
+    std::string* out;
+    char* operator()(size_t n) const {
+        out->resize(n);
+        return &(*out)[0];
+    }
+};
+
+/*以下 Encode*Impl 先算出整帧长度，再向 alloc 要一块连续内存一次写完；
+  alloc 可以是 std::string，也可以直接是连接的发送缓冲区（见 RpcCodec::SendResponse）。
+  所有可能失败的检查都在 alloc 之前完成：拿到内存之后编码一定成功*/
+
+template <typename Alloc>
+bool EncodeMessageImpl(const rpc::RpcMeta& meta,
+                       const google::protobuf::Message& msg,
+                       FramingType framing,
+                       Alloc&& alloc)
+{
+    size_t meta_len = 0, body_len = 0;
+    if (!ComputeSizes(meta, msg, &meta_len, &body_len)) {
+        return false;
+    }
+
+    size_t frame_len = 4 + meta_len + body_len;      // total_len 不包含自身
+    size_t prefix_len = FramingPrefixLen(framing, frame_len);
+    char* base = alloc(prefix_len + frame_len);
+
+    char* p = base + prefix_len;
+    p = PutUint32(p, static_cast<uint32_t>(meta_len));
+    WriteMetaAndBody(meta, msg, p);
+    WriteFramingPrefix(framing, base, frame_len);   // 帧已写好，Checksum 格式可以算校验和
+    return true;
+}
+
+template <typename Alloc>
+bool EncodeHeaderImpl(const rpc::RpcMeta& meta,
+                      size_t body_len,
+                      FramingType framing,
+                      Alloc&& alloc)
+{
+    size_t meta_len = meta.ByteSizeLong();
+    if (meta_len > INT_MAX || 4 + meta_len + body_len > UINT32_MAX) {
+        return false;
+    }
+    if (framing == FramingType::Checksum && body_len > 0) {
+        return false;
+    }
+
+    size_t frame_len = 4 + meta_len + body_len;
+    size_t prefix_len = FramingPrefixLen(framing, frame_len);
+    char* base = alloc(prefix_len + 4 + meta_len);
+
+    char* p = base + prefix_len;
+    p = PutUint32(p, static_cast<uint32_t>(meta_len));
+    meta.SerializeWithCachedSizesToArray(reinterpret_cast<uint8_t*>(p));
+    WriteFramingPrefix(framing, base, frame_len);
+    return true;
+}
+
+template <typename Alloc>
+bool EncodeBinaryImpl(const RpcHeader& header,
+                      const rpc::RpcMeta* ext,
+                      const google::protobuf::Message* msg,
+                      FramingType framing,
+                      Alloc&& alloc)
+{
+    size_t ext_len = ext ? ext->ByteSizeLong() : 0;
+    size_t body_len = msg ? msg->ByteSizeLong() : 0;
+    if (ext_len > INT_MAX || body_len > INT_MAX
+        || RpcCodec::kBinaryHeaderLen + ext_len + body_len > UINT32_MAX) {
+        return false;
+    }
+
+    WireHeader h;
+    h.magic = RpcCodec::kMagic;
+    h.version = RpcCodec::kBinaryVersion;
+    h.flags = htobe16(header.is_request ? RpcCodec::kFlagRequest : 0);
+    h.method_id = htobe32(header.method_id);
+    h.request_id = htobe64(header.request_id);
+    h.status = static_cast<int32_t>(htobe32(static_cast<uint32_t>(header.status)));
+    h.ext_len = htobe32(static_cast<uint32_t>(ext_len));
+    h.body_len = htobe32(static_cast<uint32_t>(body_len));
+    h.reserved = 0;
+
+    size_t frame_len = RpcCodec::kBinaryHeaderLen + ext_len + body_len;
+    size_t prefix_len = FramingPrefixLen(framing, frame_len);
+    char* base = alloc(prefix_len + frame_len);
+
+    char* p = base + prefix_len;
+    std::memcpy(p, &h, RpcCodec::kBinaryHeaderLen);
+    uint8_t* dst = reinterpret_cast<uint8_t*>(p + RpcCodec::kBinaryHeaderLen);
+    if (ext) dst = ext->SerializeWithCachedSizesToArray(dst);
+    if (msg) msg->SerializeWithCachedSizesToArray(dst);
+    WriteFramingPrefix(framing, base, frame_len);
+    return true;
+}
+
+template <typename Alloc>
+bool EncodeResponseImpl(WireFormat format,
+                        uint64_t request_id,
+                        int32_t status,
+                        const std::string& error_msg,
+                        const google::protobuf::Message* msg,
+                        const rpc::LoadReport* load,
+                        FramingType framing,
+                        Alloc&& alloc)
+{
+    if (format == WireFormat::Binary) {
+        RpcHeader header;
+        header.request_id = request_id;
+        header.status = status;
+        if (error_msg.empty() && !load) {
+            return EncodeBinaryImpl(header, nullptr, msg, framing, alloc);
+        }
+        rpc::RpcMeta ext;
+        if (!error_msg.empty()) ext.set_error_msg(error_msg);
+        if (load) *ext.mutable_load() = *load;
+        return EncodeBinaryImpl(header, &ext, msg, framing, alloc);
+    }
+
+    // 旧格式：响应只携带 request_id 和状态
+    rpc::RpcMeta meta;
+    meta.set_request_id(request_id);
+    meta.set_is_request(false);
+    meta.set_error_code(status);
+    if (!error_msg.empty()) {
+        meta.set_error_msg(error_msg);
+    }
+    if (load) {
+        *meta.mutable_load() = *load;
+    }
+    return msg ? EncodeMessageImpl(meta, *msg, framing, alloc)
+               : EncodeHeaderImpl(meta, 0, framing, alloc);
+}
+
+} // namespace
+
+//单次编码：meta、msg——>out([total_len][meta_len][meta][body])
+bool RpcCodec::EncodeMessage(const rpc::RpcMeta& meta,
+                             const google::protobuf::Message& msg,
+                             std::string* out,
+                             FramingType framing)
+{
+    return EncodeMessageImpl(meta, msg, framing, StringAlloc{out});
+}
+
+//只编码头部：meta、body_len——>out([total_len][meta_len][meta])，body 由调用方单独发送
+bool RpcCodec::EncodeHeader(const rpc::RpcMeta& meta,
+                            size_t body_len,
+                            std::string* out,
+                            FramingType framing)
+{
+    return EncodeHeaderImpl(meta, body_len, framing, StringAlloc{out});
+}
+
+std::string& RpcCodec::ScratchBuffer()
+{
+    thread_local std::string buf;
+    if (buf.capacity() > kMaxScratchCapacity) {
+        std::string().swap(buf);
+    }
+    return buf;
+}
 
 //序列化：meta、msg——>out([meta_len][meta][payload])
 bool RpcCodec::EncodeFrame(const rpc::RpcMeta& meta,
                            const google::protobuf::Message& msg,
                            std::string* out)
 {
-    std::string meta_bytes;
-    if (!meta.SerializeToString(&meta_bytes)) {
+    size_t meta_len = 0, body_len = 0;
+    if (!ComputeSizes(meta, msg, &meta_len, &body_len)) {
         return false;
     }
 
-    std::string body_bytes;
-    if (!msg.SerializeToString(&body_bytes)) {
+    out->resize(4 + meta_len + body_len);
+
+    char* p = &(*out)[0];
+    p = PutUint32(p, static_cast<uint32_t>(meta_len));
+    WriteMetaAndBody(meta, msg, p);
+    return true;
+}
+
+//定长头格式编码：header、ext、msg——>out([total_len][定长头][ext][body])
+bool RpcCodec::EncodeBinary(const RpcHeader& header,
+                            const rpc::RpcMeta* ext,
+                            const google::protobuf::Message* msg,
+                            std::string* out,
+                            FramingType framing)
+{
+    return EncodeBinaryImpl(header, ext, msg, framing, StringAlloc{out});
+}
+
+bool RpcCodec::EncodeResponse(WireFormat format,
+                              uint64_t request_id,
+                              int32_t status,
+                              const std::string& error_msg,
+                              const google::protobuf::Message* msg,
+                              std::string* out,
+                              FramingType framing,
+                              const rpc::LoadReport* load)
+{
+    return EncodeResponseImpl(format, request_id, status, error_msg, msg, load, framing, StringAlloc{out});
+}
+
+//编码并发送响应：连接支持时直接编码进它的发送缓冲区，否则编码进 ScratchBuffer 再 Send
+bool RpcCodec::SendResponse(RpcConnection* conn,
+                            WireFormat format,
+                            uint64_t request_id,
+                            int32_t status,
+                            const std::string& error_msg,
+                            const google::protobuf::Message* msg,
+                            const rpc::LoadReport* load)
+{
+    std::string* scratch = nullptr;
+    auto alloc = [conn, &scratch](size_t n) -> char* {
+        char* p = conn->BeginFrame(n);
+        if (p) return p;
+        scratch = &ScratchBuffer();
+        return StringAlloc{scratch}(n);
+    };
+    if (!EncodeResponseImpl(format, request_id, status, error_msg, msg, load, conn->GetFraming(), alloc)) {
         return false;
     }
+    if (scratch) {
+        conn->Send(*scratch);
+    } else {
+        conn->CommitFrame();
+    }
+    return true;
+}
+
+//解码任一格式：frame——>header（+ 可选的 meta）、payload
+bool RpcCodec::Decode(std::string_view frame,
+                      DecodedFrame* out,
+                      rpc::RpcMeta* meta)
+{
+    if (frame.empty()) return false;
 
-    uint32_t meta_len = meta_bytes.size();
+    if (static_cast<uint8_t>(frame[0]) != kMagic) {
+        // 旧格式：meta_len 的高字节为 0，不可能等于魔数
+        if (!DecodeFrame(frame, meta, &out->payload)) return false;
+        out->format = WireFormat::Legacy;
+        out->has_meta = true;
+        out->header.request_id = meta->request_id();
+        out->header.method_id = meta->method_id();
+        out->header.status = meta->error_code();
+        out->header.is_request = meta->is_request();
+        return true;
+    }
 
-    out->clear();
-    out->reserve(4 + meta_bytes.size() + body_bytes.size());
+    if (frame.size() < kBinaryHeaderLen) return false;
+    WireHeader h;
+    std::memcpy(&h, frame.data(), kBinaryHeaderLen);
+    if (h.version != kBinaryVersion) return false;
 
-    uint32_t meta_len_net = htonl(meta_len);
-    out->append(reinterpret_cast<const char*>(&meta_len_net), 4);
-    out->append(meta_bytes);
-    out->append(body_bytes);
+    size_t ext_len = be32toh(h.ext_len);
+    size_t body_len = be32toh(h.body_len);
+    if (kBinaryHeaderLen + ext_len + body_len != frame.size()) return false;
 
+    out->format = WireFormat::Binary;
+    out->header.request_id = be64toh(h.request_id);
+    out->header.method_id = be32toh(h.method_id);
+    out->header.status = static_cast<int32_t>(be32toh(static_cast<uint32_t>(h.status)));
+    out->header.is_request = (be16toh(h.flags) & kFlagRequest) != 0;
+    out->has_meta = ext_len != 0;
+    if (out->has_meta &&
+        !meta->ParseFromArray(frame.data() + kBinaryHeaderLen, static_cast<int>(ext_len))) {
+        return false;
+    }
+    out->payload = frame.substr(kBinaryHeaderLen + ext_len);
     return true;
 }
 
 //反序列化：frame([meta_len][meta][payload])——>提取 meta、payload
-bool RpcCodec::DecodeFrame(const std::string& frame,
+bool RpcCodec::DecodeFrame(std::string_view frame,
                            rpc::RpcMeta* meta,
-                           std::string* payload)
+                           std::string_view* payload)
 {
+    if (!frame.empty() && static_cast<uint8_t>(frame[0]) == kMagic) {
+        // 定长头格式：把头部字段补进 meta，调用方看到的和旧格式一样。
+        // 没有扩展段时 Decode 不碰 meta，先清空：调用方复用的 meta 里不能残留上一帧的字段（旧格式由 ParseFromArray 清空）
+        meta->Clear();
+        DecodedFrame decoded;
+        if (!Decode(frame, &decoded, meta)) return false;
+        meta->set_request_id(decoded.header.request_id);
+        meta->set_method_id(decoded.header.method_id);
+        meta->set_error_code(decoded.header.status);
+        meta->set_is_request(decoded.header.is_request);
+        *payload = decoded.payload;
+        return true;
+    }
+
     if (frame.size() < 4) return false;
 
     uint32_t meta_len_net = 0;
     std::memcpy(&meta_len_net, frame.data(), 4);
     uint32_t meta_len = ntohl(meta_len_net);
 
-    if (frame.size() < 4 + meta_len) return false;
+    if (frame.size() < 4 + static_cast<size_t>(meta_len)) return false;
 
-    std::string meta_bytes = frame.substr(4, meta_len);
-    if (!meta->ParseFromString(meta_bytes)) {
+    if (!meta->ParseFromArray(frame.data() + 4, static_cast<int>(meta_len))) {
         return false;
     }
 
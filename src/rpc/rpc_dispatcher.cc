@@ -1,150 +1,344 @@
 #include "rpc/rpc_dispatcher.h"
 #include "rpc/rpc_codec.h"
+#include "rpc/rpc_controller.h"
 #include <google/protobuf/descriptor.h>  // Protobuf服务/方法描述符头文件
 #include <google/protobuf/message.h>      // Protobuf消息基类头文件
-#include <iostream>
-#include <muduo/base/Logging.h>
+#include "log/logging.h"
+#include <muduo/base/ThreadPool.h>
+#include <muduo/base/Timestamp.h>
+#include <time.h>
+#include <algorithm>
+#include <thread>
 
 using namespace google::protobuf;
 
 // RpcDispatcher：RPC请求分发器核心类
 // 核心职责：注册RPC服务、接收RPC请求、路由到具体服务方法、执行并返回响应
 
+/*一次服务端调用的上下文：从解码出请求开始，一直存活到业务调用 done->Run() 并发出响应*/
+struct RpcDispatcher::ServerCall {
+    std::shared_ptr<RpcConnection> conn;        // 回写响应用，保证连接对象在异步完成前不被释放
+    const MethodEntry* entry = nullptr;         // 分发表中的方法信息（服务启动后不再变化）
+    WireFormat format = WireFormat::Legacy;     // 响应沿用请求的帧格式
+    uint64_t request_id = 0;
+    std::unique_ptr<Message> request;
+    std::unique_ptr<Message> response;
+    SimpleRpcController controller;
+};
+
+RpcDispatcher::RpcDispatcher() = default;
+
+RpcDispatcher::~RpcDispatcher() {
+    Stop();
+}
+
+void RpcDispatcher::SetWorkerThreads(int n) {
+    worker_threads_ = n;
+}
+
+void RpcDispatcher::Start() {
+    if (worker_threads_ <= 0 || workers_) return;
+    workers_ = std::make_unique<muduo::ThreadPool>("RpcWorker");
+    // 不设置 maxQueueSize：有界队列满时 run() 会阻塞调用方，也就是 IO 线程
+    workers_->start(worker_threads_);
+}
+
+void RpcDispatcher::Stop() {
+    if (workers_) {
+        // ThreadPool::stop 会直接丢掉队列里还没执行的任务：ServerCall 泄漏，客户端也收不到响应。
+        // 先等 worker 把排队的调用执行完（各自照常回复、随 done 释放），队列空了再停
+        draining_.store(true);
+        {
+            std::unique_lock<std::mutex> lock(drain_mutex_);
+            drain_cond_.wait(lock, [this]() { return queued_.load() == 0; });
+        }
+        workers_->stop();     // 等待 worker 线程执行完手上的调用后退出
+        workers_.reset();
+    }
+}
+
+void RpcDispatcher::SetLoadReportSampling(uint32_t every_n) {
+    load_report_every_ = every_n;
+}
+
+rpc::LoadReport RpcDispatcher::GetLoadReport() {
+    rpc::LoadReport report;
+    report.set_queue_depth(static_cast<uint32_t>(queued_.load(std::memory_order_relaxed)));
+    report.set_in_flight(in_flight_.load(std::memory_order_relaxed));
+    report.set_cpu_permille(CpuPermille());
+    return report;
+}
+
+uint32_t RpcDispatcher::CpuPermille() {
+    // 多个线程同时生成报告时只有一个去采样，其余直接用上次的结果
+    std::unique_lock<std::mutex> lock(cpu_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) return cpu_permille_.load(std::memory_order_relaxed);
+
+    int64_t wall_us = muduo::Timestamp::now().microSecondsSinceEpoch();
+    if (wall_us - cpu_sample_wall_us_ < kCpuSampleIntervalUs) {
+        return cpu_permille_.load(std::memory_order_relaxed);
+    }
+    timespec ts;
+    ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    int64_t cpu_us = static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    if (cpu_sample_wall_us_ != 0) {
+        int64_t cores = std::max(1u, std::thread::hardware_concurrency());
+        double busy = static_cast<double>(cpu_us - cpu_sample_cpu_us_)
+                    / static_cast<double>((wall_us - cpu_sample_wall_us_) * cores);
+        cpu_permille_.store(static_cast<uint32_t>(std::clamp(busy, 0.0, 1.0) * 1000),
+                            std::memory_order_relaxed);
+    }
+    cpu_sample_wall_us_ = wall_us;
+    cpu_sample_cpu_us_ = cpu_us;
+    return cpu_permille_.load(std::memory_order_relaxed);
+}
+
+RpcDispatcher::WorkerStats RpcDispatcher::GetWorkerStats() const {
+    WorkerStats stats;
+    stats.queue_depth = queued_.load(std::memory_order_relaxed);
+    stats.tasks = tasks_done_.load(std::memory_order_relaxed);
+    stats.total_wait_us = total_wait_us_.load(std::memory_order_relaxed);
+    stats.max_wait_us = max_wait_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 /**
  * @brief 注册RPC服务到分发器的服务注册表
  * @param service 待注册的RPC服务实例（Protobuf自动生成的Service子类，如OrderService）
  */
 void RpcDispatcher::RegisterService(Service* service) {
-    // 1. 获取服务的描述符（Protobuf自动生成的元信息，包含服务全名、方法列表等）
-    const ServiceDescriptor* desc = service->GetDescriptor();
-    // 2. 获取服务的全限定名（如"order.OrderService"），作为注册表的Key
-    std::string name = desc->full_name();
-
-    // 3. 检查服务是否已注册，避免重复注册导致冲突
-    if (services_.count(name)) {
-        std::cerr << "Service already registered: " << name << std::endl;
-        return;
+    // 把服务的每个方法展开进分发表：方法描述符、请求/响应原型都在这里一次性解析好
+    // 注册只能发生在服务启动前，之后分发表只读，请求路径上查找无需加锁
+    if (!methods_.AddService(service)) {
+        // 检查服务是否已注册，避免重复注册导致冲突
+        RPC_LOG_ERROR("Service already registered: {}", service->GetDescriptor()->full_name());
     }
-    // 4. 将服务实例存入注册表（services_应为类成员，类型：std::unordered_map<std::string, Service*>）
-    services_[name] = service;
+}
+
+const MethodEntry* RpcDispatcher::FindMethod(const MethodDescriptor* method) const {
+    return methods_.Find(method->service()->full_name(), method->name());
 }
 
 void RpcDispatcher::HandleMessage(const std::shared_ptr<RpcConnection>& conn,
-                                        const std::string& frame)
+                                        std::string_view frame)
 {
-    rpc::RpcMeta meta;
-    std::string payload;
-    //解析出meta、payload
-    if (!RpcCodec::DecodeFrame(frame, &meta, &payload)) {
-        std::cerr << "Dispatcher DecodeFrame failed, frame.size="
-                  << frame.size() << std::endl;
+    RpcCodec::DecodedFrame decoded;
+    // 复用本线程的 RpcMeta：定长头格式的热路径上不构造/析构任何 protobuf 对象
+    // （OnRpcMessage 在执行业务方法之前就用完了 meta，嵌套调用覆盖它也没有影响）
+    thread_local rpc::RpcMeta meta;
+    //解析出定长头字段、可选的 meta 和 payload（payload 是 frame 内部的视图，请求字节在交给 protobuf 之前不会被复制）
+    //定长头格式且已协商 method_id 的请求不带扩展段，这里不会解析任何 protobuf
+    if (!RpcCodec::Decode(frame, &decoded, &meta)) {
+        // 坏帧可能来自失控的客户端：限流，避免变成日志风暴
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Dispatcher Decode failed, frame.size={}", frame.size());
         return;
     }
-    // LOG_INFO << "Dispatcher got service=" << meta.service_name()
-    //      << " method=" << meta.method_name()
-    //      << " req_id=" << meta.request_id();
-    OnRpcMessage(conn,meta,payload);
+    RPC_LOG_TRACE("Dispatcher got method_id={} req_id={}",
+                  decoded.header.method_id, decoded.header.request_id);
+    OnRpcMessage(conn, decoded, decoded.has_meta ? meta : rpc::RpcMeta::default_instance());
 }
 
 
 /**
  * @brief 处理解析后的RPC请求（核心方法）
  * @param conn 对应的RPC网络连接（用于回写响应）
- * @param meta RPC元信息（包含服务名、方法名、request_id等）
- * @param payload 序列化后的请求消息体（二进制字符串）
+ * @param frame 解码后的帧：定长头字段（request_id、method_id等）和请求消息体
+ *              （payload 指向接收缓冲区的视图，只在本次调用期间有效）
+ * @param meta 可选字段（服务名、方法名），帧里没有 protobuf 段时为空消息
  */
 void RpcDispatcher::OnRpcMessage(const std::shared_ptr<RpcConnection>& conn,
-                                 const rpc::RpcMeta& meta,
-                                 const std::string& payload)
+                                 const RpcCodec::DecodedFrame& frame,
+                                 const rpc::RpcMeta& meta)
 {
-    // ===================== 步骤1：查找已注册的服务 =====================
-    auto it = services_.find(meta.service_name());
-    if (it == services_.end()) {
-        std::cerr << "Unknown service: " << meta.service_name() << std::endl;
+    const RpcHeader& header = frame.header;
+
+    // ===================== 步骤1~2：在分发表中查找 (服务, 方法) =====================
+    // 握手后的客户端只带 method_id：直接按数组下标取；否则按名字一次哈希 + 探测
+    // 两种方式都直接得到 Service*、MethodDescriptor* 和请求/响应原型
+    const MethodEntry* entry = nullptr;
+    if (header.method_id != 0) {
+        entry = methods_.FindById(header.method_id);
+        if (!entry) {
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Unknown method id: {}", header.method_id);
+            SendError(conn, frame, "Unknown method id: " + std::to_string(header.method_id));
+            return;
+        }
+    } else if (meta.service_name() == RpcCodec::kHandshakeService) {
+        SendHandshake(conn, frame);
+        return;
+    } else {
+        entry = methods_.Find(meta.service_name(), meta.method_name());
+    }
+    if (!entry) {
+        if (!methods_.HasService(meta.service_name())) {
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Unknown service: {}", meta.service_name());
+            SendError(conn, frame, "Unknown service: " + meta.service_name());
+        } else {
+            RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Unknown method: {} in service {}",
+                             meta.method_name(), meta.service_name());
+            SendError(conn, frame, "Unknown method: " + meta.method_name());
+        }
         return;
     }
-    // 找到服务实例
-    Service* service = it->second;
 
-    // ===================== 步骤2：查找服务对应的方法 =====================
-    // 获取服务描述符
-    const ServiceDescriptor* svc_desc = service->GetDescriptor();
-    // 通过方法名查找方法描述符（如"GetOrder"）
-    const MethodDescriptor* method =
-        svc_desc->FindMethodByName(meta.method_name());
+    // ===================== 步骤3：创建本次调用的上下文（请求/响应/控制器） =====================
+    // ServerCall 一直存活到业务调用 done->Run()，业务方法可以在任意线程、任意时刻完成
+    ServerCall* call = new ServerCall;
+    call->conn = conn;
+    call->entry = entry;
+    call->format = frame.format;
+    call->request_id = header.request_id;
+    // 1. 创建请求消息对象：用注册时缓存的请求原型（如GetOrderRequest）新建空实例
+    call->request.reset(entry->request_prototype->New());
+    // 2. 创建响应消息对象：同理，用缓存的响应原型新建实例
+    call->response.reset(entry->response_prototype->New());
 
-    if (!method) {
-        std::cerr << "Unknown method: " << meta.method_name()
-                  << " in service " << meta.service_name() << std::endl;
+    // ===================== 步骤4：解析请求消息体 =====================
+    // 将二进制payload直接从接收缓冲区反序列化为请求消息对象
+    // （必须在 IO 线程完成：payload 只是接收缓冲区的视图，回调返回后就失效了）
+    if (!call->request->ParseFromArray(frame.payload.data(), static_cast<int>(frame.payload.size()))) {
+        RPC_LOG_EVERY_MS(::rpclog::kWarn, 1000, "Failed to parse request payload for {}.{}",
+                         entry->service_name, entry->method_name);
+        delete call;
+        SendError(conn, frame, "Failed to parse request");
         return;
     }
 
-    // ===================== 步骤3：创建请求/响应消息对象 =====================
-    // 1. 创建请求消息对象：通过方法描述符获取输入类型原型，再新建实例
-    std::unique_ptr<Message> request(
-        MessageFactory::generated_factory()  // Protobuf自动生成的消息工厂
-            ->GetPrototype(method->input_type())  // 获取请求消息原型（如GetOrderRequest）
-            ->New());  // 创建空的请求消息对象
-    // 2. 创建响应消息对象：同理，获取输出类型原型并新建实例
-    std::unique_ptr<Message> response(
-        MessageFactory::generated_factory()
-            ->GetPrototype(method->output_type())  // 获取响应消息原型（如GetOrderResponse）
-            ->New());
+    if (load_report_every_ != 0) {
+        in_flight_.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    // ===================== 步骤4：解析请求消息体 =====================
-    // 将二进制payload反序列化为请求消息对象
-    if (!request->ParseFromString(payload)) {
-        std::cerr << "Failed to parse request payload for "
-                  << meta.service_name() << "." << meta.method_name()
-                  << std::endl;
+    // 未配置 worker：在 IO 线程内直接执行
+    if (!workers_) {
+        Invoke(call);
         return;
     }
 
-    // ===================== 步骤5：定义RpcController（控制器） =====================
-    // RpcController：Protobuf RPC标准接口，用于传递调用状态（错误、取消等）
-    // 此处为哑实现（Dummy），仅满足接口要求，生产环境需扩展实际逻辑
-    class DummyController : public RpcController {
-    public:
-        void Reset() override {}  // 重置控制器状态
-        bool Failed() const override { return false; }  // 调用是否失败
-        std::string ErrorText() const override { return {}; }  // 错误信息
-        void StartCancel() override {}  // 取消调用
-        void SetFailed(const std::string& reason) override { (void)reason; }  // 设置失败原因
-        bool IsCanceled() const override { return false; }  // 是否被取消
-        void NotifyOnCancel(Closure* callback) override { (void)callback; }  // 取消回调
-    } controller;
+    // 配置了 worker：业务方法交给 worker 线程池执行，IO 线程只做网络收发和解码
+    // 响应由 done->Run() 所在线程调用 conn->Send，具体网络实现负责把它投递回连接所属的 IO 线程
+    muduo::Timestamp enqueue_time = muduo::Timestamp::now();
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    workers_->run([this, call, enqueue_time]() {
+        // 队列排空时唤醒正在 Stop() 里等待的线程；不在停止时不碰锁
+        if (queued_.fetch_sub(1) == 1 && draining_.load()) {
+            std::lock_guard<std::mutex> lock(drain_mutex_);
+            drain_cond_.notify_all();
+        }
+        RecordWait(enqueue_time);
+        Invoke(call);
+    });
+}
+
+void RpcDispatcher::RecordWait(muduo::Timestamp enqueue_time) {
+    int64_t wait_us = muduo::Timestamp::now().microSecondsSinceEpoch()
+                    - enqueue_time.microSecondsSinceEpoch();
+    if (wait_us < 0) wait_us = 0;
+    uint64_t wait = static_cast<uint64_t>(wait_us);
+
+    tasks_done_.fetch_add(1, std::memory_order_relaxed);
+    total_wait_us_.fetch_add(wait, std::memory_order_relaxed);
+    uint64_t prev = max_wait_us_.load(std::memory_order_relaxed);
+    while (wait > prev &&
+           !max_wait_us_.compare_exchange_weak(prev, wait, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief 执行业务方法（IO 线程或 worker 线程）
+ * @param call 本次调用的上下文，所有权交给 done 闭包
+ */
+void RpcDispatcher::Invoke(ServerCall* call)
+{
+    // ===================== 步骤5：准备 done 闭包 =====================
+    // done->Run() 时编码并发送响应、释放 call；NewCallback 生成的是一次性闭包，Run() 后自动 delete 自身
+    // 业务方法既可以在 CallMethod 返回前同步调用 done->Run()，
+    // 也可以保存 done，在下游 RPC / 磁盘 IO 完成后从任意线程再调用（异步 handler 不需要占住线程）
+    Closure* done = NewCallback(this, &RpcDispatcher::OnCallDone, call);
 
     // ===================== 步骤6：执行RPC服务方法 =====================
-    // CallMethod：Protobuf自动生成的方法调用入口（同步调用）
+    // CallMethod：Protobuf自动生成的方法调用入口
     // 参数说明：
     // - method：要执行的方法描述符
-    // - &controller：控制器（传递调用状态）
-    // - request.get()：解析后的请求消息
-    // - response.get()：空响应消息（执行后填充结果）
-    // - nullptr：异步回调（同步调用设为null）
-    service->CallMethod(method, &controller, request.get(), response.get(), nullptr);
-
-    // ===================== 步骤7：封装响应元信息 =====================
-    rpc::RpcMeta rsp_meta;
-    rsp_meta.set_service_name(meta.service_name());  // 复用请求的服务名
-    rsp_meta.set_method_name(meta.method_name());    // 复用请求的方法名
-    rsp_meta.set_request_id(meta.request_id());      // 复用request_id，保证客户端配对
-    rsp_meta.set_is_request(false);                  // 标记为响应（非请求）
-    rsp_meta.set_error_code(0);                      // 0表示成功（生产环境需从controller获取错误码）
-    rsp_meta.set_error_msg("");                      // 错误信息（默认空）
+    // - &controller：控制器（业务可通过 SetFailed 返回错误）
+    // - request：解析后的请求消息
+    // - response：空响应消息（执行后填充结果）
+    // - done：完成回调，业务方法必须且只能调用一次
+    call->entry->service->CallMethod(call->entry->method, &call->controller,
+                                     call->request.get(), call->response.get(), done);
+}
+
+/**
+ * @brief 业务方法完成（done->Run()）后：封装响应并发送，可能在任意线程被调用
+ */
+void RpcDispatcher::OnCallDone(ServerCall* call)
+{
+    std::unique_ptr<ServerCall> guard(call);
+
+    // 采样到的响应附带负载报告：计数按线程，不需要原子操作
+    rpc::LoadReport load;
+    bool with_load = false;
+    if (load_report_every_ != 0) {
+        in_flight_.fetch_sub(1, std::memory_order_relaxed);
+        thread_local uint32_t responses = 0;
+        if (++responses >= load_report_every_) {
+            responses = 0;
+            load = GetLoadReport();
+            with_load = true;
+        }
+    }
+
+    // ===================== 步骤7：确定响应状态 =====================
+    // 响应只携带 request_id 和状态：客户端只按 request_id 配对，回传服务名/方法名只会白白占用带宽
+    int32_t status = 0;                              // 0表示成功
+    std::string error_msg;
+    if (call->controller.Failed()) {
+        status = 1;                                  // 业务通过 controller->SetFailed 报告错误
+        error_msg = call->controller.ErrorText();
+    }
 
     // ===================== 步骤8：序列化响应并发送 =====================
-    // 存储序列化后的响应帧
-    std::string frame;
-    // 1. 将响应元信息+响应消息序列化为完整帧（RpcCodec核心功能）
-    if (!RpcCodec::EncodeFrame(rsp_meta, *response, &frame)) {
-        std::cerr << "Failed to encode response" << std::endl;
-        return;
+    // 按请求的帧格式一次性编码整帧（定长头格式的成功响应只有 [total_len][定长头][body]，完全不经过 RpcMeta）：
+    // 连接有可直接写入的发送缓冲区（共享内存环）时编码进去，否则编码进本线程复用的缓冲区再 Send
+    // （跨线程时由连接实现投递回所属 IO 线程）
+    if (!RpcCodec::SendResponse(call->conn.get(), call->format, call->request_id, status, error_msg,
+                                call->response.get(), with_load ? &load : nullptr)) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Failed to encode response");
     }
+}
 
-    // 2. 添加长度前缀（解决网络粘包/拆包问题）
-    // AddLengthPrefix：在帧前添加4字节长度值，标识后续数据长度
-    std::string out = RpcCodec::AddLengthPrefix(frame);
-    // 3. 通过网络连接发送响应数据给客户端
-    conn->Send(out);
-}
\ No newline at end of file
+/**
+ * @brief 请求无法执行（未知服务/方法、请求解析失败）时回一个只有 meta 的错误响应，
+ *        否则客户端的这次调用只能等到超时
+ */
+void RpcDispatcher::SendError(const std::shared_ptr<RpcConnection>& conn,
+                              const RpcCodec::DecodedFrame& frame,
+                              const std::string& error_msg)
+{
+    // body 为空，错误文本放在 meta / 扩展段里
+    if (!RpcCodec::SendResponse(conn.get(), frame.format, frame.header.request_id, 1, error_msg, nullptr)) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Failed to encode error response");
+    }
+}
+
+/**
+ * @brief 回应方法编号握手：把分发表中每个方法的 (服务名, 方法名, 编号) 发给客户端
+ *        分发表在服务启动后不再变化，所以握手响应体只需要序列化一次
+ */
+void RpcDispatcher::SendHandshake(const std::shared_ptr<RpcConnection>& conn,
+                                  const RpcCodec::DecodedFrame& frame)
+{
+    std::call_once(handshake_once_, [this]() {
+        for (const MethodEntry& e : methods_.entries()) {
+            rpc::MethodIdEntry* item = handshake_.add_methods();
+            item->set_service_name(e.service_name);
+            item->set_method_name(e.method_name);
+            item->set_method_id(e.method_id);
+        }
+        handshake_.set_binary_version(RpcCodec::kBinaryVersion);
+    });
+
+    if (!RpcCodec::SendResponse(conn.get(), frame.format, frame.header.request_id, 0, std::string(),
+                                &handshake_)) {
+        RPC_LOG_EVERY_MS(::rpclog::kError, 1000, "Failed to encode handshake response");
+    }
+}
@@ -14,249 +14,410 @@
 #include <google/protobuf/wire_format.h>
 // @@protoc_insertion_point(includes)
 #include <google/protobuf/port_def.inc>
-namespace rpc {
-class RpcMetaDefaultTypeInternal {
- public:
-  ::PROTOBUF_NAMESPACE_ID::internal::ExplicitlyConstructed<RpcMeta> _instance;
-} _RpcMeta_default_instance_;
-}  // namespace rpc
-static void InitDefaultsscc_info_RpcMeta_rpc_5fmeta_2eproto() {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
 
-  {
-    void* ptr = &::rpc::_RpcMeta_default_instance_;
-    new (ptr) ::rpc::RpcMeta();
-    ::PROTOBUF_NAMESPACE_ID::internal::OnShutdownDestroyMessage(ptr);
-  }
-}
+PROTOBUF_PRAGMA_INIT_SEG
 
-::PROTOBUF_NAMESPACE_ID::internal::SCCInfo<0> scc_info_RpcMeta_rpc_5fmeta_2eproto =
-    {{ATOMIC_VAR_INIT(::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase::kUninitialized), 0, 0, InitDefaultsscc_info_RpcMeta_rpc_5fmeta_2eproto}, {}};
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
 
-static ::PROTOBUF_NAMESPACE_ID::Metadata file_level_metadata_rpc_5fmeta_2eproto[1];
-static constexpr ::PROTOBUF_NAMESPACE_ID::EnumDescriptor const** file_level_enum_descriptors_rpc_5fmeta_2eproto = nullptr;
-static constexpr ::PROTOBUF_NAMESPACE_ID::ServiceDescriptor const** file_level_service_descriptors_rpc_5fmeta_2eproto = nullptr;
+namespace rpc {
+PROTOBUF_CONSTEXPR RpcMeta::RpcMeta(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.service_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.method_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.error_msg_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.load_)*/nullptr
+  , /*decltype(_impl_.request_id_)*/uint64_t{0u}
+  , /*decltype(_impl_.is_request_)*/false
+  , /*decltype(_impl_.error_code_)*/0
+  , /*decltype(_impl_.method_id_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct RpcMetaDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RpcMetaDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RpcMetaDefaultTypeInternal() {}
+  union {
+    RpcMeta _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RpcMetaDefaultTypeInternal _RpcMeta_default_instance_;
+PROTOBUF_CONSTEXPR LoadReport::LoadReport(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.queue_depth_)*/0u
+  , /*decltype(_impl_.in_flight_)*/0u
+  , /*decltype(_impl_.cpu_permille_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct LoadReportDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR LoadReportDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~LoadReportDefaultTypeInternal() {}
+  union {
+    LoadReport _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 LoadReportDefaultTypeInternal _LoadReport_default_instance_;
+PROTOBUF_CONSTEXPR MethodIdEntry::MethodIdEntry(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.service_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.method_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.method_id_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct MethodIdEntryDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR MethodIdEntryDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~MethodIdEntryDefaultTypeInternal() {}
+  union {
+    MethodIdEntry _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 MethodIdEntryDefaultTypeInternal _MethodIdEntry_default_instance_;
+PROTOBUF_CONSTEXPR HandshakeResponse::HandshakeResponse(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.methods_)*/{}
+  , /*decltype(_impl_.binary_version_)*/0u
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct HandshakeResponseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR HandshakeResponseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~HandshakeResponseDefaultTypeInternal() {}
+  union {
+    HandshakeResponse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 HandshakeResponseDefaultTypeInternal _HandshakeResponse_default_instance_;
+}  // namespace rpc
+static ::_pb::Metadata file_level_metadata_rpc_5fmeta_2eproto[4];
+static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_rpc_5fmeta_2eproto = nullptr;
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_rpc_5fmeta_2eproto = nullptr;
 
-const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_rpc_5fmeta_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+const uint32_t TableStruct_rpc_5fmeta_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, service_name_),
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, method_name_),
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, request_id_),
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, is_request_),
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, error_code_),
-  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, error_msg_),
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.service_name_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.method_name_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.request_id_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.is_request_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.error_code_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.error_msg_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.method_id_),
+  PROTOBUF_FIELD_OFFSET(::rpc::RpcMeta, _impl_.load_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::rpc::LoadReport, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::rpc::LoadReport, _impl_.queue_depth_),
+  PROTOBUF_FIELD_OFFSET(::rpc::LoadReport, _impl_.in_flight_),
+  PROTOBUF_FIELD_OFFSET(::rpc::LoadReport, _impl_.cpu_permille_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::rpc::MethodIdEntry, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::rpc::MethodIdEntry, _impl_.service_name_),
+  PROTOBUF_FIELD_OFFSET(::rpc::MethodIdEntry, _impl_.method_name_),
+  PROTOBUF_FIELD_OFFSET(::rpc::MethodIdEntry, _impl_.method_id_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::rpc::HandshakeResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::rpc::HandshakeResponse, _impl_.methods_),
+  PROTOBUF_FIELD_OFFSET(::rpc::HandshakeResponse, _impl_.binary_version_),
 };
-static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, -1, sizeof(::rpc::RpcMeta)},
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, -1, -1, sizeof(::rpc::RpcMeta)},
+  { 14, -1, -1, sizeof(::rpc::LoadReport)},
+  { 23, -1, -1, sizeof(::rpc::MethodIdEntry)},
+  { 32, -1, -1, sizeof(::rpc::HandshakeResponse)},
 };
 
-static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
-  reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Message*>(&::rpc::_RpcMeta_default_instance_),
+static const ::_pb::Message* const file_default_instances[] = {
+  &::rpc::_RpcMeta_default_instance_._instance,
+  &::rpc::_LoadReport_default_instance_._instance,
+  &::rpc::_MethodIdEntry_default_instance_._instance,
+  &::rpc::_HandshakeResponse_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_rpc_5fmeta_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\016rpc_meta.proto\022\003rpc\"\203\001\n\007RpcMeta\022\024\n\014ser"
+  "\n\016rpc_meta.proto\022\003rpc\"\265\001\n\007RpcMeta\022\024\n\014ser"
   "vice_name\030\001 \001(\t\022\023\n\013method_name\030\002 \001(\t\022\022\n\n"
   "request_id\030\003 \001(\004\022\022\n\nis_request\030\004 \001(\010\022\022\n\n"
-  "error_code\030\005 \001(\005\022\021\n\terror_msg\030\006 \001(\tb\006pro"
-  "to3"
+  "error_code\030\005 \001(\005\022\021\n\terror_msg\030\006 \001(\t\022\021\n\tm"
+  "ethod_id\030\007 \001(\r\022\035\n\004load\030\010 \001(\0132\017.rpc.LoadR"
+  "eport\"J\n\nLoadReport\022\023\n\013queue_depth\030\001 \001(\r"
+  "\022\021\n\tin_flight\030\002 \001(\r\022\024\n\014cpu_permille\030\003 \001("
+  "\r\"M\n\rMethodIdEntry\022\024\n\014service_name\030\001 \001(\t"
+  "\022\023\n\013method_name\030\002 \001(\t\022\021\n\tmethod_id\030\003 \001(\r"
+  "\"P\n\021HandshakeResponse\022#\n\007methods\030\001 \003(\0132\022"
+  ".rpc.MethodIdEntry\022\026\n\016binary_version\030\002 \001"
+  "(\rb\006proto3"
   ;
-static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_rpc_5fmeta_2eproto_deps[1] = {
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_rpc_5fmeta_2eproto_sccs[1] = {
-  &scc_info_RpcMeta_rpc_5fmeta_2eproto.base,
-};
-static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_rpc_5fmeta_2eproto_once;
-const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_rpc_5fmeta_2eproto = {
-  false, false, descriptor_table_protodef_rpc_5fmeta_2eproto, "rpc_meta.proto", 163,
-  &descriptor_table_rpc_5fmeta_2eproto_once, descriptor_table_rpc_5fmeta_2eproto_sccs, descriptor_table_rpc_5fmeta_2eproto_deps, 1, 0,
-  schemas, file_default_instances, TableStruct_rpc_5fmeta_2eproto::offsets,
-  file_level_metadata_rpc_5fmeta_2eproto, 1, file_level_enum_descriptors_rpc_5fmeta_2eproto, file_level_service_descriptors_rpc_5fmeta_2eproto,
+static ::_pbi::once_flag descriptor_table_rpc_5fmeta_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_rpc_5fmeta_2eproto = {
+    false, false, 450, descriptor_table_protodef_rpc_5fmeta_2eproto,
+    "rpc_meta.proto",
+    &descriptor_table_rpc_5fmeta_2eproto_once, nullptr, 0, 4,
+    schemas, file_default_instances, TableStruct_rpc_5fmeta_2eproto::offsets,
+    file_level_metadata_rpc_5fmeta_2eproto, file_level_enum_descriptors_rpc_5fmeta_2eproto,
+    file_level_service_descriptors_rpc_5fmeta_2eproto,
 };
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_rpc_5fmeta_2eproto_getter() {
+  return &descriptor_table_rpc_5fmeta_2eproto;
+}
 
 // Force running AddDescriptors() at dynamic initialization time.
-static bool dynamic_init_dummy_rpc_5fmeta_2eproto = (static_cast<void>(::PROTOBUF_NAMESPACE_ID::internal::AddDescriptors(&descriptor_table_rpc_5fmeta_2eproto)), true);
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_rpc_5fmeta_2eproto(&descriptor_table_rpc_5fmeta_2eproto);
 namespace rpc {
 
 // ===================================================================
 
 class RpcMeta::_Internal {
  public:
+  static const ::rpc::LoadReport& load(const RpcMeta* msg);
 };
 
-RpcMeta::RpcMeta(::PROTOBUF_NAMESPACE_ID::Arena* arena)
-  : ::PROTOBUF_NAMESPACE_ID::Message(arena) {
-  SharedCtor();
-  RegisterArenaDtor(arena);
+const ::rpc::LoadReport&
+RpcMeta::_Internal::load(const RpcMeta* msg) {
+  return *msg->_impl_.load_;
+}
+RpcMeta::RpcMeta(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
   // @@protoc_insertion_point(arena_constructor:rpc.RpcMeta)
 }
 RpcMeta::RpcMeta(const RpcMeta& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
+  RpcMeta* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.service_name_){}
+    , decltype(_impl_.method_name_){}
+    , decltype(_impl_.error_msg_){}
+    , decltype(_impl_.load_){nullptr}
+    , decltype(_impl_.request_id_){}
+    , decltype(_impl_.is_request_){}
+    , decltype(_impl_.error_code_){}
+    , decltype(_impl_.method_id_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  service_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  _impl_.service_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_service_name().empty()) {
-    service_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, from._internal_service_name(), 
-      GetArena());
+    _this->_impl_.service_name_.Set(from._internal_service_name(), 
+      _this->GetArenaForAllocation());
   }
-  method_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  _impl_.method_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_method_name().empty()) {
-    method_name_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, from._internal_method_name(), 
-      GetArena());
+    _this->_impl_.method_name_.Set(from._internal_method_name(), 
+      _this->GetArenaForAllocation());
   }
-  error_msg_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+  _impl_.error_msg_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   if (!from._internal_error_msg().empty()) {
-    error_msg_.Set(::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::EmptyDefault{}, from._internal_error_msg(), 
-      GetArena());
+    _this->_impl_.error_msg_.Set(from._internal_error_msg(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_load()) {
+    _this->_impl_.load_ = new ::rpc::LoadReport(*from._impl_.load_);
   }
-  ::memcpy(&request_id_, &from.request_id_,
-    static_cast<size_t>(reinterpret_cast<char*>(&error_code_) -
-    reinterpret_cast<char*>(&request_id_)) + sizeof(error_code_));
+  ::memcpy(&_impl_.request_id_, &from._impl_.request_id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.method_id_) -
+    reinterpret_cast<char*>(&_impl_.request_id_)) + sizeof(_impl_.method_id_));
   // @@protoc_insertion_point(copy_constructor:rpc.RpcMeta)
 }
 
-void RpcMeta::SharedCtor() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&scc_info_RpcMeta_rpc_5fmeta_2eproto.base);
-  service_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  method_name_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  error_msg_.UnsafeSetDefault(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  ::memset(reinterpret_cast<char*>(this) + static_cast<size_t>(
-      reinterpret_cast<char*>(&request_id_) - reinterpret_cast<char*>(this)),
-      0, static_cast<size_t>(reinterpret_cast<char*>(&error_code_) -
-      reinterpret_cast<char*>(&request_id_)) + sizeof(error_code_));
+inline void RpcMeta::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.service_name_){}
+    , decltype(_impl_.method_name_){}
+    , decltype(_impl_.error_msg_){}
+    , decltype(_impl_.load_){nullptr}
+    , decltype(_impl_.request_id_){uint64_t{0u}}
+    , decltype(_impl_.is_request_){false}
+    , decltype(_impl_.error_code_){0}
+    , decltype(_impl_.method_id_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.service_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.method_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.error_msg_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.error_msg_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 RpcMeta::~RpcMeta() {
   // @@protoc_insertion_point(destructor:rpc.RpcMeta)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
-  _internal_metadata_.Delete<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-void RpcMeta::SharedDtor() {
-  GOOGLE_DCHECK(GetArena() == nullptr);
-  service_name_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  method_name_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
-  error_msg_.DestroyNoArena(&::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited());
+inline void RpcMeta::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.service_name_.Destroy();
+  _impl_.method_name_.Destroy();
+  _impl_.error_msg_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.load_;
 }
 
-void RpcMeta::ArenaDtor(void* object) {
-  RpcMeta* _this = reinterpret_cast< RpcMeta* >(object);
-  (void)_this;
-}
-void RpcMeta::RegisterArenaDtor(::PROTOBUF_NAMESPACE_ID::Arena*) {
-}
 void RpcMeta::SetCachedSize(int size) const {
-  _cached_size_.Set(size);
-}
-const RpcMeta& RpcMeta::default_instance() {
-  ::PROTOBUF_NAMESPACE_ID::internal::InitSCC(&::scc_info_RpcMeta_rpc_5fmeta_2eproto.base);
-  return *internal_default_instance();
+  _impl_._cached_size_.Set(size);
 }
 
-
 void RpcMeta::Clear() {
 // @@protoc_insertion_point(message_clear_start:rpc.RpcMeta)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  service_name_.ClearToEmpty();
-  method_name_.ClearToEmpty();
-  error_msg_.ClearToEmpty();
-  ::memset(&request_id_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&error_code_) -
-      reinterpret_cast<char*>(&request_id_)) + sizeof(error_code_));
+  _impl_.service_name_.ClearToEmpty();
+  _impl_.method_name_.ClearToEmpty();
+  _impl_.error_msg_.ClearToEmpty();
+  if (GetArenaForAllocation() == nullptr && _impl_.load_ != nullptr) {
+    delete _impl_.load_;
+  }
+  _impl_.load_ = nullptr;
+  ::memset(&_impl_.request_id_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.method_id_) -
+      reinterpret_cast<char*>(&_impl_.request_id_)) + sizeof(_impl_.method_id_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* RpcMeta::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) {
+const char* RpcMeta::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   while (!ctx->Done(&ptr)) {
-    ::PROTOBUF_NAMESPACE_ID::uint32 tag;
-    ptr = ::PROTOBUF_NAMESPACE_ID::internal::ReadTag(ptr, &tag);
-    CHK_(ptr);
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
       // string service_name = 1;
       case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 10)) {
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
           auto str = _internal_mutable_service_name();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "rpc.RpcMeta.service_name"));
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-        } else goto handle_unusual;
+          CHK_(::_pbi::VerifyUTF8(str, "rpc.RpcMeta.service_name"));
+        } else
+          goto handle_unusual;
         continue;
       // string method_name = 2;
       case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 18)) {
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
           auto str = _internal_mutable_method_name();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "rpc.RpcMeta.method_name"));
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-        } else goto handle_unusual;
+          CHK_(::_pbi::VerifyUTF8(str, "rpc.RpcMeta.method_name"));
+        } else
+          goto handle_unusual;
         continue;
       // uint64 request_id = 3;
       case 3:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 24)) {
-          request_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.request_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
           CHK_(ptr);
-        } else goto handle_unusual;
+        } else
+          goto handle_unusual;
         continue;
       // bool is_request = 4;
       case 4:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 32)) {
-          is_request_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.is_request_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
           CHK_(ptr);
-        } else goto handle_unusual;
+        } else
+          goto handle_unusual;
         continue;
       // int32 error_code = 5;
       case 5:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 40)) {
-          error_code_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.error_code_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
           CHK_(ptr);
-        } else goto handle_unusual;
+        } else
+          goto handle_unusual;
         continue;
       // string error_msg = 6;
       case 6:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 50)) {
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
           auto str = _internal_mutable_error_msg();
-          ptr = ::PROTOBUF_NAMESPACE_ID::internal::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(::PROTOBUF_NAMESPACE_ID::internal::VerifyUTF8(str, "rpc.RpcMeta.error_msg"));
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "rpc.RpcMeta.error_msg"));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 method_id = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.method_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
           CHK_(ptr);
-        } else goto handle_unusual;
+        } else
+          goto handle_unusual;
         continue;
-      default: {
-      handle_unusual:
-        if ((tag & 7) == 4 || tag == 0) {
-          ctx->SetLastTag(tag);
-          goto success;
-        }
-        ptr = UnknownFieldParse(tag,
-            _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
-            ptr, ctx);
-        CHK_(ptr != nullptr);
+      // .rpc.LoadReport load = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 66)) {
+          ptr = ctx->ParseMessage(_internal_mutable_load(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
         continue;
-      }
+      default:
+        goto handle_unusual;
     }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
   }  // while
-success:
+message_done:
   return ptr;
 failure:
   ptr = nullptr;
-  goto success;
+  goto message_done;
 #undef CHK_
 }
 
-::PROTOBUF_NAMESPACE_ID::uint8* RpcMeta::_InternalSerialize(
-    ::PROTOBUF_NAMESPACE_ID::uint8* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+uint8_t* RpcMeta::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
   // @@protoc_insertion_point(serialize_to_array_start:rpc.RpcMeta)
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
   // string service_name = 1;
-  if (this->service_name().size() > 0) {
+  if (!this->_internal_service_name().empty()) {
     ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
       this->_internal_service_name().data(), static_cast<int>(this->_internal_service_name().length()),
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
@@ -266,7 +427,7 @@ failure:
   }
 
   // string method_name = 2;
-  if (this->method_name().size() > 0) {
+  if (!this->_internal_method_name().empty()) {
     ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
       this->_internal_method_name().data(), static_cast<int>(this->_internal_method_name().length()),
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
@@ -276,25 +437,25 @@ failure:
   }
 
   // uint64 request_id = 3;
-  if (this->request_id() != 0) {
+  if (this->_internal_request_id() != 0) {
     target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteUInt64ToArray(3, this->_internal_request_id(), target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_request_id(), target);
   }
 
   // bool is_request = 4;
-  if (this->is_request() != 0) {
+  if (this->_internal_is_request() != 0) {
     target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteBoolToArray(4, this->_internal_is_request(), target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(4, this->_internal_is_request(), target);
   }
 
   // int32 error_code = 5;
-  if (this->error_code() != 0) {
+  if (this->_internal_error_code() != 0) {
     target = stream->EnsureSpace(target);
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt32ToArray(5, this->_internal_error_code(), target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(5, this->_internal_error_code(), target);
   }
 
   // string error_msg = 6;
-  if (this->error_msg().size() > 0) {
+  if (!this->_internal_error_msg().empty()) {
     ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
       this->_internal_error_msg().data(), static_cast<int>(this->_internal_error_msg().length()),
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
@@ -303,8 +464,21 @@ failure:
         6, this->_internal_error_msg(), target);
   }
 
+  // uint32 method_id = 7;
+  if (this->_internal_method_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(7, this->_internal_method_id(), target);
+  }
+
+  // .rpc.LoadReport load = 8;
+  if (this->_internal_has_load()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(8, _Internal::load(this),
+        _Internal::load(this).GetCachedSize(), target, stream);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::InternalSerializeUnknownFieldsToArray(
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:rpc.RpcMeta)
@@ -315,144 +489,892 @@ size_t RpcMeta::ByteSizeLong() const {
 // @@protoc_insertion_point(message_byte_size_start:rpc.RpcMeta)
   size_t total_size = 0;
 
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
   // string service_name = 1;
-  if (this->service_name().size() > 0) {
+  if (!this->_internal_service_name().empty()) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
         this->_internal_service_name());
   }
 
   // string method_name = 2;
-  if (this->method_name().size() > 0) {
+  if (!this->_internal_method_name().empty()) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
         this->_internal_method_name());
   }
 
   // string error_msg = 6;
-  if (this->error_msg().size() > 0) {
+  if (!this->_internal_error_msg().empty()) {
     total_size += 1 +
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
         this->_internal_error_msg());
   }
 
-  // uint64 request_id = 3;
-  if (this->request_id() != 0) {
+  // .rpc.LoadReport load = 8;
+  if (this->_internal_has_load()) {
     total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::UInt64Size(
-        this->_internal_request_id());
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.load_);
+  }
+
+  // uint64 request_id = 3;
+  if (this->_internal_request_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_request_id());
   }
 
   // bool is_request = 4;
-  if (this->is_request() != 0) {
+  if (this->_internal_is_request() != 0) {
     total_size += 1 + 1;
   }
 
   // int32 error_code = 5;
-  if (this->error_code() != 0) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
-        this->_internal_error_code());
+  if (this->_internal_error_code() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_error_code());
   }
 
-  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
-    return ::PROTOBUF_NAMESPACE_ID::internal::ComputeUnknownFieldsSize(
-        _internal_metadata_, total_size, &_cached_size_);
+  // uint32 method_id = 7;
+  if (this->_internal_method_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_method_id());
   }
-  int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(total_size);
-  SetCachedSize(cached_size);
-  return total_size;
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void RpcMeta::MergeFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:rpc.RpcMeta)
-  GOOGLE_DCHECK_NE(&from, this);
-  const RpcMeta* source =
-      ::PROTOBUF_NAMESPACE_ID::DynamicCastToGenerated<RpcMeta>(
-          &from);
-  if (source == nullptr) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:rpc.RpcMeta)
-    ::PROTOBUF_NAMESPACE_ID::internal::ReflectionOps::Merge(from, this);
-  } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:rpc.RpcMeta)
-    MergeFrom(*source);
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData RpcMeta::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    RpcMeta::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*RpcMeta::GetClassData() const { return &_class_data_; }
+
+
+void RpcMeta::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<RpcMeta*>(&to_msg);
+  auto& from = static_cast<const RpcMeta&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:rpc.RpcMeta)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_service_name().empty()) {
+    _this->_internal_set_service_name(from._internal_service_name());
+  }
+  if (!from._internal_method_name().empty()) {
+    _this->_internal_set_method_name(from._internal_method_name());
+  }
+  if (!from._internal_error_msg().empty()) {
+    _this->_internal_set_error_msg(from._internal_error_msg());
   }
+  if (from._internal_has_load()) {
+    _this->_internal_mutable_load()->::rpc::LoadReport::MergeFrom(
+        from._internal_load());
+  }
+  if (from._internal_request_id() != 0) {
+    _this->_internal_set_request_id(from._internal_request_id());
+  }
+  if (from._internal_is_request() != 0) {
+    _this->_internal_set_is_request(from._internal_is_request());
+  }
+  if (from._internal_error_code() != 0) {
+    _this->_internal_set_error_code(from._internal_error_code());
+  }
+  if (from._internal_method_id() != 0) {
+    _this->_internal_set_method_id(from._internal_method_id());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void RpcMeta::CopyFrom(const RpcMeta& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:rpc.RpcMeta)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
 }
 
-void RpcMeta::MergeFrom(const RpcMeta& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:rpc.RpcMeta)
-  GOOGLE_DCHECK_NE(&from, this);
+bool RpcMeta::IsInitialized() const {
+  return true;
+}
+
+void RpcMeta::InternalSwap(RpcMeta* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.service_name_, lhs_arena,
+      &other->_impl_.service_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.method_name_, lhs_arena,
+      &other->_impl_.method_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.error_msg_, lhs_arena,
+      &other->_impl_.error_msg_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(RpcMeta, _impl_.method_id_)
+      + sizeof(RpcMeta::_impl_.method_id_)
+      - PROTOBUF_FIELD_OFFSET(RpcMeta, _impl_.load_)>(
+          reinterpret_cast<char*>(&_impl_.load_),
+          reinterpret_cast<char*>(&other->_impl_.load_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RpcMeta::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_rpc_5fmeta_2eproto_getter, &descriptor_table_rpc_5fmeta_2eproto_once,
+      file_level_metadata_rpc_5fmeta_2eproto[0]);
+}
+
+// ===================================================================
+
+class LoadReport::_Internal {
+ public:
+};
+
+LoadReport::LoadReport(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:rpc.LoadReport)
+}
+LoadReport::LoadReport(const LoadReport& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  LoadReport* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.queue_depth_){}
+    , decltype(_impl_.in_flight_){}
+    , decltype(_impl_.cpu_permille_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  ::PROTOBUF_NAMESPACE_ID::uint32 cached_has_bits = 0;
+  ::memcpy(&_impl_.queue_depth_, &from._impl_.queue_depth_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.cpu_permille_) -
+    reinterpret_cast<char*>(&_impl_.queue_depth_)) + sizeof(_impl_.cpu_permille_));
+  // @@protoc_insertion_point(copy_constructor:rpc.LoadReport)
+}
+
+inline void LoadReport::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.queue_depth_){0u}
+    , decltype(_impl_.in_flight_){0u}
+    , decltype(_impl_.cpu_permille_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+LoadReport::~LoadReport() {
+  // @@protoc_insertion_point(destructor:rpc.LoadReport)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void LoadReport::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void LoadReport::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void LoadReport::Clear() {
+// @@protoc_insertion_point(message_clear_start:rpc.LoadReport)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  ::memset(&_impl_.queue_depth_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.cpu_permille_) -
+      reinterpret_cast<char*>(&_impl_.queue_depth_)) + sizeof(_impl_.cpu_permille_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* LoadReport::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // uint32 queue_depth = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _impl_.queue_depth_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 in_flight = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.in_flight_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 cpu_permille = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.cpu_permille_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* LoadReport::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:rpc.LoadReport)
+  uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  if (from.service_name().size() > 0) {
-    _internal_set_service_name(from._internal_service_name());
+  // uint32 queue_depth = 1;
+  if (this->_internal_queue_depth() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(1, this->_internal_queue_depth(), target);
   }
-  if (from.method_name().size() > 0) {
-    _internal_set_method_name(from._internal_method_name());
+
+  // uint32 in_flight = 2;
+  if (this->_internal_in_flight() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_in_flight(), target);
   }
-  if (from.error_msg().size() > 0) {
-    _internal_set_error_msg(from._internal_error_msg());
+
+  // uint32 cpu_permille = 3;
+  if (this->_internal_cpu_permille() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_cpu_permille(), target);
   }
-  if (from.request_id() != 0) {
-    _internal_set_request_id(from._internal_request_id());
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  if (from.is_request() != 0) {
-    _internal_set_is_request(from._internal_is_request());
+  // @@protoc_insertion_point(serialize_to_array_end:rpc.LoadReport)
+  return target;
+}
+
+size_t LoadReport::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:rpc.LoadReport)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // uint32 queue_depth = 1;
+  if (this->_internal_queue_depth() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_queue_depth());
+  }
+
+  // uint32 in_flight = 2;
+  if (this->_internal_in_flight() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_in_flight());
+  }
+
+  // uint32 cpu_permille = 3;
+  if (this->_internal_cpu_permille() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_cpu_permille());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData LoadReport::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    LoadReport::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*LoadReport::GetClassData() const { return &_class_data_; }
+
+
+void LoadReport::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<LoadReport*>(&to_msg);
+  auto& from = static_cast<const LoadReport&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:rpc.LoadReport)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (from._internal_queue_depth() != 0) {
+    _this->_internal_set_queue_depth(from._internal_queue_depth());
+  }
+  if (from._internal_in_flight() != 0) {
+    _this->_internal_set_in_flight(from._internal_in_flight());
   }
-  if (from.error_code() != 0) {
-    _internal_set_error_code(from._internal_error_code());
+  if (from._internal_cpu_permille() != 0) {
+    _this->_internal_set_cpu_permille(from._internal_cpu_permille());
   }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void RpcMeta::CopyFrom(const ::PROTOBUF_NAMESPACE_ID::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:rpc.RpcMeta)
+void LoadReport::CopyFrom(const LoadReport& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:rpc.LoadReport)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-void RpcMeta::CopyFrom(const RpcMeta& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:rpc.RpcMeta)
+bool LoadReport::IsInitialized() const {
+  return true;
+}
+
+void LoadReport::InternalSwap(LoadReport* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(LoadReport, _impl_.cpu_permille_)
+      + sizeof(LoadReport::_impl_.cpu_permille_)
+      - PROTOBUF_FIELD_OFFSET(LoadReport, _impl_.queue_depth_)>(
+          reinterpret_cast<char*>(&_impl_.queue_depth_),
+          reinterpret_cast<char*>(&other->_impl_.queue_depth_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata LoadReport::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_rpc_5fmeta_2eproto_getter, &descriptor_table_rpc_5fmeta_2eproto_once,
+      file_level_metadata_rpc_5fmeta_2eproto[1]);
+}
+
+// ===================================================================
+
+class MethodIdEntry::_Internal {
+ public:
+};
+
+MethodIdEntry::MethodIdEntry(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:rpc.MethodIdEntry)
+}
+MethodIdEntry::MethodIdEntry(const MethodIdEntry& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  MethodIdEntry* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.service_name_){}
+    , decltype(_impl_.method_name_){}
+    , decltype(_impl_.method_id_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.service_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_service_name().empty()) {
+    _this->_impl_.service_name_.Set(from._internal_service_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.method_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_method_name().empty()) {
+    _this->_impl_.method_name_.Set(from._internal_method_name(), 
+      _this->GetArenaForAllocation());
+  }
+  _this->_impl_.method_id_ = from._impl_.method_id_;
+  // @@protoc_insertion_point(copy_constructor:rpc.MethodIdEntry)
+}
+
+inline void MethodIdEntry::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.service_name_){}
+    , decltype(_impl_.method_name_){}
+    , decltype(_impl_.method_id_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.service_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.service_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.method_name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.method_name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+MethodIdEntry::~MethodIdEntry() {
+  // @@protoc_insertion_point(destructor:rpc.MethodIdEntry)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void MethodIdEntry::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.service_name_.Destroy();
+  _impl_.method_name_.Destroy();
+}
+
+void MethodIdEntry::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void MethodIdEntry::Clear() {
+// @@protoc_insertion_point(message_clear_start:rpc.MethodIdEntry)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.service_name_.ClearToEmpty();
+  _impl_.method_name_.ClearToEmpty();
+  _impl_.method_id_ = 0u;
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* MethodIdEntry::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // string service_name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_service_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "rpc.MethodIdEntry.service_name"));
+        } else
+          goto handle_unusual;
+        continue;
+      // string method_name = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_method_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "rpc.MethodIdEntry.method_name"));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 method_id = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.method_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* MethodIdEntry::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:rpc.MethodIdEntry)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string service_name = 1;
+  if (!this->_internal_service_name().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_service_name().data(), static_cast<int>(this->_internal_service_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "rpc.MethodIdEntry.service_name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_service_name(), target);
+  }
+
+  // string method_name = 2;
+  if (!this->_internal_method_name().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_method_name().data(), static_cast<int>(this->_internal_method_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "rpc.MethodIdEntry.method_name");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_method_name(), target);
+  }
+
+  // uint32 method_id = 3;
+  if (this->_internal_method_id() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(3, this->_internal_method_id(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:rpc.MethodIdEntry)
+  return target;
+}
+
+size_t MethodIdEntry::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:rpc.MethodIdEntry)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string service_name = 1;
+  if (!this->_internal_service_name().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_service_name());
+  }
+
+  // string method_name = 2;
+  if (!this->_internal_method_name().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_method_name());
+  }
+
+  // uint32 method_id = 3;
+  if (this->_internal_method_id() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_method_id());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData MethodIdEntry::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    MethodIdEntry::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*MethodIdEntry::GetClassData() const { return &_class_data_; }
+
+
+void MethodIdEntry::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<MethodIdEntry*>(&to_msg);
+  auto& from = static_cast<const MethodIdEntry&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:rpc.MethodIdEntry)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_service_name().empty()) {
+    _this->_internal_set_service_name(from._internal_service_name());
+  }
+  if (!from._internal_method_name().empty()) {
+    _this->_internal_set_method_name(from._internal_method_name());
+  }
+  if (from._internal_method_id() != 0) {
+    _this->_internal_set_method_id(from._internal_method_id());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void MethodIdEntry::CopyFrom(const MethodIdEntry& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:rpc.MethodIdEntry)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool RpcMeta::IsInitialized() const {
+bool MethodIdEntry::IsInitialized() const {
   return true;
 }
 
-void RpcMeta::InternalSwap(RpcMeta* other) {
+void MethodIdEntry::InternalSwap(MethodIdEntry* other) {
   using std::swap;
-  _internal_metadata_.Swap<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(&other->_internal_metadata_);
-  service_name_.Swap(&other->service_name_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  method_name_.Swap(&other->method_name_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  error_msg_.Swap(&other->error_msg_, &::PROTOBUF_NAMESPACE_ID::internal::GetEmptyStringAlreadyInited(), GetArena());
-  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(RpcMeta, error_code_)
-      + sizeof(RpcMeta::error_code_)
-      - PROTOBUF_FIELD_OFFSET(RpcMeta, request_id_)>(
-          reinterpret_cast<char*>(&request_id_),
-          reinterpret_cast<char*>(&other->request_id_));
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.service_name_, lhs_arena,
+      &other->_impl_.service_name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.method_name_, lhs_arena,
+      &other->_impl_.method_name_, rhs_arena
+  );
+  swap(_impl_.method_id_, other->_impl_.method_id_);
 }
 
-::PROTOBUF_NAMESPACE_ID::Metadata RpcMeta::GetMetadata() const {
-  return GetMetadataStatic();
+::PROTOBUF_NAMESPACE_ID::Metadata MethodIdEntry::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_rpc_5fmeta_2eproto_getter, &descriptor_table_rpc_5fmeta_2eproto_once,
+      file_level_metadata_rpc_5fmeta_2eproto[2]);
+}
+
+// ===================================================================
+
+class HandshakeResponse::_Internal {
+ public:
+};
+
+HandshakeResponse::HandshakeResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:rpc.HandshakeResponse)
+}
+HandshakeResponse::HandshakeResponse(const HandshakeResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  HandshakeResponse* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.methods_){from._impl_.methods_}
+    , decltype(_impl_.binary_version_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.binary_version_ = from._impl_.binary_version_;
+  // @@protoc_insertion_point(copy_constructor:rpc.HandshakeResponse)
+}
+
+inline void HandshakeResponse::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.methods_){arena}
+    , decltype(_impl_.binary_version_){0u}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+HandshakeResponse::~HandshakeResponse() {
+  // @@protoc_insertion_point(destructor:rpc.HandshakeResponse)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void HandshakeResponse::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.methods_.~RepeatedPtrField();
 }
 
+void HandshakeResponse::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void HandshakeResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:rpc.HandshakeResponse)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.methods_.Clear();
+  _impl_.binary_version_ = 0u;
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* HandshakeResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .rpc.MethodIdEntry methods = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_methods(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // uint32 binary_version = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.binary_version_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* HandshakeResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:rpc.HandshakeResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .rpc.MethodIdEntry methods = 1;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_methods_size()); i < n; i++) {
+    const auto& repfield = this->_internal_methods(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // uint32 binary_version = 2;
+  if (this->_internal_binary_version() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_binary_version(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:rpc.HandshakeResponse)
+  return target;
+}
+
+size_t HandshakeResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:rpc.HandshakeResponse)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .rpc.MethodIdEntry methods = 1;
+  total_size += 1UL * this->_internal_methods_size();
+  for (const auto& msg : this->_impl_.methods_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // uint32 binary_version = 2;
+  if (this->_internal_binary_version() != 0) {
+    total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_binary_version());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData HandshakeResponse::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    HandshakeResponse::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*HandshakeResponse::GetClassData() const { return &_class_data_; }
+
+
+void HandshakeResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<HandshakeResponse*>(&to_msg);
+  auto& from = static_cast<const HandshakeResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:rpc.HandshakeResponse)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.methods_.MergeFrom(from._impl_.methods_);
+  if (from._internal_binary_version() != 0) {
+    _this->_internal_set_binary_version(from._internal_binary_version());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void HandshakeResponse::CopyFrom(const HandshakeResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:rpc.HandshakeResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool HandshakeResponse::IsInitialized() const {
+  return true;
+}
+
+void HandshakeResponse::InternalSwap(HandshakeResponse* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.methods_.InternalSwap(&other->_impl_.methods_);
+  swap(_impl_.binary_version_, other->_impl_.binary_version_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata HandshakeResponse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_rpc_5fmeta_2eproto_getter, &descriptor_table_rpc_5fmeta_2eproto_once,
+      file_level_metadata_rpc_5fmeta_2eproto[3]);
+}
 
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace rpc
 PROTOBUF_NAMESPACE_OPEN
-template<> PROTOBUF_NOINLINE ::rpc::RpcMeta* Arena::CreateMaybeMessage< ::rpc::RpcMeta >(Arena* arena) {
+template<> PROTOBUF_NOINLINE ::rpc::RpcMeta*
+Arena::CreateMaybeMessage< ::rpc::RpcMeta >(Arena* arena) {
   return Arena::CreateMessageInternal< ::rpc::RpcMeta >(arena);
 }
+template<> PROTOBUF_NOINLINE ::rpc::LoadReport*
+Arena::CreateMaybeMessage< ::rpc::LoadReport >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::rpc::LoadReport >(arena);
+}
+template<> PROTOBUF_NOINLINE ::rpc::MethodIdEntry*
+Arena::CreateMaybeMessage< ::rpc::MethodIdEntry >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::rpc::MethodIdEntry >(arena);
+}
+template<> PROTOBUF_NOINLINE ::rpc::HandshakeResponse*
+Arena::CreateMaybeMessage< ::rpc::HandshakeResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::rpc::HandshakeResponse >(arena);
+}
 PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
@@ -1,5 +1,10 @@
 #include "rpc/rpc_server_factory.h"
 #include "net_muduo/muduo_network_server.h"
+#include "net_epoll/epoll_network_server.h"
+#include "net_shm/shm_network_server.h"
+#ifdef TINY_RPC_HAS_IO_URING
+#include "net_uring/uring_network_server.h"
+#endif
 
 
 RpcServerFactory& RpcServerFactory::WithPort(int port){
@@ -17,16 +22,78 @@ RpcServerFactory& RpcServerFactory::WithIOThreads(int n){
     return *this;
 }
 
+RpcServerFactory& RpcServerFactory::WithWriteCoalescing(size_t max_pending_bytes){
+    coalesce_max_bytes_=max_pending_bytes;
+    return *this;
+}
+
+RpcServerFactory& RpcServerFactory::WithWorkerThreads(int n){
+    worker_threads_=n;
+    return *this;
+}
+
+RpcServerFactory& RpcServerFactory::WithFraming(FramingType framing){
+    framing_=framing;
+    return *this;
+}
+
+RpcServerFactory& RpcServerFactory::WithUnixSocket(const std::string& path){
+    unix_path_=path;
+    return *this;
+}
+
+RpcServerFactory& RpcServerFactory::WithLoadReports(uint32_t every_n){
+    load_report_every_=every_n;
+    return *this;
+}
+
 std::unique_ptr<RpcServer> RpcServerFactory::Build() {
     std::unique_ptr<INetworkServer> network;
 
     switch (net_type_) {
-    case NetworkType::Muduo:
-        network = std::make_unique<MuduoNetworkServer>(port_, io_threads_);
+    case NetworkType::Muduo: {
+        auto muduo_server = std::make_unique<MuduoNetworkServer>(port_, io_threads_);
+        muduo_server->SetWriteCoalescing(coalesce_max_bytes_);
+        muduo_server->SetFraming(framing_);
+        if (!unix_path_.empty()) muduo_server->SetUnixSocket(unix_path_);
+        network = std::move(muduo_server);
+        break;
+    }
+    case NetworkType::Epoll: {
+        auto epoll_server = std::make_unique<EpollNetworkServer>(port_, io_threads_);
+        epoll_server->SetWriteCoalescing(coalesce_max_bytes_);
+        epoll_server->SetFraming(framing_);
+        if (!unix_path_.empty()) epoll_server->SetUnixSocket(unix_path_);
+        network = std::move(epoll_server);
         break;
+    }
+    case NetworkType::IoUring: {
+#ifdef TINY_RPC_HAS_IO_URING
+        auto uring_server = std::make_unique<UringNetworkServer>(port_, io_threads_);
+        uring_server->SetWriteCoalescing(coalesce_max_bytes_);
+        uring_server->SetFraming(framing_);
+        if (!unix_path_.empty()) uring_server->SetUnixSocket(unix_path_);
+        network = std::move(uring_server);
+        break;
+#else
+        throw std::runtime_error("io_uring backend not built (TINY_RPC_WITH_IO_URING=OFF or no linux/io_uring.h)");
+#endif
+    }
+    case NetworkType::SharedMemory: {
+        if (unix_path_.empty()) {
+            throw std::runtime_error("shared-memory backend needs WithUnixSocket(path) for the handshake");
+        }
+        auto shm_server = std::make_unique<ShmNetworkServer>(unix_path_, io_threads_);
+        shm_server->SetFraming(framing_);
+        network = std::move(shm_server);
+        break;
+    }
     default:
         throw std::runtime_error("Unsupported network type");
     }
 
-    return std::make_unique<RpcServer>(std::move(network));
+    auto server = std::make_unique<RpcServer>(std::move(network));
+    server->SetWorkerThreads(worker_threads_);
+    server->SetLoadReportSampling(load_report_every_);
+    return server;
 }
@@ -0,0 +1,42 @@
+#include "rpc/timer_wheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(size_t slot_count, int64_t tick_ms, int64_t now_ms)
+    : slots_(slot_count),
+      tick_ms_(tick_ms),
+      current_tick_(now_ms / tick_ms)
+{}
+
+void TimerWheel::Add(uint64_t id, int64_t deadline_ms) {
+    // 向上取整：保证扫描到这个槽时（now_tick >= tick）一定有 now_ms >= deadline_ms
+    int64_t tick = (deadline_ms + tick_ms_ - 1) / tick_ms_;
+    if (tick <= current_tick_) {
+        tick = current_tick_ + 1;   // 已经过期或马上过期：放到下一个要处理的槽
+    }
+    slots_[static_cast<size_t>(tick) % slots_.size()].push_back(Entry{ id, deadline_ms });
+    ++size_;
+}
+
+void TimerWheel::Advance(int64_t now_ms, std::vector<uint64_t>* expired) {
+    int64_t now_tick = now_ms / tick_ms_;
+    if (now_tick <= current_tick_) return;
+
+    // 一次推进超过一圈时，每个槽也只需要扫描一遍
+    int64_t steps = std::min<int64_t>(now_tick - current_tick_,
+                                      static_cast<int64_t>(slots_.size()));
+    for (int64_t i = 1; i <= steps; ++i) {
+        std::vector<Entry>& slot = slots_[static_cast<size_t>(current_tick_ + i) % slots_.size()];
+        // 原地过滤：到期的取出，属于后面几圈的保留
+        size_t keep = 0;
+        for (const Entry& e : slot) {
+            if (e.deadline_ms <= now_ms) {
+                expired->push_back(e.id);
+            } else {
+                slot[keep++] = e;
+            }
+        }
+        size_ -= slot.size() - keep;
+        slot.resize(keep);
+    }
+    current_tick_ = now_tick;
+}